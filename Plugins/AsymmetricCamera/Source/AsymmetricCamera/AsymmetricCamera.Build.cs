@@ -40,11 +40,31 @@ public class AsymmetricCamera : ModuleRules
 			{
 				"Slate",
 				"SlateCore",
+				"Sockets",
+				"Networking",
+				"ImageCore",
+				"ImageWrapper",
+				"ImageWriteQueue",
+				"Json",
 				"MovieRenderPipelineCore",
 				"MovieRenderPipelineRenderPasses"
 			}
 		);
 
+		// OpenEXR：多视图 EXR 输出节点使用，只有引擎自带该库的桌面平台才编译
+		if (Target.Platform.IsInGroup(UnrealPlatformGroup.Windows) ||
+			Target.Platform == UnrealTargetPlatform.Mac ||
+			Target.IsInPlatformGroup(UnrealPlatformGroup.Linux))
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "Imath", "UEOpenExr");
+			PrivateDefinitions.Add("WITH_ASYMMETRIC_EXR=1");
+			bEnableExceptions = true; // OpenEXR 以异常报告编码错误
+		}
+		else
+		{
+			PrivateDefinitions.Add("WITH_ASYMMETRIC_EXR=0");
+		}
+
 
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
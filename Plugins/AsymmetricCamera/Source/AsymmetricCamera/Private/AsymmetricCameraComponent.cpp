@@ -2,14 +2,27 @@
 
 #include "AsymmetricCameraComponent.h"
 #include "AsymmetricScreenComponent.h"
-#include "AsymmetricViewExtension.h"
+#include "AsymmetricProjectionKernel.h"
+#include "AsymmetricCameraStats.h"
+#include "AsymmetricCameraSubsystem.h"
+#include "AsymmetricMultiViewDevice.h"
+#include "AsymmetricTrackingSubsystem.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
 #include "Engine/World.h"
-#include "SceneViewExtension.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projection Cache Hits"), STAT_AsymmetricProjectionCacheHits, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projection Cache Misses"), STAT_AsymmetricProjectionCacheMisses, STATGROUP_AsymmetricCamera);
 
 UAsymmetricCameraComponent::UAsymmetricCameraComponent()
+	: ProjectionStateBuffer(MakeShared<TAsymmetricDoubleBuffer<FAsymmetricProjectionState>, ESPMode::ThreadSafe>())
 {
+	// 投影状态由相机子系统统一发布，组件只在需要逐帧工作（跟随相机、调试绘制、多屏）时才 Tick，见 RefreshTickState
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+	// 不 Tick 时靠 OnUpdateTransform 得知自身 / Owner 移动了（眼睛位置来自组件），没有这个标记引擎不会调用它
+	bWantsOnUpdateTransform = true;
 	bUseAsymmetricProjection = true;
 	EyeSeparation = 0.0f;
 	EyeOffset = 0.0f;
@@ -25,9 +38,18 @@ UAsymmetricCameraComponent::UAsymmetricCameraComponent()
 	bMatchViewportAspectRatio = true;
 	bEnableMRQSupport = true;
 	TrackedActor = nullptr;
+	bUseTrackingSubsystem = false;
+	TrackingSensorId = 0;
+	TrackingPort = 7700;
+	TrackingTimeout = 0.25f;
+	bLateLatchEyePosition = false;
 	bFollowTargetCamera = false;
 	TargetCamera = nullptr;
+	FollowMode = EAsymmetricFollowMode::MoveOwner;
 	ScreenComponent = nullptr;
+	bMultiScreen = false;
+	MultiScreenLayout = EAsymmetricMultiScreenLayout::Grid;
+	GridColumns = 0;
 	NearClip = 20.0f;
 	FarClip = 0.0f; // 0 = 无限远（UE5 默认）
 	bUseExternalData = false;
@@ -72,16 +94,68 @@ void UAsymmetricCameraComponent::BeginPlay()
 		}
 	}
 
-	// 注册视图扩展，用来覆盖玩家相机投影
-	if (bUseAsymmetricProjection)
+	// 追踪子系统是引擎级的，多个相机用同一个端口时只会启动一次接收线程
+	if (bUseTrackingSubsystem && GEngine)
+	{
+		if (UAsymmetricTrackingSubsystem* Tracking = GEngine->GetEngineSubsystem<UAsymmetricTrackingSubsystem>())
+		{
+			Tracking->StartReceiver(TrackingPort);
+		}
+	}
+
+	// 登记到世界子系统，由它的视图扩展覆盖玩家相机投影。
+	// 不管当前是否启用离轴投影都登记，运行中打开 bUseAsymmetricProjection 立即生效
+	UWorld* World = GetWorld();
+	if (UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr)
+	{
+		Subsystem->RegisterCamera(this);
+		bRegisteredWithSubsystem = true;
+	}
+
+	// 多屏模式：安装多 View 渲染设备，由它给同一个 ViewFamily 提供 N 个屏幕 View
+	if (bUseAsymmetricProjection && bMultiScreen && ScreenComponents.Num() > 0)
 	{
-		ViewExtension = FSceneViewExtensions::NewExtension<FAsymmetricViewExtension>(GetWorld(), this);
+		MultiViewDevice = MakeShared<FAsymmetricMultiViewDevice, ESPMode::ThreadSafe>();
+		if (MultiViewDevice->Install())
+		{
+			UpdateMultiScreenViews();
+		}
+		else
+		{
+			MultiViewDevice.Reset();
+		}
 	}
+
+	BindScreenTransformUpdated();
+	RefreshTickState();
+
+	// 先发布一次状态，第一帧渲染就有数据可读
+	PublishProjectionState();
 }
 
 void UAsymmetricCameraComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	ViewExtension.Reset();
+	UnbindScreenTransformUpdated();
+	if (AActor* Prerequisite = TickPrerequisiteActor.Get())
+	{
+		PrimaryComponentTick.RemovePrerequisite(Prerequisite, Prerequisite->PrimaryActorTick);
+	}
+	TickPrerequisiteActor = nullptr;
+
+	if (bRegisteredWithSubsystem)
+	{
+		UWorld* World = GetWorld();
+		if (UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr)
+		{
+			Subsystem->UnregisterCamera(this);
+		}
+		bRegisteredWithSubsystem = false;
+	}
+	if (MultiViewDevice.IsValid())
+	{
+		MultiViewDevice->Uninstall();
+		MultiViewDevice.Reset();
+	}
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -89,8 +163,8 @@ void UAsymmetricCameraComponent::TickComponent(float DeltaTime, ELevelTick TickT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// Sync owner actor transform to target camera
-	if (bFollowTargetCamera && TargetCamera)
+	// Sync owner actor transform to target camera（目标相机的 Tick 是前置，这里拿到的是本帧动画后的 Transform）
+	if (bFollowTargetCamera && TargetCamera && FollowMode == EAsymmetricFollowMode::MoveOwner)
 	{
 		AActor* Owner = GetOwner();
 		if (Owner)
@@ -101,23 +175,256 @@ void UAsymmetricCameraComponent::TickComponent(float DeltaTime, ELevelTick TickT
 		}
 	}
 
+	if (MultiViewDevice.IsValid())
+	{
+		UpdateMultiScreenViews();
+	}
+
+	// 登记了子系统的话由它在所有 Tick Group 之后统一发布
+	if (!bRegisteredWithSubsystem)
+	{
+		PublishProjectionState();
+	}
+
 	if (bShowDebugInGame)
 	{
 		DrawDebugVisualization();
 	}
 }
 
+void UAsymmetricCameraComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+	bProjectionStateDirty = true;
+}
+
+bool UAsymmetricCameraComponent::NeedsComponentTick() const
+{
+	const bool bMoveOwner = bFollowTargetCamera && TargetCamera && FollowMode == EAsymmetricFollowMode::MoveOwner;
+	return bMoveOwner || bShowDebugInGame || MultiViewDevice.IsValid() || !bRegisteredWithSubsystem;
+}
+
+void UAsymmetricCameraComponent::RefreshTickState()
+{
+	if (!HasBegunPlay())
+	{
+		return;
+	}
+
+	// 跟随目标相机时在它之后 Tick，Sequencer / 动画已经把它移到本帧位置。
+	// Virtual Parent 不需要：投影状态在子系统里（所有 Tick Group 之后）才读目标相机
+	AActor* NewPrerequisite = (bFollowTargetCamera && FollowMode == EAsymmetricFollowMode::MoveOwner) ? TargetCamera : nullptr;
+	AActor* OldPrerequisite = TickPrerequisiteActor.Get();
+	if (OldPrerequisite != NewPrerequisite)
+	{
+		if (OldPrerequisite)
+		{
+			PrimaryComponentTick.RemovePrerequisite(OldPrerequisite, OldPrerequisite->PrimaryActorTick);
+		}
+		if (NewPrerequisite)
+		{
+			PrimaryComponentTick.AddPrerequisite(NewPrerequisite, NewPrerequisite->PrimaryActorTick);
+		}
+		TickPrerequisiteActor = NewPrerequisite;
+	}
+
+	SetComponentTickEnabled(NeedsComponentTick());
+}
+
+void UAsymmetricCameraComponent::SetShowDebugInGame(bool bInShowDebugInGame)
+{
+	bShowDebugInGame = bInShowDebugInGame;
+	RefreshTickState();
+}
+
+void UAsymmetricCameraComponent::SetFollowTargetCamera(bool bInFollowTargetCamera)
+{
+	bFollowTargetCamera = bInFollowTargetCamera;
+	RefreshTickState();
+}
+
+void UAsymmetricCameraComponent::SetTargetCamera(AActor* InTargetCamera)
+{
+	TargetCamera = InTargetCamera;
+	RefreshTickState();
+}
+
+void UAsymmetricCameraComponent::SetFollowMode(EAsymmetricFollowMode InFollowMode)
+{
+	FollowMode = InFollowMode;
+	InvalidateProjectionCache();
+	RefreshTickState();
+}
+
+bool UAsymmetricCameraComponent::IsVirtualParentActive() const
+{
+	return bFollowTargetCamera && TargetCamera && FollowMode == EAsymmetricFollowMode::VirtualParent
+		&& GetOwner() && HasBegunPlay();
+}
+
+FTransform UAsymmetricCameraComponent::GetVirtualParentDelta() const
+{
+	if (!IsVirtualParentActive())
+	{
+		return FTransform::Identity;
+	}
+
+	// Rig 上的点 P = T_owner + R_owner * L，跟随后应为 T_target + R_target * L，
+	// 即 P' = Q * (P - T_owner) + T_target，Q = R_target * R_owner^-1。和 Owner 的缩放无关
+	const AActor* Owner = GetOwner();
+	const FQuat DeltaRotation = TargetCamera->GetActorQuat() * Owner->GetActorQuat().Inverse();
+	return FTransform(DeltaRotation, TargetCamera->GetActorLocation() - DeltaRotation.RotateVector(Owner->GetActorLocation()));
+}
+
+void UAsymmetricCameraComponent::BindScreenTransformUpdated()
+{
+	if (BoundScreenComponent.Get() == ScreenComponent)
+	{
+		return;
+	}
+
+	UnbindScreenTransformUpdated();
+	if (ScreenComponent)
+	{
+		ScreenTransformUpdatedHandle = ScreenComponent->TransformUpdated.AddUObject(this, &UAsymmetricCameraComponent::OnScreenTransformUpdated);
+		BoundScreenComponent = ScreenComponent;
+	}
+}
+
+void UAsymmetricCameraComponent::UnbindScreenTransformUpdated()
+{
+	if (UAsymmetricScreenComponent* Screen = BoundScreenComponent.Get())
+	{
+		Screen->TransformUpdated.Remove(ScreenTransformUpdatedHandle);
+	}
+	ScreenTransformUpdatedHandle.Reset();
+	BoundScreenComponent = nullptr;
+}
+
+void UAsymmetricCameraComponent::OnScreenTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	bProjectionStateDirty = true;
+}
+
+UAsymmetricCameraComponent::FProjectionSettingsKey UAsymmetricCameraComponent::MakeProjectionSettingsKey() const
+{
+	FProjectionSettingsKey Key;
+	Key.Screen = ScreenComponent;
+	Key.ScreenSize = ScreenComponent ? ScreenComponent->GetScreenSize() : FVector2D::ZeroVector;
+	Key.NearClip = NearClip;
+	Key.FarClip = FarClip;
+	Key.EyeSeparation = EyeSeparation;
+	Key.EyeOffset = EyeOffset;
+	Key.bUseAsymmetricProjection = bUseAsymmetricProjection;
+	Key.bEnableMRQSupport = bEnableMRQSupport;
+	Key.bMatchViewportAspectRatio = bMatchViewportAspectRatio;
+	return Key;
+}
+
+bool UAsymmetricCameraComponent::NeedsProjectionStatePublish() const
+{
+	// 这些来源没有变化通知，只能每帧重新读
+	if (bUseTrackingSubsystem || TrackedActor || bUseExternalData || MultiViewDevice.IsValid() || IsVirtualParentActive())
+	{
+		return true;
+	}
+	return bProjectionStateDirty || !(MakeProjectionSettingsKey() == PublishedSettingsKey);
+}
+
+void UAsymmetricCameraComponent::PublishProjectionState()
+{
+	check(IsInGameThread());
+
+	// 蓝图直接换了 ScreenComponent 时跟着换通知
+	if (HasBegunPlay())
+	{
+		BindScreenTransformUpdated();
+	}
+	PublishedSettingsKey = MakeProjectionSettingsKey();
+	bProjectionStateDirty = false;
+
+	FAsymmetricProjectionState State;
+	State.FrameNumber = GFrameCounter;
+
+	State.Basis = GetScreenBasis();
+	State.bEnabled = bUseAsymmetricProjection && (bUseExternalData || ScreenComponent) && State.Basis.IsValid();
+	State.bMultiScreenActive = IsMultiScreenActive();
+	State.bEnableMRQSupport = bEnableMRQSupport;
+	State.bMatchViewportAspectRatio = bMatchViewportAspectRatio;
+	State.ScreenSize = ScreenComponent ? ScreenComponent->GetScreenSize() : FVector2D::ZeroVector;
+
+	State.NearClip = NearClip;
+	State.FarClip = FarClip;
+	State.EyeSeparation = EyeSeparation;
+	State.EyeOffset = EyeOffset;
+
+	State.EyePosition = GetEyePosition();
+
+	State.bUseTracking = bUseTrackingSubsystem && !bUseExternalData;
+	State.bLateLatch = bLateLatchEyePosition;
+	State.TrackingSensorId = TrackingSensorId;
+	State.TrackingTimeout = TrackingTimeout;
+	State.TrackingToWorld = GetTrackingToWorld();
+	State.Tracking = (State.bUseTracking && GEngine) ? GEngine->GetEngineSubsystem<UAsymmetricTrackingSubsystem>() : nullptr;
+
+	ProjectionStateBuffer->Publish(State);
+}
+
+bool UAsymmetricCameraComponent::GetProjectionState(FAsymmetricProjectionState& OutState) const
+{
+	return ProjectionStateBuffer->Read(OutState);
+}
+
 FVector UAsymmetricCameraComponent::GetEyePosition() const
 {
 	if (bUseExternalData)
 	{
 		return ExternalEyeActor ? ExternalEyeActor->GetActorLocation() : ExternalEyePosition;
 	}
+	FVector TrackedEyePosition;
+	if (GetTrackedEyePosition(TrackedEyePosition))
+	{
+		return TrackedEyePosition;
+	}
 	if (TrackedActor)
 	{
 		return TrackedActor->GetActorLocation();
 	}
-	return GetComponentLocation();
+	return GetVirtualParentDelta().TransformPosition(GetComponentLocation());
+}
+
+bool UAsymmetricCameraComponent::GetTrackedEyePosition(FVector& OutEyePosition) const
+{
+	FAsymmetricTrackingSample Sample;
+	if (!GetTrackedEyeSample(Sample))
+	{
+		return false;
+	}
+
+	OutEyePosition = GetTrackingToWorld().TransformPosition(FVector(Sample.Position));
+	return true;
+}
+
+bool UAsymmetricCameraComponent::GetTrackedEyeSample(FAsymmetricTrackingSample& OutSample) const
+{
+	if (!bUseTrackingSubsystem || !GEngine)
+	{
+		return false;
+	}
+
+	const UAsymmetricTrackingSubsystem* Tracking = GEngine->GetEngineSubsystem<UAsymmetricTrackingSubsystem>();
+	if (!Tracking || !Tracking->GetLatestSample(TrackingSensorId, OutSample))
+	{
+		return false;
+	}
+
+	return FPlatformTime::Seconds() - OutSample.ReceiveTime <= TrackingTimeout;
+}
+
+FTransform UAsymmetricCameraComponent::GetTrackingToWorld() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner ? Owner->GetActorTransform() * GetVirtualParentDelta() : FTransform::Identity;
 }
 
 bool UAsymmetricCameraComponent::CalculateOffAxisProjection(
@@ -130,104 +437,212 @@ bool UAsymmetricCameraComponent::CalculateOffAxisProjection(
 		return false;
 	}
 
-	// 拿屏幕四角（世界坐标）
-	FVector WorldBL, WorldBR, WorldTL, WorldTR;
-	GetEffectiveScreenCorners(WorldBL, WorldBR, WorldTL, WorldTR);
+	if (!bUseExternalData && !ScreenComponent)
+	{
+		return false;
+	}
 
-	if (bUseExternalData)
+	// 屏幕正交基在世界空间里算。原来先转到 Actor 局部空间再算，
+	// 但那是刚体变换（不含缩放），点积结果不变，可以省掉三次逆变换。
+	const FAsymmetricScreenBasis& Basis = GetScreenBasis();
+
+	// 立体偏移：沿屏幕右方向偏移
+	FVector PE = EyePosition;
+	if (FMath::Abs(EyeSeparation) > SMALL_NUMBER)
 	{
-		// 外部模式：从四角推导屏幕朝向
-		FVector ScreenRight = (WorldBR - WorldBL).GetSafeNormal();
-		FVector ScreenUp = (WorldTL - WorldBL).GetSafeNormal();
-		FVector ScreenNormal = FVector::CrossProduct(ScreenRight, ScreenUp).GetSafeNormal();
-		OutViewRotation = ScreenNormal.Rotation();
+		PE += Basis.Right * (EyeOffset * EyeSeparation * 0.5f);
 	}
-	else
+
+	return FAsymmetricProjectionKernel::Calculate(Basis, PE, NearClip, FarClip, OutViewRotation, OutProjectionMatrix);
+}
+
+bool UAsymmetricCameraComponent::CalculateMultiScreenProjections(
+	const FVector& EyePosition,
+	TArray<FRotator>& OutViewRotations,
+	TArray<FMatrix>& OutProjectionMatrices)
+{
+	OutViewRotations.Reset();
+	OutProjectionMatrices.Reset();
+
+	if (!bUseAsymmetricProjection || ScreenComponents.Num() == 0)
 	{
-		if (!ScreenComponent)
+		return false;
+	}
+
+	// 角点先减去眼睛位置（double）再转 float，眼睛在原点，大世界坐标下也不丢精度
+	const int32 NumScreens = ScreenComponents.Num();
+	MultiScreenBatch.Reset(NumScreens);
+	MultiScreenBatch.NearClip = NearClip;
+	MultiScreenBatch.FarClip = FarClip;
+
+	const FTransform VirtualParentDelta = GetVirtualParentDelta();
+	bool bAnyValid = false;
+	for (int32 Index = 0; Index < NumScreens; ++Index)
+	{
+		const UAsymmetricScreenComponent* Screen = ScreenComponents[Index];
+		if (!Screen)
 		{
-			return false;
+			continue; // 保持全 0，下面输出时跳过
 		}
-		// 组件模式：直接用屏幕组件的旋转
-		OutViewRotation = ScreenComponent->GetComponentRotation();
-	}
 
-	// 转到 Actor 局部空间
-	const AActor* Owner = GetOwner();
-	const FTransform LocalSpace = (Owner ? Owner->GetActorTransform() : FTransform::Identity);
+		FVector BL, BR, TL, TR;
+		Screen->GetScreenCornersWorld(BL, BR, TL, TR);
+		BL = VirtualParentDelta.TransformPosition(BL);
+		BR = VirtualParentDelta.TransformPosition(BR);
+		TL = VirtualParentDelta.TransformPosition(TL);
+		MultiScreenBatch.SetScreen(Index,
+			FVector3f(BL - EyePosition), FVector3f(BR - EyePosition), FVector3f(TL - EyePosition), FVector3f::ZeroVector);
+		bAnyValid = true;
+	}
 
-	const FVector PA = LocalSpace.InverseTransformPositionNoScale(WorldBL); // 左下
-	const FVector PB = LocalSpace.InverseTransformPositionNoScale(WorldBR); // 右下
-	const FVector PC = LocalSpace.InverseTransformPositionNoScale(WorldTL); // 左上
+	if (!bAnyValid)
+	{
+		return false;
+	}
 
-	// 眼睛位置转到 Actor 局部空间
-	FVector PE = LocalSpace.InverseTransformPositionNoScale(EyePosition);
+	FAsymmetricProjectionKernel::EvaluateBatch(MultiScreenBatch);
 
-	// 立体偏移：沿屏幕右方向偏移
-	if (FMath::Abs(EyeSeparation) > SMALL_NUMBER)
+	OutViewRotations.SetNum(NumScreens);
+	OutProjectionMatrices.SetNum(NumScreens);
+	for (int32 Index = 0; Index < NumScreens; ++Index)
 	{
-		FVector VR = (PB - PA).GetSafeNormal();
-		PE += VR * (EyeOffset * EyeSeparation * 0.5f);
-	}
-
-	// 屏幕的正交基
-	FVector VR = (PB - PA).GetSafeNormal(); // 右
-	FVector VU = (PC - PA).GetSafeNormal(); // 上
-	// 屏幕法线：叉积取反（nDisplay 约定，左手系）
-	FVector VN = -FVector::CrossProduct(VR, VU).GetSafeNormal();
-
-	// 眼睛到屏幕三个角的向量
-	const FVector VA = PA - PE;
-	const FVector VB = PB - PE;
-	const FVector VC = PC - PE;
-
-	// 眼睛到屏幕平面的距离
-	const float Distance = -FVector::DotProduct(VA, VN);
-	static const float MinScreenDistance = 10.0f;
-	const float SafeDistance = (FMath::Abs(Distance) < MinScreenDistance) ? MinScreenDistance : Distance;
-
-	// 把屏幕范围投影到近裁切面上
-	const float Near = NearClip;
-	const float Far = FarClip;
-	const float NearOverDist = Near / SafeDistance;
-
-	const float Left   = FVector::DotProduct(VR, VA) * NearOverDist;
-	const float Right  = FVector::DotProduct(VR, VB) * NearOverDist;
-	const float Bottom = FVector::DotProduct(VU, VA) * NearOverDist;
-	const float Top    = FVector::DotProduct(VU, VC) * NearOverDist;
-
-	// 用 nDisplay 的 MakeProjectionMatrix 公式构建投影矩阵：
-	// 1) 标准左手系偏心投影
-	// 2) 乘以 flipZ 得到 UE5 reversed-Z
-	const float mx = 2.0f * Near / (Right - Left);
-	const float my = 2.0f * Near / (Top - Bottom);
-	const float ma = -(Right + Left) / (Right - Left);
-	const float mb = -(Top + Bottom) / (Top - Bottom);
-
-	// 支持无限远平面（Far <= 0 或 Far == Near）
-	const bool bInfiniteFar = (Far <= 0.0f) || FMath::IsNearlyEqual(Near, Far);
-	const float mc = bInfiniteFar ? (1.0f - SMALL_NUMBER) : (Far / (Far - Near));
-	const float md = bInfiniteFar ? (-Near * (1.0f - SMALL_NUMBER)) : (-(Far * Near) / (Far - Near));
-	const float me = 1.0f;
-
-	// 标准左手系投影矩阵
-	const FMatrix StandardLHS(
-		FPlane(mx, 0.0f, 0.0f, 0.0f),
-		FPlane(0.0f, my, 0.0f, 0.0f),
-		FPlane(ma, mb, mc, me),
-		FPlane(0.0f, 0.0f, md, 0.0f));
-
-	// flipZ：反转 Z 轴，转成 UE5 的 reversed-Z
-	static const FMatrix FlipZ(
-		FPlane(1.0f, 0.0f, 0.0f, 0.0f),
-		FPlane(0.0f, 1.0f, 0.0f, 0.0f),
-		FPlane(0.0f, 0.0f, -1.0f, 0.0f),
-		FPlane(0.0f, 0.0f, 1.0f, 1.0f));
-
-	OutProjectionMatrix = StandardLHS * FlipZ;
+		if (!ScreenComponents[Index])
+		{
+			OutViewRotations[Index] = FRotator::ZeroRotator;
+			OutProjectionMatrices[Index] = FMatrix::Identity;
+			continue;
+		}
+
+		// ViewRotationMatrix 的三列是 (右, 上, 前)
+		const FMatrix44f& ViewRotationMatrix = MultiScreenBatch.ViewRotationMatrices[Index];
+		const FVector Forward(ViewRotationMatrix.M[0][2], ViewRotationMatrix.M[1][2], ViewRotationMatrix.M[2][2]);
+		const FVector Up(ViewRotationMatrix.M[0][1], ViewRotationMatrix.M[1][1], ViewRotationMatrix.M[2][1]);
+		OutViewRotations[Index] = FRotationMatrix::MakeFromXZ(Forward, Up).Rotator();
+		OutProjectionMatrices[Index] = FMatrix(MultiScreenBatch.ProjectionMatrices[Index]);
+	}
 	return true;
 }
 
+FBox2D UAsymmetricCameraComponent::GetMultiScreenViewRect(int32 ScreenIndex, int32 ViewIndex, int32 NumViews) const
+{
+	if (MultiScreenLayout == EAsymmetricMultiScreenLayout::Custom && CustomViewRects.IsValidIndex(ScreenIndex))
+	{
+		const FAsymmetricViewportRect& Rect = CustomViewRects[ScreenIndex];
+		const FVector2D Min(FMath::Clamp(Rect.Min.X, 0.0, 1.0), FMath::Clamp(Rect.Min.Y, 0.0, 1.0));
+		const FVector2D Max(FMath::Clamp(Rect.Max.X, Min.X, 1.0), FMath::Clamp(Rect.Max.Y, Min.Y, 1.0));
+		return FBox2D(Min, Max);
+	}
+
+	// 网格排布：列数未指定时取接近正方形的列数
+	const int32 Count   = FMath::Max(NumViews, 1);
+	const int32 Columns = (GridColumns > 0) ? GridColumns : FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+	const int32 Rows    = FMath::DivideAndRoundUp(Count, Columns);
+	const int32 Column  = ViewIndex % Columns;
+	const int32 Row     = ViewIndex / Columns;
+
+	return FBox2D(
+		FVector2D(static_cast<double>(Column) / Columns, static_cast<double>(Row) / Rows),
+		FVector2D(static_cast<double>(Column + 1) / Columns, static_cast<double>(Row + 1) / Rows));
+}
+
+void UAsymmetricCameraComponent::UpdateMultiScreenViews()
+{
+	const FVector EyePosition = GetEyePosition();
+
+	TArray<FRotator> ViewRotations;
+	TArray<FMatrix> ProjectionMatrices;
+	TArray<FAsymmetricMultiViewDevice::FViewData> Views;
+
+	if (CalculateMultiScreenProjections(EyePosition, ViewRotations, ProjectionMatrices))
+	{
+		// 空项不产生 View：先数出有效屏幕，网格按 View 序号排布，
+		// 设备的 View 下标、投影和输出矩形始终对应同一块屏幕
+		const int32 NumScreens = ScreenComponents.Num();
+		int32 NumViews = 0;
+		for (const UAsymmetricScreenComponent* Screen : ScreenComponents)
+		{
+			NumViews += Screen ? 1 : 0;
+		}
+
+		Views.Reserve(NumViews);
+		for (int32 Index = 0; Index < NumScreens; ++Index)
+		{
+			if (!ScreenComponents[Index])
+			{
+				continue;
+			}
+
+			const int32 ViewIndex = Views.Num();
+			FAsymmetricMultiViewDevice::FViewData& View = Views.AddDefaulted_GetRef();
+			View.ViewLocation     = EyePosition;
+			View.ViewRotation     = ViewRotations[Index];
+			View.ProjectionMatrix = ProjectionMatrices[Index];
+			View.NormalizedRect   = GetMultiScreenViewRect(Index, ViewIndex, NumViews);
+		}
+	}
+
+	MultiViewDevice->SetViews(MoveTemp(Views));
+}
+
+UAsymmetricCameraComponent::FScreenBasisCacheKey UAsymmetricCameraComponent::MakeScreenBasisCacheKey() const
+{
+	FScreenBasisCacheKey Key;
+	Key.bExternal = bUseExternalData;
+	if (bUseExternalData)
+	{
+		Key.PointA = ExternalScreenBLActor ? ExternalScreenBLActor->GetActorLocation() : ExternalScreenBL;
+		Key.PointB = ExternalScreenBRActor ? ExternalScreenBRActor->GetActorLocation() : ExternalScreenBR;
+		Key.PointC = ExternalScreenTLActor ? ExternalScreenTLActor->GetActorLocation() : ExternalScreenTL;
+	}
+	else if (ScreenComponent)
+	{
+		// 只读 ComponentToWorld 和尺寸，不做四角变换（Virtual Parent 时是跟随后的位姿）
+		const FTransform Delta = GetVirtualParentDelta();
+		Key.Screen   = ScreenComponent;
+		Key.PointA   = Delta.TransformPosition(ScreenComponent->GetComponentLocation());
+		Key.Rotation = Delta.GetRotation() * ScreenComponent->GetComponentQuat();
+		Key.PointB   = FVector(ScreenComponent->ScreenWidth, ScreenComponent->ScreenHeight, 0.0f);
+	}
+	else
+	{
+		Key.PointA = GetVirtualParentDelta().TransformPosition(GetComponentLocation());
+	}
+	return Key;
+}
+
+const FAsymmetricScreenBasis& UAsymmetricCameraComponent::GetScreenBasis() const
+{
+	const FScreenBasisCacheKey Key = MakeScreenBasisCacheKey();
+	if (bScreenBasisCacheValid && Key == CachedScreenBasisKey)
+	{
+		++ProjectionCacheHits;
+		INC_DWORD_STAT(STAT_AsymmetricProjectionCacheHits);
+		return CachedScreenBasis;
+	}
+
+	++ProjectionCacheMisses;
+	INC_DWORD_STAT(STAT_AsymmetricProjectionCacheMisses);
+
+	FVector WorldBL, WorldBR, WorldTL, WorldTR;
+	GetEffectiveScreenCorners(WorldBL, WorldBR, WorldTL, WorldTR);
+	CachedScreenBasis = FAsymmetricProjectionKernel::MakeScreenBasis(WorldBL, WorldBR, WorldTL);
+	CachedScreenBasisKey = Key;
+	bScreenBasisCacheValid = true;
+	return CachedScreenBasis;
+}
+
+void UAsymmetricCameraComponent::InvalidateProjectionCache()
+{
+	bScreenBasisCacheValid = false;
+	bProjectionStateDirty = true;
+}
+
+void UAsymmetricCameraComponent::GetProjectionCacheStats(int64& OutHits, int64& OutMisses) const
+{
+	OutHits = ProjectionCacheHits;
+	OutMisses = ProjectionCacheMisses;
+}
+
 void UAsymmetricCameraComponent::GetEffectiveScreenCorners(
 	FVector& OutBL, FVector& OutBR, FVector& OutTL, FVector& OutTR) const
 {
@@ -241,10 +656,18 @@ void UAsymmetricCameraComponent::GetEffectiveScreenCorners(
 	else if (ScreenComponent)
 	{
 		ScreenComponent->GetScreenCornersWorld(OutBL, OutBR, OutTL, OutTR);
+		if (IsVirtualParentActive())
+		{
+			const FTransform Delta = GetVirtualParentDelta();
+			OutBL = Delta.TransformPosition(OutBL);
+			OutBR = Delta.TransformPosition(OutBR);
+			OutTL = Delta.TransformPosition(OutTL);
+			OutTR = Delta.TransformPosition(OutTR);
+		}
 	}
 	else
 	{
-		OutBL = OutBR = OutTL = OutTR = GetComponentLocation();
+		OutBL = OutBR = OutTL = OutTR = GetVirtualParentDelta().TransformPosition(GetComponentLocation());
 	}
 }
 
@@ -253,6 +676,7 @@ void UAsymmetricCameraComponent::SetExternalData(
 	const FVector& TL, const FVector& TR)
 {
 	bUseExternalData = true;
+	InvalidateProjectionCache();
 	ExternalEyePosition = EyePos;
 	ExternalScreenBL = BL;
 	ExternalScreenBR = BR;
@@ -334,6 +758,7 @@ void UAsymmetricCameraComponent::DrawDebugVisualization() const
 void UAsymmetricCameraComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateProjectionCache();
 
 	if (NearClip <= 0.0f)
 	{
@@ -343,5 +768,8 @@ void UAsymmetricCameraComponent::PostEditChangeProperty(FPropertyChangedEvent& P
 	{
 		FarClip = NearClip + 100.0f;
 	}
+
+	// PIE 里在细节面板改了跟随 / 调试开关
+	RefreshTickState();
 }
 #endif
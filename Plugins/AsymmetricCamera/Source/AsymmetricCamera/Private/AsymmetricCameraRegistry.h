@@ -0,0 +1,117 @@
+// 视图扩展查相机用的注册表：相机的投影状态双缓冲 + 所属 Actor，常数时间按 View 查找
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricProjectionState.h"
+#include "AsymmetricDoubleBuffer.h"
+
+class FSceneViewStateInterface;
+
+using FAsymmetricProjectionStateBuffer = TAsymmetricDoubleBuffer<FAsymmetricProjectionState>;
+
+/**
+ * 由 UAsymmetricCameraSubsystem 维护，唯一的视图扩展只读。
+ *
+ * 只保存每个相机的投影状态双缓冲和 Owner Actor 的 UniqueID，不持有 UObject，
+ * 视图扩展查表不需要解析弱指针。槽位在相机注销前保持不变，注销后可以被复用。
+ * 只在游戏线程读写：SetupViewProjectionMatrix / SetupView / BeginRenderViewFamily 都在游戏线程调用。
+ */
+class FAsymmetricCameraRegistry
+{
+public:
+	using FStateBufferRef = TSharedRef<const FAsymmetricProjectionStateBuffer, ESPMode::ThreadSafe>;
+
+	/** 登记一个相机，返回槽位 */
+	int32 Add(uint32 OwnerId, const FStateBufferRef& StateBuffer)
+	{
+		const int32 Slot = Slots.Add({ OwnerId, StateBuffer });
+		// 同一个 Actor 上有多个相机时按 Actor 查找只认第一个
+		SlotByOwner.FindOrAdd(OwnerId, Slot);
+		return Slot;
+	}
+
+	void Remove(int32 Slot)
+	{
+		if (!Slots.IsValidIndex(Slot))
+		{
+			return;
+		}
+
+		const uint32 OwnerId = Slots[Slot].OwnerId;
+		Slots.RemoveAt(Slot);
+		const int32* OwnerSlot = SlotByOwner.Find(OwnerId);
+		if (OwnerSlot && *OwnerSlot == Slot)
+		{
+			SlotByOwner.Remove(OwnerId);
+			for (TSparseArray<FSlot>::TConstIterator It(Slots); It; ++It)
+			{
+				if (It->OwnerId == OwnerId)
+				{
+					SlotByOwner.Add(OwnerId, It.GetIndex());
+					break;
+				}
+			}
+		}
+		if (ActiveSlot == Slot)
+		{
+			ActiveSlot = INDEX_NONE;
+		}
+	}
+
+	/** 当前驱动玩家视图的相机（由子系统每帧选出），INDEX_NONE 表示没有 */
+	void SetActiveSlot(int32 Slot) { ActiveSlot = Slots.IsValidIndex(Slot) ? Slot : INDEX_NONE; }
+
+	const FAsymmetricProjectionStateBuffer* GetActive() const
+	{
+		return Slots.IsValidIndex(ActiveSlot) ? &Slots[ActiveSlot].StateBuffer.Get() : nullptr;
+	}
+
+	/** 按 View 的 Actor 查相机，这个 Actor 上没有相机时返回当前活动相机 */
+	const FAsymmetricProjectionStateBuffer* FindForViewActor(uint32 ViewActorId) const
+	{
+		if (const int32* Slot = SlotByOwner.Find(ViewActorId))
+		{
+			return &Slots[*Slot].StateBuffer.Get();
+		}
+		return GetActive();
+	}
+
+	int32 Num() const { return Slots.Num(); }
+
+	/**
+	 * 离线渲染（MRQ）的画面分块，按 View 的 ViewState 区分。
+	 * MRQ 的 Render Pass 在创建 View 前按这个 View 将要使用的 ViewState 设置，SetupView 按 View 自己的 ViewState 查找并切出子视锥；
+	 * 左右眼、多个相机各有独立的 ViewState，互不串用，其他 Pass 的 View 查不到。不分块时是整幅画面。
+	 */
+	struct FOfflineTile
+	{
+		FBox2D Rect = FBox2D(FVector2D(0.0, 0.0), FVector2D(1.0, 1.0)); // 归一化，左上角为原点，含重叠边
+		FVector2D ClipJitter = FVector2D::ZeroVector;                    // 空间采样抖动（Tile 裁剪空间）
+	};
+
+	void SetOfflineTile(const FSceneViewStateInterface* ViewState, const FOfflineTile& Tile) { OfflineTiles.Add(ViewState, Tile); }
+	void ClearOfflineTiles() { OfflineTiles.Reset(); }
+	bool FindOfflineTile(const FSceneViewStateInterface* ViewState, FOfflineTile& OutTile) const
+	{
+		if (const FOfflineTile* Tile = OfflineTiles.Find(ViewState))
+		{
+			OutTile = *Tile;
+			return true;
+		}
+		return false;
+	}
+
+private:
+	struct FSlot
+	{
+		uint32 OwnerId = 0;
+		FStateBufferRef StateBuffer;
+	};
+
+	TSparseArray<FSlot> Slots;
+	TMap<uint32, int32> SlotByOwner;
+	int32 ActiveSlot = INDEX_NONE;
+
+	TMap<const FSceneViewStateInterface*, FOfflineTile> OfflineTiles;
+};
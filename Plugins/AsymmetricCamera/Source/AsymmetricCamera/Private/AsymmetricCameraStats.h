@@ -0,0 +1,11 @@
+// AsymmetricCamera 的 stat 分组（stat AsymmetricCamera 查看）和 CSV 分类
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("AsymmetricCamera"), STATGROUP_AsymmetricCamera, STATCAT_Advanced);
+
+/** 立体合成的进度和吞吐（csvprofiler 采集，定义在 AsymmetricCompositeScheduler.cpp） */
+CSV_DECLARE_CATEGORY_EXTERN(AsymmetricComposite);
@@ -0,0 +1,271 @@
+// 非对称相机世界子系统实现
+
+#include "AsymmetricCameraSubsystem.h"
+#include "AsymmetricCameraComponent.h"
+#include "AsymmetricScreenComponent.h"
+#include "AsymmetricCameraRegistry.h"
+#include "AsymmetricCameraStats.h"
+#include "AsymmetricViewExtension.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneViewExtension.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricCameraSubsystem, Log, All);
+
+DECLARE_CYCLE_STAT(TEXT("Publish Projection States"), STAT_AsymmetricPublishProjectionStates, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Cameras"), STAT_AsymmetricRegisteredCameras, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projection States Published"), STAT_AsymmetricProjectionStatesPublished, STATGROUP_AsymmetricCamera);
+
+bool UAsymmetricCameraSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// 和以前每个组件自己注册扩展时一致：在编辑器世界里 BeginPlay 的相机（如在编辑器世界里启动的 MRQ 渲染）也要生效。
+	// 其他世界（编辑器预览窗口等）里没有视图扩展，离轴投影不生效
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE || WorldType == EWorldType::Editor;
+}
+
+bool UAsymmetricCameraSubsystem::IsTickableInEditor() const
+{
+	// 编辑器世界不走游戏 Tick，没有相机登记时 IsTickable 仍然返回 false
+	return true;
+}
+
+void UAsymmetricCameraSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_AsymmetricRegisteredCameras, Cameras.Num());
+	Cameras.Reset();
+	Screens.Reset();
+	PinnedCamera = nullptr;
+	ActiveCamera = nullptr;
+	ViewExtension.Reset();
+	Registry.Reset();
+	Super::Deinitialize();
+}
+
+bool UAsymmetricCameraSubsystem::IsTickable() const
+{
+	return Cameras.Num() > 0;
+}
+
+TStatId UAsymmetricCameraSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAsymmetricCameraSubsystem, STATGROUP_Tickables);
+}
+
+void UAsymmetricCameraSubsystem::Tick(float DeltaTime)
+{
+	PublishAll();
+}
+
+void UAsymmetricCameraSubsystem::RegisterCamera(UAsymmetricCameraComponent* Camera)
+{
+	if (!Camera || Cameras.ContainsByPredicate([Camera](const FCameraEntry& Entry) { return Entry.Camera == Camera; }))
+	{
+		return;
+	}
+
+	if (!Registry.IsValid())
+	{
+		Registry = MakeShared<FAsymmetricCameraRegistry, ESPMode::ThreadSafe>();
+	}
+	if (!ViewExtension.IsValid())
+	{
+		ViewExtension = FSceneViewExtensions::NewExtension<FAsymmetricViewExtension>(GetWorld(), Registry.ToSharedRef());
+	}
+
+	const AActor* Owner = Camera->GetOwner();
+	FCameraEntry& Entry = Cameras.AddDefaulted_GetRef();
+	Entry.Camera = Camera;
+	Entry.RegistrySlot = Registry->Add(Owner ? Owner->GetUniqueID() : 0, Camera->GetProjectionStateBuffer());
+	INC_DWORD_STAT(STAT_AsymmetricRegisteredCameras);
+
+	UE_LOG(LogAsymmetricCameraSubsystem, Verbose, TEXT("Registered asymmetric camera %s (%d total)."), *Camera->GetPathName(), Cameras.Num());
+}
+
+void UAsymmetricCameraSubsystem::UnregisterCamera(UAsymmetricCameraComponent* Camera)
+{
+	const int32 Index = Cameras.IndexOfByPredicate([Camera](const FCameraEntry& Entry) { return Entry.Camera == Camera; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	Registry->Remove(Cameras[Index].RegistrySlot);
+	Cameras.RemoveAt(Index);
+	DEC_DWORD_STAT(STAT_AsymmetricRegisteredCameras);
+
+	if (ActiveCamera == Camera)
+	{
+		ActiveCamera = nullptr;
+	}
+	if (PinnedCamera == Camera)
+	{
+		PinnedCamera = nullptr;
+	}
+}
+
+void UAsymmetricCameraSubsystem::RegisterScreen(UAsymmetricScreenComponent* Screen)
+{
+	if (Screen)
+	{
+		Screens.AddUnique(Screen);
+	}
+}
+
+void UAsymmetricCameraSubsystem::UnregisterScreen(UAsymmetricScreenComponent* Screen)
+{
+	Screens.Remove(Screen);
+
+	// 引用这块屏幕的相机不能再用缓存的正交基
+	for (const FCameraEntry& Entry : Cameras)
+	{
+		UAsymmetricCameraComponent* Camera = Entry.Camera.Get();
+		if (Camera && Camera->ScreenComponent == Screen)
+		{
+			Camera->InvalidateProjectionCache();
+		}
+	}
+}
+
+void UAsymmetricCameraSubsystem::SetActiveCamera(UAsymmetricCameraComponent* Camera)
+{
+	PinnedCamera = Camera;
+}
+
+TArray<UAsymmetricCameraComponent*> UAsymmetricCameraSubsystem::GetCameras() const
+{
+	TArray<UAsymmetricCameraComponent*> Result;
+	Result.Reserve(Cameras.Num());
+	for (const FCameraEntry& Entry : Cameras)
+	{
+		if (UAsymmetricCameraComponent* Camera = Entry.Camera.Get())
+		{
+			Result.Add(Camera);
+		}
+	}
+	return Result;
+}
+
+UAsymmetricCameraComponent* UAsymmetricCameraSubsystem::FindCameraByTag(FName Tag) const
+{
+	if (Tag.IsNone())
+	{
+		return nullptr;
+	}
+
+	for (const FCameraEntry& Entry : Cameras)
+	{
+		UAsymmetricCameraComponent* Camera = Entry.Camera.Get();
+		if (!Camera)
+		{
+			continue;
+		}
+
+		const AActor* Owner = Camera->GetOwner();
+		if (Camera->ComponentHasTag(Tag) || (Owner && Owner->ActorHasTag(Tag)))
+		{
+			return Camera;
+		}
+	}
+	return nullptr;
+}
+
+TArray<UAsymmetricScreenComponent*> UAsymmetricCameraSubsystem::GetScreens() const
+{
+	TArray<UAsymmetricScreenComponent*> Result;
+	Result.Reserve(Screens.Num());
+	for (const TWeakObjectPtr<UAsymmetricScreenComponent>& Screen : Screens)
+	{
+		if (Screen.IsValid())
+		{
+			Result.Add(Screen.Get());
+		}
+	}
+	return Result;
+}
+
+UAsymmetricCameraComponent* UAsymmetricCameraSubsystem::ResolveActiveCamera() const
+{
+	if (UAsymmetricCameraComponent* Pinned = PinnedCamera.Get())
+	{
+		return Pinned;
+	}
+
+	// 玩家正在看的 Actor 上启用了离轴投影的相机（Sequencer 切镜头、SetViewTarget 切换时跟着走）
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	const AActor* ViewTarget = PlayerController ? PlayerController->GetViewTarget() : nullptr;
+	if (ViewTarget)
+	{
+		for (const FCameraEntry& Entry : Cameras)
+		{
+			UAsymmetricCameraComponent* Camera = Entry.Camera.Get();
+			if (Camera && Camera->bUseAsymmetricProjection && Camera->GetOwner() == ViewTarget)
+			{
+				return Camera;
+			}
+		}
+	}
+
+	// 和以前每个相机各注册一个扩展时一致：最后登记的生效
+	for (int32 Index = Cameras.Num() - 1; Index >= 0; --Index)
+	{
+		UAsymmetricCameraComponent* Camera = Cameras[Index].Camera.Get();
+		if (Camera && Camera->bUseAsymmetricProjection)
+		{
+			return Camera;
+		}
+	}
+	return nullptr;
+}
+
+void UAsymmetricCameraSubsystem::SetOfflineRenderTile(const FSceneViewStateInterface* ViewState, const FBox2D& NormalizedRect, const FVector2D& ClipJitter)
+{
+	if (Registry.IsValid())
+	{
+		FAsymmetricCameraRegistry::FOfflineTile Tile;
+		Tile.Rect = NormalizedRect;
+		Tile.ClipJitter = ClipJitter;
+		Registry->SetOfflineTile(ViewState, Tile);
+	}
+}
+
+void UAsymmetricCameraSubsystem::ClearOfflineRenderTiles()
+{
+	if (Registry.IsValid())
+	{
+		Registry->ClearOfflineTiles();
+	}
+}
+
+void UAsymmetricCameraSubsystem::PublishAll()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsymmetricPublishProjectionStates);
+
+	int32 ActiveSlot = INDEX_NONE;
+	UAsymmetricCameraComponent* Active = ResolveActiveCamera();
+	for (const FCameraEntry& Entry : Cameras)
+	{
+		UAsymmetricCameraComponent* Camera = Entry.Camera.Get();
+		if (!Camera)
+		{
+			continue;
+		}
+
+		// 输入没变的相机（静止的屏幕阵列）保留上次发布的状态。逐个相机发布屏幕正交基和眼睛位置，
+		// 投影矩阵由视图扩展按 View 计算（依赖延迟锁存的眼睛位置、立体眼偏移和 MRQ 分块）
+		if (Camera->NeedsProjectionStatePublish())
+		{
+			Camera->PublishProjectionState();
+			INC_DWORD_STAT(STAT_AsymmetricProjectionStatesPublished);
+		}
+		if (Camera == Active)
+		{
+			ActiveSlot = Entry.RegistrySlot;
+		}
+	}
+
+	ActiveCamera = Active;
+	if (Registry.IsValid())
+	{
+		Registry->SetActiveSlot(ActiveSlot);
+	}
+}
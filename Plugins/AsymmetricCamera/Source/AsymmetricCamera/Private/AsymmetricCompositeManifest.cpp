@@ -0,0 +1,145 @@
+// 合成清单读写
+
+#include "AsymmetricCompositeManifest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricCompositeManifest, Log, All);
+
+namespace
+{
+	/** 格式或摘要内容变化时加一，旧版本清单整体作废 */
+	constexpr int32 ManifestVersion = 3;
+
+	/** JSON 数字是 double，64 位摘要按十六进制字符串保存 */
+	FString ManifestHashToString(uint64 Hash)
+	{
+		return FString::Printf(TEXT("%016llx"), Hash);
+	}
+
+	const TCHAR* ManifestStateToString(FAsymmetricCompositeManifest::EState State)
+	{
+		return (State == FAsymmetricCompositeManifest::EState::Complete) ? TEXT("complete") : TEXT("in_progress");
+	}
+}
+
+FAsymmetricCompositeManifest::FAsymmetricCompositeManifest(const FString& InDirectory)
+	: Path(FPaths::Combine(InDirectory, GetFileName()))
+{
+}
+
+void FAsymmetricCompositeManifest::Load()
+{
+	Entries.Reset();
+
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+	{
+		UE_LOG(LogAsymmetricCompositeManifest, Warning, TEXT("Ignoring unreadable composite manifest %s, all shots will be recomposited."), *Path);
+		return;
+	}
+
+	int32 Version = 0;
+	if (!Root->TryGetNumberField(TEXT("version"), Version) || Version != ManifestVersion)
+	{
+		UE_LOG(LogAsymmetricCompositeManifest, Log, TEXT("Composite manifest %s has version %d (expected %d), ignoring it."), *Path, Version, ManifestVersion);
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* Shots = nullptr;
+	if (!Root->TryGetObjectField(TEXT("shots"), Shots))
+	{
+		return;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& ShotPair : (*Shots)->Values)
+	{
+		const TSharedPtr<FJsonObject> ShotObject = ShotPair.Value.IsValid() ? ShotPair.Value->AsObject() : nullptr;
+		if (!ShotObject.IsValid())
+		{
+			continue;
+		}
+
+		FEntry Entry;
+		Entry.State = (ShotObject->GetStringField(TEXT("state")) == TEXT("complete")) ? EState::Complete : EState::InProgress;
+		Entry.InputHash = FParse::HexNumber64(*ShotObject->GetStringField(TEXT("inputs")));
+		Entry.SettingsHash = FParse::HexNumber64(*ShotObject->GetStringField(TEXT("settings")));
+		ShotObject->TryGetNumberField(TEXT("frame_pairs"), Entry.NumFramePairs);
+		FDateTime::ParseIso8601(*ShotObject->GetStringField(TEXT("updated")), Entry.Updated);
+
+		const TArray<TSharedPtr<FJsonValue>>* Outputs = nullptr;
+		if (ShotObject->TryGetArrayField(TEXT("outputs"), Outputs))
+		{
+			for (const TSharedPtr<FJsonValue>& OutputValue : *Outputs)
+			{
+				const TSharedPtr<FJsonObject> OutputObject = OutputValue.IsValid() ? OutputValue->AsObject() : nullptr;
+				if (OutputObject.IsValid())
+				{
+					FOutput& Output = Entry.Outputs.AddDefaulted_GetRef();
+					Output.Name = OutputObject->GetStringField(TEXT("name"));
+					OutputObject->TryGetNumberField(TEXT("files"), Output.NumFiles);
+					OutputObject->TryGetNumberField(TEXT("bytes"), Output.Bytes);
+				}
+			}
+		}
+		Entries.Add(ShotPair.Key, MoveTemp(Entry));
+	}
+}
+
+bool FAsymmetricCompositeManifest::Save() const
+{
+	FString Json;
+	TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("version"), ManifestVersion);
+	Writer->WriteObjectStart(TEXT("shots"));
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		const FEntry& Entry = Pair.Value;
+		Writer->WriteObjectStart(Pair.Key);
+		Writer->WriteValue(TEXT("state"), ManifestStateToString(Entry.State));
+		Writer->WriteValue(TEXT("inputs"), ManifestHashToString(Entry.InputHash));
+		Writer->WriteValue(TEXT("settings"), ManifestHashToString(Entry.SettingsHash));
+		Writer->WriteValue(TEXT("frame_pairs"), Entry.NumFramePairs);
+		Writer->WriteValue(TEXT("updated"), Entry.Updated.ToIso8601());
+		Writer->WriteArrayStart(TEXT("outputs"));
+		for (const FOutput& Output : Entry.Outputs)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), Output.Name);
+			Writer->WriteValue(TEXT("files"), Output.NumFiles);
+			Writer->WriteValue(TEXT("bytes"), Output.Bytes);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	// 先写临时文件再替换，写到一半崩溃时旧清单仍然完整
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Json, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*Path, *TempPath, /*bReplace=*/true))
+	{
+		IFileManager::Get().Delete(*TempPath, /*bRequireExists=*/false);
+		UE_LOG(LogAsymmetricCompositeManifest, Warning, TEXT("Failed to write composite manifest %s"), *Path);
+		return false;
+	}
+	return true;
+}
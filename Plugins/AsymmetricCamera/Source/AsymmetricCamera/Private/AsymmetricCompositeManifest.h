@@ -0,0 +1,66 @@
+// 合成清单：记录每个 Shot 上次合成时的输入和设置摘要，重新导出时跳过没有变化的 Shot
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 一个输出目录的合成清单（stereo_composite_manifest.json）。
+ *
+ * 每个 Shot 一条：输入帧列表（帧号区间 + 每帧路径、大小和内容抽样）和合成设置各自的 64 位摘要、状态、每个输出版本的文件数和字节数。
+ * Shot 合成成功后写入 Complete 并记录输出，失败时删掉条目，每个 Shot 只保存一次；
+ * 崩溃或取消留下的不完整输出和记录的文件数、字节数对不上，下次导出会重新合成。
+ * 保存时先写临时文件再改名，写到一半崩溃不会损坏已有清单。只在游戏线程使用。
+ */
+class FAsymmetricCompositeManifest
+{
+public:
+	enum class EState : uint8
+	{
+		InProgress,
+		Complete,
+	};
+
+	/** 一个输出版本在磁盘上的状态 */
+	struct FOutput
+	{
+		FString Name;           // 视频为文件名，图片序列为文件名主干（不含帧号）
+		int32   NumFiles = 0;
+		int64   Bytes = 0;
+
+		bool operator==(const FOutput& Other) const
+		{
+			return Name == Other.Name && NumFiles == Other.NumFiles && Bytes == Other.Bytes;
+		}
+	};
+
+	struct FEntry
+	{
+		EState State = EState::InProgress;
+		uint64 InputHash = 0;
+		uint64 SettingsHash = 0;
+		int32  NumFramePairs = 0;
+		FDateTime Updated;
+		TArray<FOutput> Outputs;  // 仅 Complete 时有效
+	};
+
+	explicit FAsymmetricCompositeManifest(const FString& InDirectory);
+
+	static const TCHAR* GetFileName() { return TEXT("stereo_composite_manifest.json"); }
+
+	/** 读取目录下的清单；文件不存在或格式不对时得到空清单 */
+	void Load();
+
+	/** 写回磁盘 */
+	bool Save() const;
+
+	const FEntry* Find(const FString& ShotName) const { return Entries.Find(ShotName); }
+	void Set(const FString& ShotName, const FEntry& Entry) { Entries.Add(ShotName, Entry); }
+	void Remove(const FString& ShotName) { Entries.Remove(ShotName); }
+
+	const FString& GetPath() const { return Path; }
+
+private:
+	FString Path;
+	TMap<FString, FEntry> Entries;
+};
@@ -0,0 +1,184 @@
+// 立体合成进程池实现
+
+#include "AsymmetricCompositeScheduler.h"
+#include "AsymmetricCameraStats.h"
+#include "HAL/PlatformMisc.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricCompositeScheduler, Log, All);
+
+CSV_DEFINE_CATEGORY(AsymmetricComposite, true);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Composite Jobs Running"), STAT_AsymmetricCompositeJobsRunning, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Composite Jobs Queued"), STAT_AsymmetricCompositeJobsQueued, STATGROUP_AsymmetricCamera);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Composite Encode FPS"), STAT_AsymmetricCompositeEncodeFps, STATGROUP_AsymmetricCamera);
+
+FAsymmetricCompositeScheduler::FAsymmetricCompositeScheduler(int32 InMaxConcurrency)
+	: MaxConcurrency(FMath::Max(1, InMaxConcurrency))
+{
+	// 进程状态不需要每帧查，0.1 秒一次足够，FFmpeg 合成一个 Shot 通常要几秒到几分钟
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FAsymmetricCompositeScheduler::Tick), 0.1f);
+}
+
+FAsymmetricCompositeScheduler::~FAsymmetricCompositeScheduler()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	CancelAll();
+	UpdateStats();
+}
+
+int32 FAsymmetricCompositeScheduler::ComputeDefaultConcurrency(int32 ThreadsPerProcess)
+{
+	if (ThreadsPerProcess <= 0)
+	{
+		return 1;
+	}
+	return FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads() / ThreadsPerProcess);
+}
+
+void FAsymmetricCompositeScheduler::Enqueue(FJob&& Job)
+{
+	Job.QueuedTime = FPlatformTime::Seconds();
+	Pending.Add(MoveTemp(Job));
+}
+
+void FAsymmetricCompositeScheduler::CancelAll()
+{
+	for (FRunningJob& RunningJob : Running)
+	{
+		if (RunningJob.Process->Poll())
+		{
+			UE_LOG(LogAsymmetricCompositeScheduler, Warning, TEXT("Terminating composite '%s'."), *RunningJob.Job.Name);
+		}
+		RunningJob.Process->Terminate();
+	}
+	Running.Reset();
+	Pending.Reset();
+}
+
+bool FAsymmetricCompositeScheduler::Tick(float DeltaTime)
+{
+	Update();
+	return true;
+}
+
+void FAsymmetricCompositeScheduler::Update()
+{
+	if (bInUpdate)
+	{
+		return;
+	}
+	TGuardValue<bool> UpdateGuard(bInUpdate, true);
+
+	// 先收集已结束的进程，腾出槽位后再启动新的；仍在运行的顺便读空输出管道
+	const double Now = FPlatformTime::Seconds();
+	TArray<FRunningJob, TInlineAllocator<16>> Finished;
+	for (int32 Index = Running.Num() - 1; Index >= 0; --Index)
+	{
+		FRunningJob& RunningJob = Running[Index];
+		FAsymmetricFFmpegProcess& Process = *RunningJob.Process;
+		if (!Process.TryGetReturnCode(RunningJob.Result.ReturnCode))
+		{
+			const FAsymmetricFFmpegProgress& Progress = Process.GetProgress();
+			if (Progress.bValid && Now - RunningJob.LastProgressLogTime >= ProgressLogInterval)
+			{
+				RunningJob.LastProgressLogTime = Now;
+				UE_LOG(LogAsymmetricCompositeScheduler, Log, TEXT("Composite '%s': %s"), *RunningJob.Job.Name, *Progress.ToString());
+			}
+
+			// 帧数长时间不动：输入读不动、磁盘满或进程卡死，提示一次，不主动终止
+			if (Progress.Frame != RunningJob.LastProgressFrame)
+			{
+				RunningJob.LastProgressFrame = Progress.Frame;
+				RunningJob.LastProgressChangeTime = Now;
+				RunningJob.bStallReported = false;
+			}
+			else if (!RunningJob.bStallReported && Now - RunningJob.LastProgressChangeTime >= StallWarningSeconds)
+			{
+				RunningJob.bStallReported = true;
+				UE_LOG(LogAsymmetricCompositeScheduler, Warning, TEXT("Composite '%s' has not advanced past frame %lld for %.0f s (CPU time %.1f s)."),
+					*RunningJob.Job.Name, Progress.Frame, Now - RunningJob.LastProgressChangeTime, Process.GetCpuSeconds());
+			}
+			continue;
+		}
+
+		RunningJob.Result.EndTime = Now;
+		RunningJob.Result.Log = Process.GetLogTail();
+		RunningJob.Result.Progress = Process.GetProgress();
+		RunningJob.Result.CpuSeconds = Process.GetCpuSeconds();
+		RunningJob.Process.Reset();
+		Finished.Add(MoveTemp(RunningJob));
+		Running.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+
+	LaunchPending();
+	UpdateStats();
+
+	// 回调放在最后，回调里再 Enqueue 的任务下一次 Tick 启动
+	for (int32 Index = Finished.Num() - 1; Index >= 0; --Index)
+	{
+		FRunningJob& Job = Finished[Index];
+		if (Job.Job.OnCompleted)
+		{
+			Job.Job.OnCompleted(Job.Result);
+		}
+	}
+}
+
+void FAsymmetricCompositeScheduler::LaunchPending()
+{
+	int32 NumLaunched = 0;
+	while (Running.Num() < MaxConcurrency && NumLaunched < Pending.Num())
+	{
+		// 先移出来：启动失败的回调里可能再 Enqueue，Pending 会扩容
+		FJob Job = MoveTemp(Pending[NumLaunched++]);
+
+		FRunningJob RunningJob;
+		RunningJob.Result.QueuedTime = Job.QueuedTime;
+		RunningJob.Result.StartTime = FPlatformTime::Seconds();
+		RunningJob.LastProgressLogTime = RunningJob.Result.StartTime;
+		RunningJob.LastProgressChangeTime = RunningJob.Result.StartTime;
+		RunningJob.Process = MakeUnique<FAsymmetricFFmpegProcess>();
+
+		if (!RunningJob.Process->Launch(Job.Executable, Job.Arguments))
+		{
+			UE_LOG(LogAsymmetricCompositeScheduler, Error, TEXT("Failed to launch composite '%s': %s %s"),
+				*Job.Name, *Job.Executable, *FAsymmetricFFmpegProcess::BuildCommandLine(Job.Arguments));
+
+			// 启动失败直接回调，不占槽位
+			RunningJob.Result.EndTime = RunningJob.Result.StartTime;
+			if (Job.OnCompleted)
+			{
+				Job.OnCompleted(RunningJob.Result);
+			}
+			continue;
+		}
+
+		UE_LOG(LogAsymmetricCompositeScheduler, Log, TEXT("Started composite '%s' (%d/%d slots busy, %d queued)."),
+			*Job.Name, Running.Num() + 1, MaxConcurrency, Pending.Num() - NumLaunched);
+
+		RunningJob.Result.bLaunched = true;
+		RunningJob.Job = MoveTemp(Job);
+		Running.Add(MoveTemp(RunningJob));
+	}
+
+	Pending.RemoveAt(0, NumLaunched, EAllowShrinking::No);
+}
+
+void FAsymmetricCompositeScheduler::UpdateStats() const
+{
+	float EncodeFps = 0.0f;
+	for (const FRunningJob& RunningJob : Running)
+	{
+		const FAsymmetricFFmpegProgress& Progress = RunningJob.Process->GetProgress();
+		EncodeFps += (Progress.bValid && !Progress.bEnded) ? Progress.Fps : 0.0f;
+	}
+
+	SET_DWORD_STAT(STAT_AsymmetricCompositeJobsRunning, Running.Num());
+	SET_DWORD_STAT(STAT_AsymmetricCompositeJobsQueued, Pending.Num());
+	SET_FLOAT_STAT(STAT_AsymmetricCompositeEncodeFps, EncodeFps);
+
+	CSV_CUSTOM_STAT(AsymmetricComposite, JobsRunning, Running.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsymmetricComposite, JobsQueued, Pending.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsymmetricComposite, EncodeFps, EncodeFps, ECsvCustomStatOp::Set);
+}
@@ -0,0 +1,102 @@
+// 立体合成进程池：有上限地并行运行多个 FFmpeg 合成任务
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "AsymmetricFFmpegProcess.h"
+
+/**
+ * 有界进程池。任务按入队顺序启动，同时运行的进程数不超过 MaxConcurrency，
+ * 每个任务结束时在游戏线程回调 OnCompleted（按完成顺序，不按入队顺序）。
+ *
+ * 自己挂在 FTSTicker 上轮询进程状态并读出各进程的输出管道，不依赖调用方每帧驱动；
+ * 运行中每隔 ProgressLogInterval 秒打印一次 FFmpeg 进度，超过 StallWarningSeconds 帧数不动时警告；
+ * 运行 / 排队任务数和合计编码帧率同时写入 stat AsymmetricCamera 和 CSV 分类 AsymmetricComposite。
+ * 析构时终止仍在运行的进程并移除 Ticker。只在游戏线程使用。
+ */
+class FAsymmetricCompositeScheduler
+{
+public:
+	/** 单个任务的执行结果 */
+	struct FJobResult
+	{
+		bool   bLaunched = false;     // 进程是否成功启动
+		int32  ReturnCode = -1;
+		double QueuedTime = 0.0;      // FPlatformTime::Seconds，入队时间
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		double CpuSeconds = 0.0;      // 进程 CPU 时间，见 FAsymmetricFFmpegProcess::GetCpuSeconds
+		FString Log;                  // 进程输出的最后若干行（不含进度行），失败时用来报告原因
+		FAsymmetricFFmpegProgress Progress; // 结束时最后一组进度
+
+		bool   Succeeded() const { return bLaunched && ReturnCode == 0; }
+		double GetDuration() const { return EndTime - StartTime; }
+		double GetQueueWait() const { return StartTime - QueuedTime; }
+	};
+
+	/** 一个待执行的外部进程 */
+	struct FJob
+	{
+		FString Name;                 // 用于日志
+		FString Executable;
+		TArray<FString> Arguments;    // 参数向量，每项一个参数，不需要自己加引号
+		TFunction<void(const FJobResult&)> OnCompleted;
+		double QueuedTime = 0.0;      // 由 Enqueue 填写
+	};
+
+	explicit FAsymmetricCompositeScheduler(int32 InMaxConcurrency);
+	~FAsymmetricCompositeScheduler();
+
+	FAsymmetricCompositeScheduler(const FAsymmetricCompositeScheduler&) = delete;
+	FAsymmetricCompositeScheduler& operator=(const FAsymmetricCompositeScheduler&) = delete;
+
+	/**
+	 * 默认并发数：逻辑核数 / 每个进程的线程数，至少 1。
+	 * @param ThreadsPerProcess - 每个 FFmpeg 进程的 -threads；0 表示由 FFmpeg 自己决定（会占满所有核），此时只跑 1 个
+	 */
+	static int32 ComputeDefaultConcurrency(int32 ThreadsPerProcess);
+
+	/** 入队，空闲槽位会在下一次 Tick 时启动 */
+	void Enqueue(FJob&& Job);
+
+	/** 终止所有运行中的进程，丢弃未启动的任务（不触发回调） */
+	void CancelAll();
+
+	/** 没有运行中也没有排队的任务 */
+	bool IsIdle() const { return Running.Num() == 0 && Pending.Num() == 0; }
+
+	int32 GetNumRunning() const { return Running.Num(); }
+	int32 GetNumPending() const { return Pending.Num(); }
+	int32 GetMaxConcurrency() const { return MaxConcurrency; }
+
+	/** 立即轮询一次（Ticker 也会定期调用） */
+	void Update();
+
+private:
+	static constexpr double ProgressLogInterval = 5.0;
+	static constexpr double StallWarningSeconds = 30.0;
+
+	struct FRunningJob
+	{
+		FJob        Job;
+		TUniquePtr<FAsymmetricFFmpegProcess> Process;
+		FJobResult  Result;
+		double      LastProgressLogTime = 0.0;
+		int64       LastProgressFrame = -1;
+		double      LastProgressChangeTime = 0.0;  // 帧数最近一次变化的时间
+		bool        bStallReported = false;
+	};
+
+	bool Tick(float DeltaTime);
+	void LaunchPending();
+
+	/** 写 stat / CSV：运行和排队任务数、所有运行中任务的编码帧率之和 */
+	void UpdateStats() const;
+
+	int32 MaxConcurrency = 1;
+	TArray<FJob> Pending;             // 按入队顺序启动
+	TArray<FRunningJob> Running;
+	FTSTicker::FDelegateHandle TickerHandle;
+	bool bInUpdate = false;           // 回调里再入队时避免重入 Update
+};
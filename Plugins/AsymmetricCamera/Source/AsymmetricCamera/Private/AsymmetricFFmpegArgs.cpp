@@ -0,0 +1,162 @@
+// FFmpeg 命令行参数拼装实现
+
+#include "AsymmetricFFmpegArgs.h"
+#include "Engine/EngineTypes.h"
+#include "Misc/FrameRate.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricFFmpegArgs, Log, All);
+
+void FAsymmetricFFmpegArgs::Append(TArray<FString>& OutArgs, const FString& Fragment)
+{
+	TArray<FString> Tokens;
+	Fragment.ParseIntoArrayWS(Tokens);
+	OutArgs.Append(MoveTemp(Tokens));
+}
+
+FString FAsymmetricFFmpegArgs::GetCodecString(EFFmpegVideoCodec InCodec)
+{
+	switch (InCodec)
+	{
+	case EFFmpegVideoCodec::H264: return TEXT("libx264");
+	case EFFmpegVideoCodec::H265: return TEXT("libx265");
+	default:                      return TEXT("libx264");
+	}
+}
+
+FString FAsymmetricFFmpegArgs::GetOutputFormat(EFFmpegVideoCodec InCodec, EFFmpegOutputFormat InFormat)
+{
+	if (InCodec == EFFmpegVideoCodec::H265)
+	{
+		return TEXT("mkv");
+	}
+
+	switch (InFormat)
+	{
+	case EFFmpegOutputFormat::MP4: return TEXT("mp4");
+	case EFFmpegOutputFormat::MOV: return TEXT("mov");
+	case EFFmpegOutputFormat::MKV: return TEXT("mkv");
+	case EFFmpegOutputFormat::AVI: return TEXT("avi");
+	default:                       return TEXT("mp4");
+	}
+}
+
+FString FAsymmetricFFmpegArgs::GetPixFmt(EFFmpegVideoCodec /*InCodec*/)
+{
+	return TEXT("yuv420p");
+}
+
+FString FAsymmetricFFmpegArgs::GetQualityArgs(EFFmpegVideoCodec /*InCodec*/, int32 InCRF)
+{
+	// -preset slow：慢速编码，相同 CRF 下压缩率更高、质量更好
+	return FString::Printf(TEXT("-crf %d -preset slow"), InCRF);
+}
+
+FString FAsymmetricFFmpegArgs::GetStereoEncoderArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout)
+{
+	if (InCodec == EFFmpegVideoCodec::H264)
+	{
+		// Frame Packing Arrangement SEI: type 3=SBS, type 4=TB，VLC/PotPlayer 可自动识别
+		const int32 FramePackingType = (InLayout == EAsymmetricStereoLayout::SideBySide) ? 3 : 4;
+		return FString::Printf(TEXT("-x264-params frame-packing=%d"), FramePackingType);
+	}
+	return FString();
+}
+
+FString FAsymmetricFFmpegArgs::GetStereoContainerArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout)
+{
+	if (InCodec == EFFmpegVideoCodec::H265)
+	{
+		// x265 不支持 frame-packing CLI 参数，改用 MKV 容器的 stereo_mode 元数据
+		const TCHAR* StereoMode = (InLayout == EAsymmetricStereoLayout::SideBySide)
+			? TEXT("side_by_side_left") : TEXT("top_bottom_left");
+		return FString::Printf(TEXT("-metadata:s:v stereo_mode=%s"), StereoMode);
+	}
+	return FString();
+}
+
+FString FAsymmetricFFmpegArgs::GetStereoMetadataArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout)
+{
+	return (GetStereoEncoderArgs(InCodec, InLayout) + TEXT(" ") + GetStereoContainerArgs(InCodec, InLayout)).TrimStartAndEnd();
+}
+
+FString FAsymmetricFFmpegArgs::GetFixedGopArgs(EFFmpegVideoCodec InCodec, int32 InGopFrames)
+{
+	if (InCodec == EFFmpegVideoCodec::H265)
+	{
+		return FString::Printf(TEXT("-g %d -keyint_min %d -x265-params scenecut=0:open-gop=0"), InGopFrames, InGopFrames);
+	}
+	return FString::Printf(TEXT("-g %d -keyint_min %d -sc_threshold 0"), InGopFrames, InGopFrames);
+}
+
+FString FAsymmetricFFmpegArgs::GetThreadsArg(int32 InThreads)
+{
+	return (InThreads > 0) ? FString::Printf(TEXT("-threads %d "), InThreads) : FString();
+}
+
+FString FAsymmetricFFmpegArgs::GetFrameRateString(const FFrameRate& InFrameRate)
+{
+	return FString::Printf(TEXT("%d/%d"), InFrameRate.Numerator, InFrameRate.Denominator);
+}
+
+const TCHAR* FAsymmetricFFmpegArgs::GetLayoutName(EAsymmetricStereoLayout InLayout)
+{
+	return (InLayout == EAsymmetricStereoLayout::SideBySide) ? TEXT("SBS") : TEXT("TB");
+}
+
+FString FAsymmetricFFmpegArgs::FindExecutableOnPath()
+{
+#if PLATFORM_WINDOWS
+	const TCHAR* ExecutableName = TEXT("ffmpeg.exe");
+#else
+	const TCHAR* ExecutableName = TEXT("ffmpeg");
+#endif
+
+	TArray<FString> Directories;
+	FPlatformMisc::GetEnvironmentVariable(TEXT("PATH")).ParseIntoArray(Directories, FPlatformMisc::GetPathVarDelimiter(), /*InCullEmpty=*/true);
+	for (FString& Directory : Directories)
+	{
+		// Windows 的 PATH 项可以带引号
+		Directory.TrimQuotesInline();
+		FString Candidate = FPaths::Combine(Directory, ExecutableName);
+		if (!Directory.IsEmpty() && FPaths::FileExists(Candidate))
+		{
+			Candidate = FPaths::ConvertRelativePathToFull(Candidate);
+			FPaths::NormalizeFilename(Candidate);
+			return Candidate;
+		}
+	}
+	return FString();
+}
+
+FString FAsymmetricFFmpegArgs::ResolveExecutable(const FFilePath& UserPath)
+{
+	if (UserPath.FilePath.IsEmpty())
+	{
+		// CreateProc 在 Unix 上不搜索 PATH（相对名按工作目录解析），这里自己找到绝对路径
+		const FString Found = FindExecutableOnPath();
+		if (Found.IsEmpty())
+		{
+			UE_LOG(LogAsymmetricFFmpegArgs, Error,
+				TEXT("FFmpegPath is empty and no ffmpeg executable was found on the system PATH. "
+				     "Set an absolute path in the pass settings."));
+			return FString();
+		}
+		UE_LOG(LogAsymmetricFFmpegArgs, Log, TEXT("FFmpegPath is empty, using ffmpeg from the system PATH: %s"), *Found);
+		return Found;
+	}
+
+	// 确保路径始终是绝对路径，与编辑器存储方式无关
+	FString Resolved = UserPath.FilePath;
+	if (FPaths::IsRelative(Resolved))
+	{
+		Resolved = FPaths::ConvertRelativePathToFull(Resolved);
+		UE_LOG(LogAsymmetricFFmpegArgs, Warning,
+			TEXT("FFmpegPath was relative, resolved to absolute: %s"), *Resolved);
+	}
+
+	FPaths::NormalizeFilename(Resolved);
+	UE_LOG(LogAsymmetricFFmpegArgs, Log, TEXT("Using FFmpeg: %s"), *Resolved);
+	return Resolved;
+}
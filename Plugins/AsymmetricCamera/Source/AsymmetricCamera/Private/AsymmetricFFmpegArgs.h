@@ -0,0 +1,60 @@
+// FFmpeg 命令行参数拼装：立体合成 Pass 和流式输出节点共用
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricStereoTypes.h"
+
+struct FFilePath;
+
+/**
+ * 编码器 / 容器 / 立体元数据等参数片段。片段里不含路径和空格参数，用 Append 拆进参数向量。
+ */
+struct FAsymmetricFFmpegArgs
+{
+	/** 把一个参数片段按空白拆开追加到参数向量，空片段什么也不加 */
+	static void Append(TArray<FString>& OutArgs, const FString& Fragment);
+
+	/** 编码器名称（libx264 / libx265） */
+	static FString GetCodecString(EFFmpegVideoCodec InCodec);
+
+	/** 最终输出容器扩展名（H.265 强制 MKV 以支持 stereo_mode 元数据） */
+	static FString GetOutputFormat(EFFmpegVideoCodec InCodec, EFFmpegOutputFormat InFormat);
+
+	/** 像素格式（固定 yuv420p，兼容最广） */
+	static FString GetPixFmt(EFFmpegVideoCodec InCodec);
+
+	/** 视频质量参数（-crf / -preset） */
+	static FString GetQualityArgs(EFFmpegVideoCodec InCodec, int32 InCRF);
+
+	/** 编码器级立体元数据：H.264 Frame Packing SEI 写在码流里，必须在编码时给出，stream copy 时无法补写 */
+	static FString GetStereoEncoderArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout);
+
+	/** 容器级立体元数据：H.265 使用 MKV 的 stereo_mode，写在封装层 */
+	static FString GetStereoContainerArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout);
+
+	/** 单进程编码时编码器级和容器级元数据一起给 */
+	static FString GetStereoMetadataArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout);
+
+	/** 固定 GOP：关键帧间隔固定且不在场景切换处插入关键帧 */
+	static FString GetFixedGopArgs(EFFmpegVideoCodec InCodec, int32 InGopFrames);
+
+	/** -threads 参数（末尾带空格），InThreads <= 0 时返回空串 */
+	static FString GetThreadsArg(int32 InThreads);
+
+	/** 帧率的精确分数形式，例如 23.976 fps 为 "24000/1001" */
+	static FString GetFrameRateString(const FFrameRate& InFrameRate);
+
+	/** 布局简称，用于输出文件命名（SBS / TB） */
+	static const TCHAR* GetLayoutName(EAsymmetricStereoLayout InLayout);
+
+	/**
+	 * 解析 FFmpeg 可执行文件路径。
+	 * 始终转换为绝对路径，处理编辑器 FFilePath 属性可能存储相对路径的情况。
+	 * 路径为空时在系统 PATH 里查找 ffmpeg 并返回它的绝对路径（CreateProc 在 Unix 上不搜索 PATH），找不到返回空串。
+	 */
+	static FString ResolveExecutable(const FFilePath& UserPath);
+
+	/** 按 PATH 环境变量的顺序查找 ffmpeg 可执行文件，返回绝对路径；找不到返回空串 */
+	static FString FindExecutableOnPath();
+};
@@ -0,0 +1,378 @@
+// FFmpeg 进程启动器实现
+
+#include "AsymmetricFFmpegProcess.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_LINUX
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricFFmpegProcess, Log, All);
+
+namespace
+{
+#if PLATFORM_WINDOWS
+	/** CommandLineToArgvW 规则：引号前的反斜杠要加倍，引号本身转义为 \" */
+	FString QuoteArgument(const FString& Arg)
+	{
+		int32 SpecialIndex = INDEX_NONE;
+		if (!Arg.IsEmpty() && !Arg.FindChar(TEXT(' '), SpecialIndex) && !Arg.FindChar(TEXT('\t'), SpecialIndex) && !Arg.FindChar(TEXT('"'), SpecialIndex))
+		{
+			return Arg;
+		}
+
+		FString Quoted(TEXT("\""));
+		int32 NumBackslashes = 0;
+		for (const TCHAR Char : Arg)
+		{
+			if (Char == TEXT('\\'))
+			{
+				++NumBackslashes;
+				continue;
+			}
+			if (Char == TEXT('"'))
+			{
+				Quoted += FString::ChrN(NumBackslashes * 2 + 1, TEXT('\\'));
+			}
+			else
+			{
+				Quoted += FString::ChrN(NumBackslashes, TEXT('\\'));
+			}
+			Quoted.AppendChar(Char);
+			NumBackslashes = 0;
+		}
+		Quoted += FString::ChrN(NumBackslashes * 2, TEXT('\\'));
+		Quoted.AppendChar(TEXT('"'));
+		return Quoted;
+	}
+
+	/** Windows 上任何参数都能按上面的规则原样传过去 */
+	bool CanPassFFmpegArgument(const FString& Arg)
+	{
+		return true;
+	}
+#else
+	/**
+	 * 引擎的 Unix CreateProc 按空格切开命令行，把以双引号开头、以双引号结尾的几段用单个空格拼回一个参数，
+	 * 再去掉两端的引号；不认反斜杠转义。所以只给含空白的参数整体加引号，反斜杠原样保留（Unix 路径里是普通字符）。
+	 */
+	FString QuoteArgument(const FString& Arg)
+	{
+		int32 SpecialIndex = INDEX_NONE;
+		if (!Arg.IsEmpty() && !Arg.FindChar(TEXT(' '), SpecialIndex) && !Arg.FindChar(TEXT('\t'), SpecialIndex))
+		{
+			return Arg;
+		}
+		return TEXT("\"") + Arg + TEXT("\"");
+	}
+
+	/** 含双引号、连续空格或首尾空格的参数经过上面的切分会变样，无法原样传给子进程 */
+	bool CanPassFFmpegArgument(const FString& Arg)
+	{
+		int32 QuoteIndex = INDEX_NONE;
+		return !Arg.FindChar(TEXT('"'), QuoteIndex) && !Arg.Contains(TEXT("  "))
+			&& !Arg.StartsWith(TEXT(" ")) && !Arg.EndsWith(TEXT(" "));
+	}
+#endif
+
+	/** -progress 的行形如 key=value，key 只含小写字母、数字和下划线，不含空格 */
+	bool SplitProgressLine(const FString& Line, FString& OutKey, FString& OutValue)
+	{
+		int32 EqualsIndex = INDEX_NONE;
+		if (!Line.FindChar(TEXT('='), EqualsIndex) || EqualsIndex == 0)
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Line.Len(); ++Index)
+		{
+			const TCHAR Char = Line[Index];
+			if (FChar::IsWhitespace(Char) || (Index < EqualsIndex && !(FChar::IsLower(Char) || FChar::IsDigit(Char) || Char == TEXT('_'))))
+			{
+				return false;
+			}
+		}
+		OutKey = Line.Left(EqualsIndex);
+		OutValue = Line.Mid(EqualsIndex + 1);
+		return true;
+	}
+}
+
+FAsymmetricFFmpegProcess::~FAsymmetricFFmpegProcess()
+{
+	Terminate();
+	ClosePipes();
+}
+
+FString FAsymmetricFFmpegProcess::BuildCommandLine(const TArray<FString>& Args)
+{
+	FString Result;
+	for (const FString& Arg : Args)
+	{
+		if (!Result.IsEmpty())
+		{
+			Result.AppendChar(TEXT(' '));
+		}
+		Result += QuoteArgument(Arg);
+	}
+	return Result;
+}
+
+bool FAsymmetricFFmpegProcess::Launch(const FString& Executable, const TArray<FString>& Args, bool bWithStdin)
+{
+	check(!bLaunched);
+
+	if (Executable.IsEmpty())
+	{
+		UE_LOG(LogAsymmetricFFmpegProcess, Error, TEXT("No FFmpeg executable to launch. Set FFmpegPath or put ffmpeg on the system PATH."));
+		return false;
+	}
+
+	TArray<FString> FullArgs = { TEXT("-hide_banner"), TEXT("-nostats"), TEXT("-progress"), TEXT("pipe:1") };
+	FullArgs.Append(Args);
+	if (const FString* Unsupported = FullArgs.FindByPredicate([](const FString& Arg) { return !CanPassFFmpegArgument(Arg); }))
+	{
+		UE_LOG(LogAsymmetricFFmpegProcess, Error,
+			TEXT("Cannot pass argument '%s' to %s on this platform (double quotes or repeated / leading / trailing spaces)."),
+			**Unsupported, *Executable);
+		return false;
+	}
+
+	// 输出管道：读端留在本进程；stdin 管道：写端留在本进程，否则关闭后 FFmpeg 读不到 EOF
+	if (!FPlatformProcess::CreatePipe(OutputRead, OutputWrite) ||
+		(bWithStdin && !FPlatformProcess::CreatePipe(StdinRead, StdinWrite, /*bWritePipeLocal=*/true)))
+	{
+		UE_LOG(LogAsymmetricFFmpegProcess, Error, TEXT("Failed to create pipes for %s"), *Executable);
+		ClosePipes();
+		return false;
+	}
+
+	CommandLine = BuildCommandLine(FullArgs);
+
+	Process = FPlatformProcess::CreateProc(
+		*Executable, *CommandLine,
+		/*bLaunchDetached=*/false,
+		/*bLaunchHidden=*/true,
+		/*bLaunchReallyHidden=*/true,
+		nullptr, 0, nullptr,
+		/*PipeWriteChild=*/OutputWrite,
+		/*PipeReadChild=*/StdinRead);
+
+	if (!Process.IsValid())
+	{
+		UE_LOG(LogAsymmetricFFmpegProcess, Error, TEXT("Failed to launch: %s %s"), *Executable, *CommandLine);
+		ClosePipes();
+		return false;
+	}
+
+	bLaunched = true;
+	return true;
+}
+
+bool FAsymmetricFFmpegProcess::Poll()
+{
+	if (!bLaunched)
+	{
+		return false;
+	}
+
+	// Linux 上 IsProcRunning 发现进程退出时会顺带回收，之后 /proc 里就没有它了，所以先采样
+	SampleCpuTime();
+
+	// 先判断是否在运行再读：进程退出前写入的数据这一次一定能读到
+	const bool bRunning = FPlatformProcess::IsProcRunning(Process);
+	for (;;)
+	{
+		const FString Chunk = FPlatformProcess::ReadPipe(OutputRead);
+		if (Chunk.IsEmpty())
+		{
+			break;
+		}
+		ConsumeOutput(Chunk);
+	}
+	return bRunning;
+}
+
+bool FAsymmetricFFmpegProcess::TryGetReturnCode(int32& OutReturnCode)
+{
+	OutReturnCode = -1;
+	if (!bLaunched)
+	{
+		return true;
+	}
+	if (Poll())
+	{
+		return false;
+	}
+
+	if (!PendingLine.IsEmpty())
+	{
+		HandleLine(PendingLine);
+		PendingLine.Reset();
+	}
+
+	SampleCpuTime();
+	FPlatformProcess::GetProcReturnCode(Process, &OutReturnCode);
+	FPlatformProcess::CloseProc(Process);
+	ClosePipes();
+	bLaunched = false;
+	return true;
+}
+
+void FAsymmetricFFmpegProcess::Terminate()
+{
+	if (bLaunched)
+	{
+		if (FPlatformProcess::IsProcRunning(Process))
+		{
+			FPlatformProcess::TerminateProc(Process, /*KillTree=*/true);
+		}
+		FPlatformProcess::CloseProc(Process);
+		bLaunched = false;
+	}
+}
+
+void FAsymmetricFFmpegProcess::CloseStdin()
+{
+	if (StdinWrite)
+	{
+		FPlatformProcess::ClosePipe(nullptr, StdinWrite);
+		StdinWrite = nullptr;
+	}
+}
+
+FString FAsymmetricFFmpegProcess::GetLogTail() const
+{
+	FString Result;
+	for (int32 Offset = 0; Offset < LogLines.Num(); ++Offset)
+	{
+		Result += LogLines[(LogHead + Offset) % LogLines.Num()];
+		Result.AppendChar(TEXT('\n'));
+	}
+	return Result;
+}
+
+void FAsymmetricFFmpegProcess::ConsumeOutput(const FString& Chunk)
+{
+	PendingLine += Chunk;
+
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < PendingLine.Len(); ++Index)
+	{
+		const TCHAR Char = PendingLine[Index];
+		if (Char == TEXT('\n') || Char == TEXT('\r'))
+		{
+			if (Index > LineStart)
+			{
+				HandleLine(PendingLine.Mid(LineStart, Index - LineStart));
+			}
+			LineStart = Index + 1;
+		}
+	}
+	PendingLine.RightChopInline(LineStart, EAllowShrinking::No);
+}
+
+void FAsymmetricFFmpegProcess::HandleLine(const FString& Line)
+{
+	FString Key;
+	FString Value;
+	if (SplitProgressLine(Line, Key, Value))
+	{
+		if (Key == TEXT("frame"))
+		{
+			PendingProgress.Frame = FCString::Atoi64(*Value);
+		}
+		else if (Key == TEXT("fps"))
+		{
+			PendingProgress.Fps = FCString::Atof(*Value);
+		}
+		else if (Key == TEXT("bitrate"))
+		{
+			PendingProgress.Bitrate = Value;
+		}
+		else if (Key == TEXT("speed"))
+		{
+			PendingProgress.Speed = Value;
+		}
+		else if (Key == TEXT("total_size"))
+		{
+			PendingProgress.TotalSize = (Value.Len() > 0 && FChar::IsDigit(Value[0])) ? FCString::Atoi64(*Value) : -1;
+		}
+		else if (Key == TEXT("progress"))
+		{
+			// 一组进度以 progress=continue / end 结尾，整组替换，读者不会看到一半新一半旧的值
+			PendingProgress.bValid = true;
+			PendingProgress.bEnded = (Value == TEXT("end"));
+			Progress = PendingProgress;
+		}
+		return;
+	}
+
+	if (LogLines.Num() < MaxLogLines)
+	{
+		LogLines.Add(Line);
+	}
+	else
+	{
+		LogLines[LogHead] = Line;
+		LogHead = (LogHead + 1) % MaxLogLines;
+	}
+}
+
+void FAsymmetricFFmpegProcess::ClosePipes()
+{
+	if (OutputRead || OutputWrite)
+	{
+		FPlatformProcess::ClosePipe(OutputRead, OutputWrite);
+		OutputRead = OutputWrite = nullptr;
+	}
+	if (StdinRead || StdinWrite)
+	{
+		FPlatformProcess::ClosePipe(StdinRead, StdinWrite);
+		StdinRead = StdinWrite = nullptr;
+	}
+}
+
+void FAsymmetricFFmpegProcess::SampleCpuTime()
+{
+	if (!bLaunched)
+	{
+		return;
+	}
+
+#if PLATFORM_WINDOWS
+	FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+	if (::GetProcessTimes(Process.Get(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+	{
+		// FILETIME 单位是 100ns
+		const uint64 Kernel = (uint64(KernelTime.dwHighDateTime) << 32) | KernelTime.dwLowDateTime;
+		const uint64 User = (uint64(UserTime.dwHighDateTime) << 32) | UserTime.dwLowDateTime;
+		CpuSeconds = double(Kernel + User) * 1.0e-7;
+	}
+#elif PLATFORM_LINUX
+	// /proc 文件的大小报告为 0，不能用 FFileHelper 按大小读
+	char Path[64];
+	snprintf(Path, sizeof(Path), "/proc/%d/stat", int(Process.Get()->GetProcessId()));
+	FILE* File = fopen(Path, "r");
+	if (!File)
+	{
+		return;
+	}
+	char Buffer[1024];
+	const size_t Length = fread(Buffer, 1, sizeof(Buffer) - 1, File);
+	fclose(File);
+	Buffer[Length] = '\0';
+
+	// 第 2 列进程名带括号且可能含空格，从最后一个 ')' 之后数：state 是第 3 列，utime / stime 是第 14、15 列
+	const char* Cursor = strrchr(Buffer, ')');
+	unsigned long long UserTicks = 0;
+	unsigned long long SystemTicks = 0;
+	if (Cursor && sscanf(Cursor + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &UserTicks, &SystemTicks) == 2)
+	{
+		CpuSeconds = double(UserTicks + SystemTicks) / double(sysconf(_SC_CLK_TCK));
+	}
+#endif
+}
@@ -0,0 +1,115 @@
+// FFmpeg 进程启动器：参数向量直接启动，管道非阻塞读取日志和 -progress 进度
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+/** FFmpeg -progress 输出的最近一组完整数值 */
+struct FAsymmetricFFmpegProgress
+{
+	int64   Frame = 0;
+	float   Fps = 0.0f;
+	FString Bitrate;      // FFmpeg 原样给出，例如 "12000.5kbits/s"
+	FString Speed;        // 例如 "1.25x"
+	int64   TotalSize = -1;   // 已写出的字节数，图片序列等没有单一输出文件时为 -1
+	bool    bValid = false;
+	bool    bEnded = false;   // 收到 progress=end
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("frame %lld, %.1f fps, %s, %s"), Frame, Fps, *Bitrate, *Speed);
+	}
+};
+
+/**
+ * 一个 FFmpeg 子进程。不经过 cmd.exe / sh，也不写任何脚本或日志文件，Windows 和 Linux 只有命令行引号规则不同。
+ *
+ * - 参数以向量给出，由 BuildCommandLine 逐个加引号拼成命令行
+ * - stdout 和 stderr 合并进一根管道，Poll() 非阻塞读出：
+ *   带 -progress pipe:1 的 key=value 行解析为 FAsymmetricFFmpegProgress，
+ *   其余行进入只保留最后 MaxLogLines 行的环形缓冲，失败时直接取出报告
+ * - 可选 stdin 管道，流式输出用它写 rawvideo
+ *
+ * 管道缓冲有限，运行期间调用方要定期 Poll()，否则 FFmpeg 写满管道后会阻塞。
+ * Poll / 进度 / 日志只在一个线程上使用；stdin 写端可以交给另一个线程。
+ */
+class FAsymmetricFFmpegProcess
+{
+public:
+	static constexpr int32 MaxLogLines = 200;
+
+	FAsymmetricFFmpegProcess() = default;
+	~FAsymmetricFFmpegProcess();
+
+	FAsymmetricFFmpegProcess(const FAsymmetricFFmpegProcess&) = delete;
+	FAsymmetricFFmpegProcess& operator=(const FAsymmetricFFmpegProcess&) = delete;
+
+	/**
+	 * 参数向量拼成命令行，按各平台 CreateProc 的解析方式加引号：
+	 * Windows 按 CommandLineToArgvW 规则转义引号和反斜杠；Unix 只给含空白的参数整体加双引号，不转义。
+	 * Unix 上含双引号、连续空格或首尾空格的参数无法原样传递，Launch 会直接失败。
+	 */
+	static FString BuildCommandLine(const TArray<FString>& Args);
+
+	/**
+	 * 启动进程。自动在参数前加 -hide_banner -nostats -progress pipe:1。
+	 * @param bWithStdin - 为 true 时创建 stdin 管道（参数中输入应为 "-i -"）
+	 */
+	bool Launch(const FString& Executable, const TArray<FString>& Args, bool bWithStdin = false);
+
+	/** 非阻塞地读出管道中已有的输出并解析，返回进程是否仍在运行 */
+	bool Poll();
+
+	/** 进程已退出时读完剩余输出、取退出码并释放句柄，返回 true；仍在运行返回 false */
+	bool TryGetReturnCode(int32& OutReturnCode);
+
+	/** 强制结束（连同子进程）。管道留到析构时关闭，另一个线程可能还在写 stdin */
+	void Terminate();
+
+	bool IsLaunched() const { return bLaunched; }
+
+	/** stdin 写端，仅在 Launch(bWithStdin=true) 时有效 */
+	void* GetStdinPipe() const { return StdinWrite; }
+
+	/** 关闭 stdin 写端，FFmpeg 读到 EOF 后收尾退出 */
+	void CloseStdin();
+
+	const FAsymmetricFFmpegProgress& GetProgress() const { return Progress; }
+
+	/** 环形缓冲里的日志，按时间顺序拼成多行 */
+	FString GetLogTail() const;
+
+	const FString& GetCommandLine() const { return CommandLine; }
+
+	/**
+	 * 进程累计 CPU 时间（用户态 + 内核态，秒）。
+	 * Windows 退出后也能取到准确值；Linux 读 /proc/<pid>/stat，只能在进程被回收前采样，
+	 * 最后一次采样在退出前的最后一次 Poll，少计最多一个轮询间隔。其他平台为 0。
+	 */
+	double GetCpuSeconds() const { return CpuSeconds; }
+
+private:
+	void ConsumeOutput(const FString& Chunk);
+	void HandleLine(const FString& Line);
+	void ClosePipes();
+	void SampleCpuTime();
+
+	FProcHandle Process;
+	bool bLaunched = false;
+	FString CommandLine;
+	double CpuSeconds = 0.0;
+
+	void* OutputRead = nullptr;    // 本进程读 FFmpeg 的 stdout + stderr
+	void* OutputWrite = nullptr;   // 继承给 FFmpeg
+	void* StdinRead = nullptr;     // 继承给 FFmpeg
+	void* StdinWrite = nullptr;    // 本进程写
+
+	FString PendingLine;           // 还没收到换行的半行
+
+	TArray<FString> LogLines;      // 环形缓冲
+	int32 LogHead = 0;             // 满了之后最旧一行的位置
+
+	FAsymmetricFFmpegProgress Progress;         // 最近一组完整进度
+	FAsymmetricFFmpegProgress PendingProgress;  // 正在接收的一组
+};
@@ -0,0 +1,206 @@
+// 长驻 FFmpeg 管道写入实现
+
+#include "AsymmetricFFmpegStream.h"
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricFFmpegStream, Log, All);
+
+namespace
+{
+	// WritePipe 的长度参数是 int32，大帧分块写
+	constexpr int64 MaxPipeWriteChunk = 16 * 1024 * 1024;
+}
+
+FAsymmetricFFmpegStream::FAsymmetricFFmpegStream(const FString& InName, int32 InMaxQueuedFrames)
+	: Name(InName)
+	, MaxQueuedFrames(FMath::Max(1, InMaxQueuedFrames))
+{
+	FrameQueued = FPlatformProcess::GetSynchEventFromPool(false);
+	FrameDequeued = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FAsymmetricFFmpegStream::~FAsymmetricFFmpegStream()
+{
+	Abort();
+	FPlatformProcess::ReturnSynchEventToPool(FrameQueued);
+	FPlatformProcess::ReturnSynchEventToPool(FrameDequeued);
+}
+
+bool FAsymmetricFFmpegStream::Start(const FString& Executable, const TArray<FString>& Arguments)
+{
+	if (!Process.Launch(Executable, Arguments, /*bWithStdin=*/true))
+	{
+		UE_LOG(LogAsymmetricFFmpegStream, Error, TEXT("[%s] Failed to launch: %s %s"), *Name, *Executable,
+			*FAsymmetricFFmpegProcess::BuildCommandLine(Arguments));
+		return false;
+	}
+	StdinWrite = Process.GetStdinPipe();
+
+	UE_LOG(LogAsymmetricFFmpegStream, Log, TEXT("[%s] Streaming to FFmpeg:\n  %s %s"), *Name, *Executable, *Process.GetCommandLine());
+
+	Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("AsymmetricFFmpegStream_%s"), *Name), 0, TPri_Normal);
+	return Thread != nullptr;
+}
+
+bool FAsymmetricFFmpegStream::WriteFrame(TArray64<uint8>&& Frame)
+{
+	const double WaitStart = FPlatformTime::Seconds();
+	bool bWaited = false;
+
+	// 顺带读空输出管道，否则 FFmpeg 写满管道后会卡住不再读 stdin
+	Process.Poll();
+
+	for (;;)
+	{
+		if (bBroken.load(std::memory_order_acquire) || bClosing.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() < MaxQueuedFrames)
+			{
+				Queue.Add(MoveTemp(Frame));
+				break;
+			}
+		}
+
+		// 队列满：编码器跟不上，阻塞渲染。带超时重查，FFmpeg 中途退出时不会一直等
+		bWaited = true;
+		FrameDequeued->Wait(100);
+		if (!Process.Poll())
+		{
+			bBroken = true;
+		}
+	}
+
+	if (bWaited)
+	{
+		BlockedSeconds += FPlatformTime::Seconds() - WaitStart;
+	}
+	FrameQueued->Trigger();
+	return true;
+}
+
+uint32 FAsymmetricFFmpegStream::Run()
+{
+	for (;;)
+	{
+		TArray64<uint8> Frame;
+		bool bHaveFrame = false;
+		{
+			FScopeLock Lock(&QueueLock);
+			if (Queue.Num() > 0)
+			{
+				Frame = MoveTemp(Queue[0]);
+				Queue.RemoveAt(0, 1, EAllowShrinking::No);
+				bHaveFrame = true;
+			}
+			else if (bClosing.load(std::memory_order_acquire))
+			{
+				break;
+			}
+		}
+
+		if (!bHaveFrame)
+		{
+			FrameQueued->Wait(100);
+			continue;
+		}
+		FrameDequeued->Trigger();
+
+		// 管道断开后继续取队列（丢弃），保证 WriteFrame 不会永远等下去
+		if (!bBroken.load(std::memory_order_relaxed))
+		{
+			if (WriteAll(Frame.GetData(), Frame.Num()))
+			{
+				FramesWritten.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				UE_LOG(LogAsymmetricFFmpegStream, Error, TEXT("[%s] FFmpeg stopped accepting frames after %lld frame(s)."),
+					*Name, GetFramesWritten());
+				bBroken = true;
+			}
+		}
+	}
+
+	// 关闭写端，FFmpeg 读到 EOF 后写完文件尾并退出
+	Process.CloseStdin();
+	StdinWrite = nullptr;
+	return 0;
+}
+
+bool FAsymmetricFFmpegStream::WriteAll(const uint8* Data, int64 Size)
+{
+	int64 Offset = 0;
+	while (Offset < Size)
+	{
+		const int32 Chunk = int32(FMath::Min(Size - Offset, MaxPipeWriteChunk));
+		int32 Written = 0;
+		if (!FPlatformProcess::WritePipe(StdinWrite, Data + Offset, Chunk, &Written) || Written <= 0)
+		{
+			return false;
+		}
+		Offset += Written;
+	}
+	return true;
+}
+
+void FAsymmetricFFmpegStream::Close()
+{
+	bClosing = true;
+	FrameQueued->Trigger();
+}
+
+bool FAsymmetricFFmpegStream::PollFinished(int32& OutReturnCode)
+{
+	OutReturnCode = -1;
+	if (!Process.IsLaunched())
+	{
+		return true;
+	}
+	if (Process.Poll())
+	{
+		return false;
+	}
+
+	// 进程已退出：写线程要么已写完，要么写管道失败后正在丢弃剩余帧，很快就会结束
+	bClosing = true;
+	FrameQueued->Trigger();
+	JoinWriter();
+
+	return Process.TryGetReturnCode(OutReturnCode);
+}
+
+void FAsymmetricFFmpegStream::Abort()
+{
+	if (Process.Poll())
+	{
+		UE_LOG(LogAsymmetricFFmpegStream, Warning, TEXT("[%s] Terminating FFmpeg."), *Name);
+	}
+
+	// 先结束进程，写线程阻塞中的 WritePipe 随之失败返回
+	Process.Terminate();
+	bBroken = true;
+	bClosing = true;
+	FrameQueued->Trigger();
+	JoinWriter();
+}
+
+void FAsymmetricFFmpegStream::JoinWriter()
+{
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	// 写线程没启动起来时写端还开着
+	Process.CloseStdin();
+	StdinWrite = nullptr;
+}
@@ -0,0 +1,81 @@
+// 长驻 FFmpeg 进程：通过 stdin 管道逐帧写入 rawvideo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricFFmpegProcess.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * 一个 Shot 一个实例。调用方（游戏线程）WriteFrame 把打包好的帧放进有界队列，
+ * 写线程取出后阻塞写入 FFmpeg stdin。
+ *
+ * 背压：队列满时 WriteFrame 阻塞，直到编码器消化掉一帧，渲染随之放慢，内存占用不超过
+ * MaxQueuedFrames 帧。FFmpeg 异常退出时写线程丢弃剩余帧，WriteFrame 返回 false，不会卡死渲染。
+ *
+ * FFmpeg 的输出管道在调用方线程上读：WriteFrame / PollFinished 每次顺带 Poll 一次，
+ * 失败时用 GetLogTail 报告原因。
+ */
+class FAsymmetricFFmpegStream : public FRunnable
+{
+public:
+	FAsymmetricFFmpegStream(const FString& InName, int32 InMaxQueuedFrames);
+	virtual ~FAsymmetricFFmpegStream() override;
+
+	/** 启动 FFmpeg（参数中输入应为 "-i -"）和写线程 */
+	bool Start(const FString& Executable, const TArray<FString>& Arguments);
+
+	/** 提交一帧，队列满时阻塞；FFmpeg 已不再接收数据时返回 false */
+	bool WriteFrame(TArray64<uint8>&& Frame);
+
+	/** 不再提交新帧：写线程写完队列后关闭 stdin，FFmpeg 读到 EOF 后收尾退出。不阻塞 */
+	void Close();
+
+	/** Close 之后轮询；进程已退出时返回 true 并给出退出码 */
+	bool PollFinished(int32& OutReturnCode);
+
+	/** 强制终止进程并结束写线程 */
+	void Abort();
+
+	const FString& GetName() const { return Name; }
+
+	/** FFmpeg 输出的最后若干行，只在调用方线程使用 */
+	FString GetLogTail() const { return Process.GetLogTail(); }
+	const FAsymmetricFFmpegProgress& GetProgress() const { return Process.GetProgress(); }
+	int64 GetFramesWritten() const { return FramesWritten.load(std::memory_order_relaxed); }
+
+	/** WriteFrame 因队列满累计阻塞的时间（秒），即编码器拖慢渲染的时间 */
+	double GetBlockedSeconds() const { return BlockedSeconds; }
+
+	// FRunnable 接口
+	virtual uint32 Run() override;
+	virtual void Stop() override { Close(); }
+
+private:
+	/** 完整写入一块数据，管道断开时返回 false */
+	bool WriteAll(const uint8* Data, int64 Size);
+
+	/** 等写线程结束并释放线程和管道 */
+	void JoinWriter();
+
+	FString Name;
+	int32 MaxQueuedFrames = 2;
+
+	FAsymmetricFFmpegProcess Process;
+	void* StdinWrite = nullptr;    // Process 的 stdin 写端，只由写线程使用
+	FRunnableThread* Thread = nullptr;
+
+	FCriticalSection QueueLock;
+	TArray<TArray64<uint8>> Queue;
+	FEvent* FrameQueued = nullptr;
+	FEvent* FrameDequeued = nullptr;
+
+	std::atomic<bool> bClosing{ false };
+	std::atomic<bool> bBroken{ false };
+	std::atomic<int64> FramesWritten{ 0 };
+	double BlockedSeconds = 0.0;   // 只在调用 WriteFrame 的线程上累加
+};
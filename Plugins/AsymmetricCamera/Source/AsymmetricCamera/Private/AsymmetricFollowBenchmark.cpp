@@ -0,0 +1,157 @@
+// 跟随目标相机的基准：控制台命令 AsymmetricCamera.BenchmarkFollow，对比 Move Owner 和 Virtual Parent 的游戏线程开销
+
+#include "AsymmetricCameraActor.h"
+#include "AsymmetricCameraComponent.h"
+#include "AsymmetricScreenComponent.h"
+#include "Camera/CameraActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricFollowBenchmark, Log, All);
+
+namespace
+{
+	/** 第 Frame 帧目标相机的位姿：绕原点平移加转动，每帧都不同 */
+	FTransform GetFollowBenchmarkTargetPose(int32 Frame)
+	{
+		const double T = Frame * 0.05;
+		return FTransform(
+			FRotator(10.0 * FMath::Sin(T), 30.0 * T, 0.0),
+			FVector(500.0 * FMath::Cos(T), 500.0 * FMath::Sin(T), 150.0 + 50.0 * FMath::Sin(T * 2.0)));
+	}
+
+	/** 生成 NumRigs 个典型的屏幕 Rig：相机 Actor 自带屏幕和相机组件，再挂一块有碰撞的屏幕面板网格 */
+	void SpawnFollowBenchmarkRigs(UWorld* World, AActor* Target, int32 NumRigs, TArray<AAsymmetricCameraActor*>& OutRigs)
+	{
+		UStaticMesh* PanelMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Plane.Plane"));
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		OutRigs.Reset(NumRigs);
+		for (int32 Index = 0; Index < NumRigs; ++Index)
+		{
+			const FVector Location(200.0 * (Index % 25), 200.0 * (Index / 25), 0.0);
+			AAsymmetricCameraActor* Rig = World->SpawnActor<AAsymmetricCameraActor>(Location, FRotator::ZeroRotator, SpawnParams);
+			if (!Rig)
+			{
+				continue;
+			}
+
+			if (PanelMesh)
+			{
+				UStaticMeshComponent* Panel = NewObject<UStaticMeshComponent>(Rig);
+				Panel->SetStaticMesh(PanelMesh);
+				Panel->SetGenerateOverlapEvents(true);
+				Panel->SetupAttachment(Rig->ScreenComponent);
+				Panel->SetRelativeRotation(FRotator(0.0, 0.0, 90.0));
+				Panel->RegisterComponent();
+			}
+
+			// 组件自己的 Tick / 子系统发布不参与计时：基准在同一个调用里同步驱动每一帧
+			UAsymmetricCameraComponent* Camera = Rig->AsymmetricCamera;
+			Camera->SetTargetCamera(Target);
+			Camera->SetFollowTargetCamera(true);
+			Camera->SetComponentTickEnabled(false);
+			OutRigs.Add(Rig);
+		}
+	}
+
+	/**
+	 * 跑 NumFrames 帧，返回每个 Rig 每帧的平均微秒数。
+	 * 每帧：移动目标相机 → 每个 Rig 做跟随并发布投影状态 → 刷新本帧的渲染 Transform 更新（两种方式都计入）。
+	 */
+	double MeasureFollowMode(UWorld* World, AActor* Target, const TArray<AAsymmetricCameraActor*>& Rigs,
+		EAsymmetricFollowMode Mode, int32 NumFrames, FVector& OutLastEye)
+	{
+		for (AAsymmetricCameraActor* Rig : Rigs)
+		{
+			Rig->AsymmetricCamera->SetFollowMode(Mode);
+			Rig->AsymmetricCamera->SetComponentTickEnabled(false);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			const FTransform Pose = GetFollowBenchmarkTargetPose(Frame);
+			Target->SetActorLocationAndRotation(Pose.GetLocation(), Pose.GetRotation());
+
+			for (AAsymmetricCameraActor* Rig : Rigs)
+			{
+				if (Mode == EAsymmetricFollowMode::MoveOwner)
+				{
+					// 和 TickComponent 里的跟随一致
+					Rig->SetActorLocationAndRotation(Target->GetActorLocation(), Target->GetActorRotation());
+				}
+				Rig->AsymmetricCamera->PublishProjectionState();
+			}
+
+			World->SendAllEndOfFrameUpdates();
+		}
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		OutLastEye = Rigs.Num() > 0 ? Rigs.Last()->AsymmetricCamera->GetEyePosition() : FVector::ZeroVector;
+		return Elapsed * 1e6 / (static_cast<double>(NumFrames) * FMath::Max(Rigs.Num(), 1));
+	}
+
+	void RunFollowBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld() || !World->HasBegunPlay())
+		{
+			UE_LOG(LogAsymmetricFollowBenchmark, Warning, TEXT("AsymmetricCamera.BenchmarkFollow must run in a game or PIE world."));
+			return;
+		}
+
+		const int32 MaxRigs = (Args.Num() > 0) ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 500) : 500;
+		const int32 NumFrames = (Args.Num() > 1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 120;
+		static const int32 RigCounts[] = { 1, 10, 50, 100, 250, 500 };
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		ACameraActor* Target = World->SpawnActor<ACameraActor>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		if (!Target)
+		{
+			return;
+		}
+
+		UE_LOG(LogAsymmetricFollowBenchmark, Display, TEXT("Follow target camera benchmark (%d frames per case, game thread):"), NumFrames);
+		UE_LOG(LogAsymmetricFollowBenchmark, Display, TEXT("  %6s  %20s  %20s  %8s  %14s"),
+			TEXT("Rigs"), TEXT("Move Owner (us/rig)"), TEXT("Virtual Parent (us/rig)"), TEXT("Speedup"), TEXT("Eye error (cm)"));
+
+		for (const int32 NumRigs : RigCounts)
+		{
+			if (NumRigs > MaxRigs)
+			{
+				break;
+			}
+
+			TArray<AAsymmetricCameraActor*> Rigs;
+			SpawnFollowBenchmarkRigs(World, Target, NumRigs, Rigs);
+
+			// 先跑 Virtual Parent（Rig 留在原位），再跑 Move Owner；两次最后一帧的目标位姿相同，眼睛位置应一致
+			FVector VirtualEye, MovedEye;
+			const double VirtualCost = MeasureFollowMode(World, Target, Rigs, EAsymmetricFollowMode::VirtualParent, NumFrames, VirtualEye);
+			const double MoveCost = MeasureFollowMode(World, Target, Rigs, EAsymmetricFollowMode::MoveOwner, NumFrames, MovedEye);
+
+			UE_LOG(LogAsymmetricFollowBenchmark, Display, TEXT("  %6d  %20.2f  %20.2f  %7.2fx  %14.2e"),
+				Rigs.Num(), MoveCost, VirtualCost, MoveCost / FMath::Max(VirtualCost, 1e-6), FVector::Dist(VirtualEye, MovedEye));
+
+			for (AAsymmetricCameraActor* Rig : Rigs)
+			{
+				Rig->Destroy();
+			}
+		}
+
+		Target->Destroy();
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs GBenchmarkFollowCommand(
+		TEXT("AsymmetricCamera.BenchmarkFollow"),
+		TEXT("Compare the game-thread cost per rig of following a target camera by moving the owner actor versus the virtual-parent mode, ")
+		TEXT("at 1 to 500 rigs. Optional arguments: max rigs (default 500), frames per case (default 120). Run in a game or PIE world."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunFollowBenchmark));
+}
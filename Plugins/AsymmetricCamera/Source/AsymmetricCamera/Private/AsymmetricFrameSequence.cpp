@@ -0,0 +1,142 @@
+// 紧凑帧序列实现
+
+#include "AsymmetricFrameSequence.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/Paths.h"
+
+void FAsymmetricFrameRanges::Add(int32 Frame)
+{
+	// 常见情况：MRQ 按帧序输出，直接延长或追加最后一个区间
+	if (Ranges.Num() == 0 || Frame > Ranges.Last().Last + 1)
+	{
+		Ranges.Add({ Frame, Frame });
+		++NumFrames;
+		return;
+	}
+	if (Frame == Ranges.Last().Last + 1)
+	{
+		++Ranges.Last().Last;
+		++NumFrames;
+		return;
+	}
+
+	// 乱序：找第一个 Last >= Frame - 1 的区间，可能包含、紧邻或需要在其前面插入
+	const int32 Index = Algo::LowerBoundBy(Ranges, Frame - 1, &FAsymmetricFrameRange::Last);
+	FAsymmetricFrameRange& Range = Ranges[Index];
+	if (Frame >= Range.First && Frame <= Range.Last)
+	{
+		return; // 重复帧
+	}
+
+	++NumFrames;
+	if (Frame == Range.First - 1)
+	{
+		Range.First = Frame;
+	}
+	else if (Frame == Range.Last + 1)
+	{
+		Range.Last = Frame;
+		// 补上空隙后和后一个区间连起来
+		if (Ranges.IsValidIndex(Index + 1) && Ranges[Index + 1].First == Frame + 1)
+		{
+			Range.Last = Ranges[Index + 1].Last;
+			Ranges.RemoveAt(Index + 1, 1, EAllowShrinking::No);
+		}
+	}
+	else
+	{
+		Ranges.Insert({ Frame, Frame }, Index);
+	}
+}
+
+bool FAsymmetricFrameRanges::Contains(int32 Frame) const
+{
+	const int32 Index = Algo::LowerBoundBy(Ranges, Frame, &FAsymmetricFrameRange::Last);
+	return Ranges.IsValidIndex(Index) && Ranges[Index].First <= Frame;
+}
+
+FAsymmetricFrameRanges FAsymmetricFrameRanges::Intersect(const FAsymmetricFrameRanges& A, const FAsymmetricFrameRanges& B)
+{
+	FAsymmetricFrameRanges Result;
+	int32 IndexA = 0;
+	int32 IndexB = 0;
+	while (IndexA < A.Ranges.Num() && IndexB < B.Ranges.Num())
+	{
+		const FAsymmetricFrameRange& RangeA = A.Ranges[IndexA];
+		const FAsymmetricFrameRange& RangeB = B.Ranges[IndexB];
+		const int32 First = FMath::Max(RangeA.First, RangeB.First);
+		const int32 Last = FMath::Min(RangeA.Last, RangeB.Last);
+		if (First <= Last)
+		{
+			Result.Ranges.Add({ First, Last });
+			Result.NumFrames += Last - First + 1;
+		}
+		// 先结束的区间不会再和后面的区间相交
+		if (RangeA.Last < RangeB.Last)
+		{
+			++IndexA;
+		}
+		else
+		{
+			++IndexB;
+		}
+	}
+	return Result;
+}
+
+bool FAsymmetricFrameSequence::AddFile(const FString& InFilePath)
+{
+	const FString FileName = FPaths::GetCleanFilename(InFilePath);
+
+	// 帧号取扩展名之前最后一段数字，例如 "Seq.LeftEye.0015.png" → "0015"
+	int32 DotIndex = INDEX_NONE;
+	const int32 SearchEnd = FileName.FindLastChar(TEXT('.'), DotIndex) ? DotIndex : FileName.Len();
+	int32 DigitsEnd = SearchEnd;
+	while (DigitsEnd > 0 && !FChar::IsDigit(FileName[DigitsEnd - 1]))
+	{
+		--DigitsEnd;
+	}
+	int32 DigitsStart = DigitsEnd;
+	while (DigitsStart > 0 && FChar::IsDigit(FileName[DigitsStart - 1]))
+	{
+		--DigitsStart;
+	}
+	if (DigitsStart == DigitsEnd)
+	{
+		return false;
+	}
+
+	const FString FileDirectory = FPaths::GetPath(InFilePath);
+	const FString FilePrefix = FileName.Left(DigitsStart);
+	const FString FileSuffix = FileName.Mid(DigitsEnd);
+	const int32 Frame = FCString::Atoi(*FileName.Mid(DigitsStart, DigitsEnd - DigitsStart));
+
+	if (Frames.IsEmpty())
+	{
+		Directory = FileDirectory;
+		Prefix = FilePrefix;
+		Suffix = FileSuffix;
+	}
+	else if (FileDirectory != Directory || FilePrefix != Prefix || FileSuffix != Suffix)
+	{
+		return false;
+	}
+
+	if (Frame < MinFrameSeen)
+	{
+		MinFrameSeen = Frame;
+		PadWidth = DigitsEnd - DigitsStart;
+	}
+	Frames.Add(Frame);
+	return true;
+}
+
+FString FAsymmetricFrameSequence::GetFramePath(int32 Frame) const
+{
+	FString Digits = FString::FromInt(Frame);
+	if (Digits.Len() < PadWidth)
+	{
+		Digits = FString::ChrN(PadWidth - Digits.Len(), TEXT('0')) + Digits;
+	}
+	return FPaths::Combine(Directory, Prefix + Digits + Suffix);
+}
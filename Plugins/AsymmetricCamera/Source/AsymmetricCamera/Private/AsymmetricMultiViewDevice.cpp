@@ -0,0 +1,100 @@
+// 多屏模式立体渲染设备实现
+
+#include "AsymmetricMultiViewDevice.h"
+#include "Engine/Engine.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricMultiView, Log, All);
+
+void FAsymmetricMultiViewDevice::SetViews(TArray<FViewData>&& InViews)
+{
+	check(IsInGameThread());
+	Views = MoveTemp(InViews);
+}
+
+bool FAsymmetricMultiViewDevice::Install()
+{
+	if (!GEngine)
+	{
+		return false;
+	}
+
+	if (GEngine->StereoRenderingDevice.IsValid() && GEngine->StereoRenderingDevice.Get() != this)
+	{
+		UE_LOG(LogAsymmetricMultiView, Warning,
+			TEXT("Another stereo rendering device (XR/HMD) is active, multi-screen mode disabled."));
+		return false;
+	}
+
+	GEngine->StereoRenderingDevice = AsShared();
+	EnableStereo(true);
+	bInstalled = true;
+	return true;
+}
+
+void FAsymmetricMultiViewDevice::Uninstall()
+{
+	if (bInstalled && GEngine && GEngine->StereoRenderingDevice.Get() == this)
+	{
+		EnableStereo(false);
+		GEngine->StereoRenderingDevice.Reset();
+	}
+	bInstalled = false;
+}
+
+bool FAsymmetricMultiViewDevice::EnableStereo(bool bStereo)
+{
+	bStereoEnabled = bStereo;
+	return bStereoEnabled;
+}
+
+int32 FAsymmetricMultiViewDevice::GetDesiredNumberOfViews(bool bStereoRequested) const
+{
+	return (bStereoRequested && Views.Num() > 0) ? Views.Num() : 1;
+}
+
+EStereoscopicPass FAsymmetricMultiViewDevice::GetViewPassForIndex(bool bStereoRequested, int32 ViewIndex) const
+{
+	// 每块屏幕都是独立的单目 View，渲染器按普通多 View 处理
+	return EStereoscopicPass::eSSP_FULL;
+}
+
+void FAsymmetricMultiViewDevice::AdjustViewRect(const int32 ViewIndex, int32& X, int32& Y, uint32& SizeX, uint32& SizeY) const
+{
+	if (!Views.IsValidIndex(ViewIndex))
+	{
+		return;
+	}
+
+	// 入参是完整视口，按归一化矩形切出这个 View 的区域
+	const FBox2D& Rect = Views[ViewIndex].NormalizedRect;
+	const int32 FullX = X;
+	const int32 FullY = Y;
+	const double FullW = static_cast<double>(SizeX);
+	const double FullH = static_cast<double>(SizeY);
+
+	const int32 MinX = FMath::RoundToInt(Rect.Min.X * FullW);
+	const int32 MinY = FMath::RoundToInt(Rect.Min.Y * FullH);
+	const int32 MaxX = FMath::RoundToInt(Rect.Max.X * FullW);
+	const int32 MaxY = FMath::RoundToInt(Rect.Max.Y * FullH);
+
+	X = FullX + MinX;
+	Y = FullY + MinY;
+	SizeX = static_cast<uint32>(FMath::Max(MaxX - MinX, 1));
+	SizeY = static_cast<uint32>(FMath::Max(MaxY - MinY, 1));
+}
+
+void FAsymmetricMultiViewDevice::CalculateStereoViewOffset(const int32 ViewIndex, FRotator& ViewRotation, const float WorldToMeters, FVector& ViewLocation)
+{
+	if (!Views.IsValidIndex(ViewIndex))
+	{
+		return;
+	}
+
+	ViewLocation = Views[ViewIndex].ViewLocation;
+	ViewRotation = Views[ViewIndex].ViewRotation;
+}
+
+FMatrix FAsymmetricMultiViewDevice::GetStereoProjectionMatrix(const int32 ViewIndex) const
+{
+	return Views.IsValidIndex(ViewIndex) ? Views[ViewIndex].ProjectionMatrix : FMatrix::Identity;
+}
@@ -0,0 +1,53 @@
+// 多屏模式的立体渲染设备：让一个 ViewFamily 渲染 N 个屏幕 View
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StereoRendering.h"
+
+/**
+ * 多屏 CAVE 用的渲染设备。
+ * 引擎在 GEngine->StereoRenderingDevice 有效且启用时，会按 GetDesiredNumberOfViews 在同一个
+ * ViewFamily 里创建多个 View，每个 View 通过 AdjustViewRect / CalculateStereoViewOffset /
+ * GetStereoProjectionMatrix 取自己的输出矩形、眼睛位置和投影。nDisplay 也是走的这条路。
+ *
+ * 每个 View 都是独立的单目 View（eSSP_FULL），不走 Instanced Stereo。
+ * 所有接口只在游戏线程调用，数据由 UAsymmetricCameraComponent 每帧推送。
+ */
+class FAsymmetricMultiViewDevice : public IStereoRendering, public TSharedFromThis<FAsymmetricMultiViewDevice, ESPMode::ThreadSafe>
+{
+public:
+	/** 单个屏幕 View 的数据 */
+	struct FViewData
+	{
+		FVector  ViewLocation = FVector::ZeroVector;
+		FRotator ViewRotation = FRotator::ZeroRotator;
+		FMatrix  ProjectionMatrix = FMatrix::Identity;
+		FBox2D   NormalizedRect = FBox2D(FVector2D(0.0, 0.0), FVector2D(1.0, 1.0)); // 归一化输出矩形，AdjustViewRect 按实际视口换算
+	};
+
+	/** 组件每帧推送最新的 View 列表 */
+	void SetViews(TArray<FViewData>&& InViews);
+
+	/** 安装到 GEngine；已有其他设备（XR/HMD）时返回 false */
+	bool Install();
+
+	/** 从 GEngine 卸载（只在当前设备是自己时） */
+	void Uninstall();
+
+	// IStereoRendering 接口
+	virtual bool IsStereoEnabled() const override { return bStereoEnabled; }
+	virtual bool EnableStereo(bool bStereo = true) override;
+	virtual int32 GetDesiredNumberOfViews(bool bStereoRequested) const override;
+	virtual EStereoscopicPass GetViewPassForIndex(bool bStereoRequested, int32 ViewIndex) const override;
+	virtual void AdjustViewRect(const int32 ViewIndex, int32& X, int32& Y, uint32& SizeX, uint32& SizeY) const override;
+	virtual void CalculateStereoViewOffset(const int32 ViewIndex, FRotator& ViewRotation, const float WorldToMeters, FVector& ViewLocation) override;
+	virtual FMatrix GetStereoProjectionMatrix(const int32 ViewIndex) const override;
+	virtual void InitCanvasFromView(FSceneView* InView, UCanvas* Canvas) override {}
+
+private:
+	TArray<FViewData> Views;
+
+	bool bStereoEnabled = false;
+	bool bInstalled = false;
+};
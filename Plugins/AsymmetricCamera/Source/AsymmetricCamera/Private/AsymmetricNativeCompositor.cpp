@@ -0,0 +1,154 @@
+// 原生立体图片序列合成实现
+
+#include "AsymmetricNativeCompositor.h"
+#include "AsymmetricStereoPacker.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricNativeCompositor, Log, All);
+
+FAsymmetricNativeCompositor::FResult FAsymmetricNativeCompositor::Run(const FRequest& Request, IImageWrapperModule& ImageWrapperModule)
+{
+	FResult Result;
+	Result.NumFrames = FMath::Min(Request.LeftPaths.Num(), Request.RightPaths.Num());
+	for (const FOutput& Output : Request.Outputs)
+	{
+		Result.NumFrames = FMath::Min(Result.NumFrames, Output.Paths.Num());
+	}
+	if (Request.Outputs.Num() == 0)
+	{
+		Result.NumFrames = 0;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	std::atomic<int32> NumFailed{ 0 };
+
+	// 后台优先级：渲染期间提前合成时不和渲染线程抢任务图
+	ParallelFor(Result.NumFrames, [&](int32 FrameIndex)
+	{
+		if (Request.CancelFlag.IsValid() && *Request.CancelFlag)
+		{
+			NumFailed.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		if (!CompositeFrame(ImageWrapperModule, Request, FrameIndex))
+		{
+			NumFailed.fetch_add(1, std::memory_order_relaxed);
+		}
+	}, EParallelForFlags::BackgroundPriority | EParallelForFlags::Unbalanced);
+
+	Result.NumFailed = NumFailed.load();
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	return Result;
+}
+
+void FAsymmetricNativeCompositor::LaunchAsync(FRequest&& Request, TFunction<void(const FResult&)>&& OnCompleted)
+{
+	check(IsInGameThread());
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	Async(EAsyncExecution::ThreadPool,
+		[Request = MoveTemp(Request), OnCompleted = MoveTemp(OnCompleted), ImageWrapperModule]() mutable
+		{
+			const FResult Result = Run(Request, *ImageWrapperModule);
+			AsyncTask(ENamedThreads::GameThread, [Result, OnCompleted = MoveTemp(OnCompleted)]()
+			{
+				OnCompleted(Result);
+			});
+		});
+}
+
+bool FAsymmetricNativeCompositor::CompositeFrame(IImageWrapperModule& ImageWrapperModule, const FRequest& Request, int32 FrameIndex)
+{
+	const FString& LeftPath = Request.LeftPaths[FrameIndex];
+	const FString& RightPath = Request.RightPaths[FrameIndex];
+
+	TArray64<uint8> LeftFile;
+	TArray64<uint8> RightFile;
+	if (!FFileHelper::LoadFileToArray(LeftFile, *LeftPath) || !FFileHelper::LoadFileToArray(RightFile, *RightPath))
+	{
+		UE_LOG(LogAsymmetricNativeCompositor, Error, TEXT("Failed to read eye pair: %s / %s"), *LeftPath, *RightPath);
+		return false;
+	}
+
+	FImage LeftImage;
+	FImage RightImage;
+	if (!ImageWrapperModule.DecompressImage(LeftFile.GetData(), LeftFile.Num(), LeftImage) ||
+		!ImageWrapperModule.DecompressImage(RightFile.GetData(), RightFile.Num(), RightImage))
+	{
+		UE_LOG(LogAsymmetricNativeCompositor, Error, TEXT("Failed to decode eye pair: %s / %s"), *LeftPath, *RightPath);
+		return false;
+	}
+
+	// 压缩数据解码后就不用了，先释放，降低并行时的峰值内存
+	LeftFile.Empty();
+	RightFile.Empty();
+
+	if (LeftImage.SizeX != RightImage.SizeX || LeftImage.SizeY != RightImage.SizeY || LeftImage.Format != RightImage.Format)
+	{
+		UE_LOG(LogAsymmetricNativeCompositor, Error, TEXT("Eye images differ in size or format: %s / %s"), *LeftPath, *RightPath);
+		return false;
+	}
+
+	const FIntPoint EyeSize(LeftImage.SizeX, LeftImage.SizeY);
+
+	// 每种布局最多打包一次，多个输出共用（例如全分辨率 SBS 和缩小的 SBS 小样）
+	FImage PackedByLayout[2];
+	auto GetPacked = [&](EAsymmetricStereoLayout Layout) -> const FImage&
+	{
+		FImage& Packed = PackedByLayout[Layout == EAsymmetricStereoLayout::TopBottom ? 1 : 0];
+		if (Packed.RawData.Num() == 0)
+		{
+			// 输出图像一次分配到最终尺寸，两眼直接拷进去
+			const FIntPoint PackedSize = FAsymmetricStereoPacker::GetPackedSize(EyeSize, Layout);
+			Packed.Init(PackedSize.X, PackedSize.Y, LeftImage.Format, LeftImage.GammaSpace);
+			FAsymmetricStereoPacker::Pack(LeftImage.RawData.GetData(), RightImage.RawData.GetData(), EyeSize,
+				int32(LeftImage.GetBytesPerPixel()), Layout, Packed.RawData.GetData());
+		}
+		return Packed;
+	};
+
+	bool bAllSaved = true;
+	for (const FOutput& Output : Request.Outputs)
+	{
+		const FImage& Packed = GetPacked(Output.Layout);
+		if (Output.Scale >= 1.0f - UE_KINDA_SMALL_NUMBER)
+		{
+			bAllSaved &= SaveImage(ImageWrapperModule, Packed, Output.Paths[FrameIndex], Request.Quality);
+			continue;
+		}
+
+		// 缩小版本：尺寸取偶数，和 FFmpeg 路径的 scale 滤镜一致
+		const int32 ScaledX = FMath::Max(2, FMath::FloorToInt(Packed.SizeX * Output.Scale * 0.5f) * 2);
+		const int32 ScaledY = FMath::Max(2, FMath::FloorToInt(Packed.SizeY * Output.Scale * 0.5f) * 2);
+		FImage Scaled(ScaledX, ScaledY, Packed.Format, Packed.GammaSpace);
+		FImageCore::ResizeImage(Packed, Scaled);
+		bAllSaved &= SaveImage(ImageWrapperModule, Scaled, Output.Paths[FrameIndex], Request.Quality);
+	}
+	return bAllSaved;
+}
+
+bool FAsymmetricNativeCompositor::SaveImage(IImageWrapperModule& ImageWrapperModule, const FImageView& Image, const FString& OutputPath, int32 Quality)
+{
+	const EImageFormat OutputFormat = ImageWrapperModule.GetImageFormatFromExtension(*FPaths::GetExtension(OutputPath));
+	TArray64<uint8> Compressed;
+	if (OutputFormat == EImageFormat::Invalid || !ImageWrapperModule.CompressImage(Compressed, OutputFormat, Image, Quality))
+	{
+		UE_LOG(LogAsymmetricNativeCompositor, Error, TEXT("Failed to encode %s"), *OutputPath);
+		return false;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Compressed, *OutputPath))
+	{
+		UE_LOG(LogAsymmetricNativeCompositor, Error, TEXT("Failed to write %s"), *OutputPath);
+		return false;
+	}
+	return true;
+}
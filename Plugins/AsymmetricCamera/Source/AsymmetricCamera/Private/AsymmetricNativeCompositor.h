@@ -0,0 +1,67 @@
+// 原生立体图片序列合成：引擎图像编解码 + ParallelFor，不经过 FFmpeg
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricStereoTypes.h"
+#include "HAL/ThreadSafeBool.h"
+
+class IImageWrapperModule;
+struct FImageView;
+
+/**
+ * 逐帧读取左右眼图片，打包成 SBS / TB 后按输出扩展名重新编码写盘。
+ * 帧之间互不依赖，在任务图上并行；每帧只有解码 → 打包 → 编码三步，
+ * 打包直接写进输出图像预分配好的缓冲，编码器直接读这块缓冲。
+ *
+ * 一次请求可以有多个输出（不同布局 / 缩放），每帧眼图只解码一次，
+ * 同一布局只打包一次，缩放版本从打包结果缩小得到。
+ *
+ * 支持引擎 ImageWrapper 能读写的格式（PNG / JPEG / EXR / BMP / TGA 等），
+ * 输出保持眼图的像素格式和位深（8 位、16 位、半精度 / 全精度浮点）。
+ */
+class FAsymmetricNativeCompositor
+{
+public:
+	/** 一个输出版本 */
+	struct FOutput
+	{
+		TArray<FString> Paths;          // 与眼图一一对应，格式由扩展名决定
+		EAsymmetricStereoLayout Layout = EAsymmetricStereoLayout::SideBySide;
+		float Scale = 1.0f;             // 相对打包后全分辨率
+	};
+
+	struct FRequest
+	{
+		TArray<FString> LeftPaths;
+		TArray<FString> RightPaths;
+		TArray<FOutput> Outputs;
+		int32 Quality = 0;              // 传给编码器，0 为默认（JPEG 用 100）
+
+		/** 置为 true 后尚未开始的帧全部跳过 */
+		TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> CancelFlag;
+	};
+
+	struct FResult
+	{
+		int32  NumFrames = 0;
+		int32  NumFailed = 0;
+		double Seconds = 0.0;
+
+		bool   Succeeded() const { return NumFrames > 0 && NumFailed == 0; }
+		double GetFramesPerSecond() const { return Seconds > 0.0 ? NumFrames / Seconds : 0.0; }
+	};
+
+	/** 同步执行，帧间并行。ImageWrapper 模块必须已在游戏线程加载 */
+	static FResult Run(const FRequest& Request, IImageWrapperModule& ImageWrapperModule);
+
+	/** 在线程池上执行，结束后在游戏线程回调 OnCompleted。只能在游戏线程调用 */
+	static void LaunchAsync(FRequest&& Request, TFunction<void(const FResult&)>&& OnCompleted);
+
+private:
+	/** 合成一帧的全部输出，失败时写日志并返回 false */
+	static bool CompositeFrame(IImageWrapperModule& ImageWrapperModule, const FRequest& Request, int32 FrameIndex);
+
+	/** 编码并写出一张图 */
+	static bool SaveImage(IImageWrapperModule& ImageWrapperModule, const FImageView& Image, const FString& OutputPath, int32 Quality);
+};
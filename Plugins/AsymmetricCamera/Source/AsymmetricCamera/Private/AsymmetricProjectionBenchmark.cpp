@@ -0,0 +1,125 @@
+// 投影内核微基准：控制台命令 AsymmetricCamera.BenchmarkProjection
+
+#include "AsymmetricProjectionKernel.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricBenchmark, Log, All);
+
+namespace
+{
+	struct FBenchmarkScreen
+	{
+		FVector BL, BR, TL, Eye;
+	};
+
+	// 随机生成一组围绕原点的屏幕（CAVE / LED 墙尺度），眼睛在屏幕前方
+	void MakeBenchmarkScreens(int32 Num, TArray<FBenchmarkScreen>& OutScreens)
+	{
+		FRandomStream Random(0x4B6F6F6D);
+		OutScreens.SetNum(Num);
+		for (FBenchmarkScreen& Screen : OutScreens)
+		{
+			const FRotator Rotation(Random.FRandRange(-30.0f, 30.0f), Random.FRandRange(-180.0f, 180.0f), 0.0f);
+			const FQuat Quat = Rotation.Quaternion();
+			const FVector Center = Quat.RotateVector(FVector(Random.FRandRange(150.0f, 400.0f), 0.0f, 0.0f));
+			const double HW = Random.FRandRange(80.0f, 300.0f);
+			const double HH = HW * 0.5625;
+
+			Screen.BL  = Center + Quat.RotateVector(FVector(0.0, -HW, -HH));
+			Screen.BR  = Center + Quat.RotateVector(FVector(0.0,  HW, -HH));
+			Screen.TL  = Center + Quat.RotateVector(FVector(0.0, -HW,  HH));
+			Screen.Eye = FVector(Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-50.0f, 50.0f), Random.FRandRange(-20.0f, 20.0f));
+		}
+	}
+
+	// 重复执行 Body 直到累计时间超过 MinSeconds，返回每秒完成的矩阵数
+	template <typename BodyType>
+	double MeasureMatricesPerSecond(int32 MatricesPerIteration, double MinSeconds, BodyType&& Body)
+	{
+		int64 Iterations = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		double Elapsed = 0.0;
+		do
+		{
+			Body();
+			++Iterations;
+			Elapsed = FPlatformTime::Seconds() - StartTime;
+		}
+		while (Elapsed < MinSeconds);
+
+		return static_cast<double>(Iterations) * MatricesPerIteration / Elapsed;
+	}
+
+	void RunProjectionBenchmark(const TArray<FString>& Args)
+	{
+		const double MinSeconds = (Args.Num() > 0) ? FMath::Max(FCString::Atod(*Args[0]), 0.01) : 0.25;
+		static const int32 ScreenCounts[] = { 1, 64, 4096 };
+
+		UE_LOG(LogAsymmetricBenchmark, Display, TEXT("Off-axis projection benchmark (%.2fs per case):"), MinSeconds);
+		UE_LOG(LogAsymmetricBenchmark, Display, TEXT("  %8s  %18s  %18s  %8s"), TEXT("Screens"), TEXT("Scalar (mat/s)"), TEXT("Batch SoA (mat/s)"), TEXT("Speedup"));
+
+		for (const int32 NumScreens : ScreenCounts)
+		{
+			TArray<FBenchmarkScreen> Screens;
+			MakeBenchmarkScreens(NumScreens, Screens);
+
+			// 标量路径：每块屏幕各自推导正交基 + 投影矩阵 + 视图旋转矩阵
+			TArray<FMatrix> ScalarProjection;
+			TArray<FMatrix> ScalarViewRotation;
+			ScalarProjection.SetNumUninitialized(NumScreens);
+			ScalarViewRotation.SetNumUninitialized(NumScreens);
+			const double ScalarRate = MeasureMatricesPerSecond(NumScreens, MinSeconds, [&]()
+			{
+				for (int32 Index = 0; Index < NumScreens; ++Index)
+				{
+					const FBenchmarkScreen& Screen = Screens[Index];
+					const FAsymmetricScreenBasis Basis = FAsymmetricProjectionKernel::MakeScreenBasis(Screen.BL, Screen.BR, Screen.TL);
+					ScalarProjection[Index] = FAsymmetricProjectionKernel::MakeProjectionMatrix(
+						FAsymmetricProjectionKernel::ComputeFrustumExtents(Basis, Screen.Eye, 20.0f, 0.0f));
+					ScalarViewRotation[Index] = FAsymmetricProjectionKernel::MakeViewRotationMatrix(Basis);
+				}
+			});
+
+			// 批量路径：打包一次，内核每轮都完整重算
+			FAsymmetricProjectionBatch Batch;
+			Batch.Reset(NumScreens);
+			Batch.NearClip = 20.0f;
+			Batch.FarClip = 0.0f;
+			for (int32 Index = 0; Index < NumScreens; ++Index)
+			{
+				const FBenchmarkScreen& Screen = Screens[Index];
+				Batch.SetScreen(Index, FVector3f(Screen.BL), FVector3f(Screen.BR), FVector3f(Screen.TL), FVector3f(Screen.Eye));
+			}
+			const double BatchRate = MeasureMatricesPerSecond(NumScreens, MinSeconds, [&]()
+			{
+				FAsymmetricProjectionKernel::EvaluateBatch(Batch);
+			});
+
+			// 校验两条路径结果一致，防止基准测到的是错误的快
+			float MaxError = 0.0f;
+			for (int32 Index = 0; Index < NumScreens; ++Index)
+			{
+				for (int32 Row = 0; Row < 4; ++Row)
+				{
+					for (int32 Col = 0; Col < 4; ++Col)
+					{
+						const float Expected = static_cast<float>(ScalarProjection[Index].M[Row][Col]);
+						const float Relative = FMath::Abs(Batch.ProjectionMatrices[Index].M[Row][Col] - Expected) / FMath::Max(1.0f, FMath::Abs(Expected));
+						MaxError = FMath::Max(MaxError, Relative);
+					}
+				}
+			}
+
+			UE_LOG(LogAsymmetricBenchmark, Display, TEXT("  %8d  %18.0f  %18.0f  %7.2fx  (max rel. error %.2e)"),
+				NumScreens, ScalarRate, BatchRate, BatchRate / FMath::Max(ScalarRate, 1.0), MaxError);
+		}
+	}
+
+	FAutoConsoleCommand GBenchmarkProjectionCommand(
+		TEXT("AsymmetricCamera.BenchmarkProjection"),
+		TEXT("Measure off-axis projection throughput (matrices/s) for the scalar and batched kernels at 1, 64 and 4096 screens. ")
+		TEXT("Optional argument: seconds per case (default 0.25)."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunProjectionBenchmark));
+}
@@ -0,0 +1,307 @@
+// 离轴投影计算内核实现
+
+#include "AsymmetricProjectionKernel.h"
+#include "Math/RotationMatrix.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	// 无限远平面判断，和组件原来的约定一致（Far <= 0 或 Far == Near）
+	bool IsInfiniteFar(float Near, float Far)
+	{
+		return (Far <= 0.0f) || FMath::IsNearlyEqual(Near, Far);
+	}
+
+	// reversed-Z 深度项：标准左手系投影乘以 FlipZ 之后第 3 列只剩这两个值
+	//   无限远：M[2][2] = 0,            M[3][2] = Near（等价于 FReversedZPerspectiveMatrix）
+	//   有限远：M[2][2] = -N / (F - N), M[3][2] = F * N / (F - N)
+	void GetDepthTerms(float Near, float Far, float& OutM22, float& OutM32)
+	{
+		if (IsInfiniteFar(Near, Far))
+		{
+			OutM22 = 0.0f;
+			OutM32 = Near;
+		}
+		else
+		{
+			OutM22 = -Near / (Far - Near);
+			OutM32 = (Far * Near) / (Far - Near);
+		}
+	}
+
+	// 向量化 GetSafeNormal 的长度倒数：长度平方太小时返回 0，和 FVector::GetSafeNormal 一样
+	FORCEINLINE VectorRegister4Float SafeInvLength(const VectorRegister4Float& LengthSquared)
+	{
+		const VectorRegister4Float Tolerance = VectorSetFloat1(SMALL_NUMBER);
+		const VectorRegister4Float InvLength = VectorDivide(VectorOneFloat(), VectorSqrt(VectorMax(LengthSquared, Tolerance)));
+		return VectorSelect(VectorCompareLT(LengthSquared, Tolerance), VectorZeroFloat(), InvLength);
+	}
+
+	FORCEINLINE VectorRegister4Float Dot3(
+		const VectorRegister4Float& AX, const VectorRegister4Float& AY, const VectorRegister4Float& AZ,
+		const VectorRegister4Float& BX, const VectorRegister4Float& BY, const VectorRegister4Float& BZ)
+	{
+		return VectorMultiplyAdd(AZ, BZ, VectorMultiplyAdd(AY, BY, VectorMultiply(AX, BX)));
+	}
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// FAsymmetricProjectionBatch
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FAsymmetricProjectionBatch::Reset(int32 InNum)
+{
+	NumScreens = FMath::Max(InNum, 0);
+
+	// 补齐到 4 的倍数，内层循环不需要处理尾巴；补出来的通道全 0，结果不会写出
+	const int32 Padded = Align(NumScreens, 4);
+	for (TArray<float>* Lane : { &PAX, &PAY, &PAZ, &PBX, &PBY, &PBZ, &PCX, &PCY, &PCZ, &PEX, &PEY, &PEZ })
+	{
+		Lane->SetNumZeroed(Padded, EAllowShrinking::No);
+	}
+
+	ProjectionMatrices.SetNumUninitialized(NumScreens, EAllowShrinking::No);
+	ViewRotationMatrices.SetNumUninitialized(NumScreens, EAllowShrinking::No);
+}
+
+void FAsymmetricProjectionBatch::SetScreen(int32 Index, const FVector3f& BL, const FVector3f& BR, const FVector3f& TL, const FVector3f& Eye)
+{
+	check(Index >= 0 && Index < NumScreens);
+	PAX[Index] = BL.X;  PAY[Index] = BL.Y;  PAZ[Index] = BL.Z;
+	PBX[Index] = BR.X;  PBY[Index] = BR.Y;  PBZ[Index] = BR.Z;
+	PCX[Index] = TL.X;  PCY[Index] = TL.Y;  PCZ[Index] = TL.Z;
+	PEX[Index] = Eye.X; PEY[Index] = Eye.Y; PEZ[Index] = Eye.Z;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 单屏标量路径（double 精度）
+// ─────────────────────────────────────────────────────────────────────────────
+
+FAsymmetricScreenBasis FAsymmetricProjectionKernel::MakeScreenBasis(const FVector& BL, const FVector& BR, const FVector& TL)
+{
+	FAsymmetricScreenBasis Basis;
+	Basis.Origin = BL;
+
+	const FVector EdgeRight = BR - BL;
+	const FVector EdgeUp    = TL - BL;
+	Basis.Width  = EdgeRight.Size();
+	Basis.Height = EdgeUp.Size();
+
+	Basis.Right = EdgeRight.GetSafeNormal(); // 右
+	Basis.Up    = EdgeUp.GetSafeNormal();    // 上
+	// 屏幕法线：叉积取反（nDisplay 约定，左手系）
+	Basis.Normal = -FVector::CrossProduct(Basis.Right, Basis.Up).GetSafeNormal();
+	return Basis;
+}
+
+FAsymmetricFrustumExtents FAsymmetricProjectionKernel::ComputeFrustumExtents(
+	const FAsymmetricScreenBasis& Basis, const FVector& EyePosition, float NearClip, float FarClip)
+{
+	// 眼睛到屏幕左下角的向量。右下/左上两个角可以由宽高直接推出来：
+	//   VR·VB = VR·VA + Width，VU·VC = VU·VA + Height
+	// 所以每只眼只需要三次点积。
+	const FVector VA = Basis.Origin - EyePosition;
+
+	// 眼睛到屏幕平面的距离
+	const double Distance = -FVector::DotProduct(VA, Basis.Normal);
+	const double SafeDistance = (FMath::Abs(Distance) < MinScreenDistance) ? MinScreenDistance : Distance;
+
+	// 把屏幕范围投影到近裁切面上
+	const double NearOverDist = NearClip / SafeDistance;
+	const double RightDotA = FVector::DotProduct(Basis.Right, VA);
+	const double UpDotA    = FVector::DotProduct(Basis.Up, VA);
+
+	FAsymmetricFrustumExtents Extents;
+	Extents.Left   = static_cast<float>(RightDotA * NearOverDist);
+	Extents.Right  = static_cast<float>((RightDotA + Basis.Width) * NearOverDist);
+	Extents.Bottom = static_cast<float>(UpDotA * NearOverDist);
+	Extents.Top    = static_cast<float>((UpDotA + Basis.Height) * NearOverDist);
+	Extents.Near   = NearClip;
+	Extents.Far    = FarClip;
+	return Extents;
+}
+
+FAsymmetricFrustumExtents FAsymmetricProjectionKernel::MakeSubFrustumExtents(const FAsymmetricFrustumExtents& Extents, const FBox2D& NormalizedRect)
+{
+	// 画面 X 从左到右对应 Left→Right，Y 从上到下对应 Top→Bottom
+	const float Width  = Extents.Right - Extents.Left;
+	const float Height = Extents.Top - Extents.Bottom;
+
+	FAsymmetricFrustumExtents Sub = Extents;
+	Sub.Left   = Extents.Left + Width  * static_cast<float>(NormalizedRect.Min.X);
+	Sub.Right  = Extents.Left + Width  * static_cast<float>(NormalizedRect.Max.X);
+	Sub.Top    = Extents.Top  - Height * static_cast<float>(NormalizedRect.Min.Y);
+	Sub.Bottom = Extents.Top  - Height * static_cast<float>(NormalizedRect.Max.Y);
+	return Sub;
+}
+
+FMatrix FAsymmetricProjectionKernel::MakeProjectionMatrix(const FAsymmetricFrustumExtents& Extents)
+{
+	// nDisplay MakeProjectionMatrix 公式：标准左手系偏心投影 × FlipZ。
+	// FlipZ 只影响第 3 列，这里直接写出乘完之后的结果，省掉一次 4x4 矩阵乘法。
+	const float Near = Extents.Near;
+	const float Width  = Extents.Right - Extents.Left;
+	const float Height = Extents.Top - Extents.Bottom;
+
+	const float mx = 2.0f * Near / Width;
+	const float my = 2.0f * Near / Height;
+	const float ma = -(Extents.Right + Extents.Left) / Width;
+	const float mb = -(Extents.Top + Extents.Bottom) / Height;
+
+	float M22, M32;
+	GetDepthTerms(Near, Extents.Far, M22, M32);
+
+	return FMatrix(
+		FPlane(mx,   0.0f, 0.0f, 0.0f),
+		FPlane(0.0f, my,   0.0f, 0.0f),
+		FPlane(ma,   mb,   M22,  1.0f),
+		FPlane(0.0f, 0.0f, M32,  0.0f));
+}
+
+FMatrix FAsymmetricProjectionKernel::MakeViewRotationMatrix(const FAsymmetricScreenBasis& Basis)
+{
+	// FInverseRotationMatrix 的三列是 (前, 右, 上)，SwizzleMatrix 把它们换成 (右, 上, 前)，
+	// 所以可以直接用屏幕正交基填矩阵。上方向用 前×右 重新正交化。
+	const FVector Forward = -Basis.Normal;
+	const FVector Right   = Basis.Right;
+	const FVector Up      = FVector::CrossProduct(Forward, Right);
+
+	return FMatrix(
+		FPlane(Right.X, Up.X, Forward.X, 0.0f),
+		FPlane(Right.Y, Up.Y, Forward.Y, 0.0f),
+		FPlane(Right.Z, Up.Z, Forward.Z, 0.0f),
+		FPlane(0.0f,    0.0f, 0.0f,      1.0f));
+}
+
+FRotator FAsymmetricProjectionKernel::MakeViewRotation(const FAsymmetricScreenBasis& Basis)
+{
+	return FRotationMatrix::MakeFromXZ(-Basis.Normal, Basis.Up).Rotator();
+}
+
+bool FAsymmetricProjectionKernel::Calculate(
+	const FAsymmetricScreenBasis& Basis, const FVector& EyePosition, float NearClip, float FarClip,
+	FRotator& OutViewRotation, FMatrix& OutProjectionMatrix)
+{
+	if (!Basis.IsValid())
+	{
+		return false;
+	}
+
+	OutViewRotation = MakeViewRotation(Basis);
+	OutProjectionMatrix = MakeProjectionMatrix(ComputeFrustumExtents(Basis, EyePosition, NearClip, FarClip));
+	return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 批量向量化路径（float，SoA，每次 4 块屏幕）
+// ─────────────────────────────────────────────────────────────────────────────
+
+void FAsymmetricProjectionKernel::EvaluateBatch(FAsymmetricProjectionBatch& Batch)
+{
+	const int32 Num = Batch.Num();
+	if (Num == 0)
+	{
+		return;
+	}
+
+	float M22, M32;
+	GetDepthTerms(Batch.NearClip, Batch.FarClip, M22, M32);
+
+	const VectorRegister4Float Near        = VectorSetFloat1(Batch.NearClip);
+	const VectorRegister4Float TwoNear     = VectorSetFloat1(2.0f * Batch.NearClip);
+	const VectorRegister4Float MinDistance = VectorSetFloat1(MinScreenDistance);
+
+	// 每组 4 个通道的结果先存到对齐的临时数组，再按矩阵写出
+	alignas(16) float OutMX[4], OutMY[4], OutMA[4], OutMB[4];
+	alignas(16) float OutRX[4], OutRY[4], OutRZ[4];
+	alignas(16) float OutUX[4], OutUY[4], OutUZ[4];
+	alignas(16) float OutFX[4], OutFY[4], OutFZ[4];
+
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		const VectorRegister4Float AX = VectorLoad(&Batch.PAX[Base]);
+		const VectorRegister4Float AY = VectorLoad(&Batch.PAY[Base]);
+		const VectorRegister4Float AZ = VectorLoad(&Batch.PAZ[Base]);
+
+		// 屏幕两条边
+		const VectorRegister4Float EdgeRX = VectorSubtract(VectorLoad(&Batch.PBX[Base]), AX);
+		const VectorRegister4Float EdgeRY = VectorSubtract(VectorLoad(&Batch.PBY[Base]), AY);
+		const VectorRegister4Float EdgeRZ = VectorSubtract(VectorLoad(&Batch.PBZ[Base]), AZ);
+		const VectorRegister4Float EdgeUX = VectorSubtract(VectorLoad(&Batch.PCX[Base]), AX);
+		const VectorRegister4Float EdgeUY = VectorSubtract(VectorLoad(&Batch.PCY[Base]), AY);
+		const VectorRegister4Float EdgeUZ = VectorSubtract(VectorLoad(&Batch.PCZ[Base]), AZ);
+
+		// 宽高和正交基 VR / VU
+		const VectorRegister4Float WidthSq  = Dot3(EdgeRX, EdgeRY, EdgeRZ, EdgeRX, EdgeRY, EdgeRZ);
+		const VectorRegister4Float HeightSq = Dot3(EdgeUX, EdgeUY, EdgeUZ, EdgeUX, EdgeUY, EdgeUZ);
+		const VectorRegister4Float InvWidth  = SafeInvLength(WidthSq);
+		const VectorRegister4Float InvHeight = SafeInvLength(HeightSq);
+		const VectorRegister4Float Width  = VectorMultiply(WidthSq, InvWidth);
+		const VectorRegister4Float Height = VectorMultiply(HeightSq, InvHeight);
+
+		const VectorRegister4Float RX = VectorMultiply(EdgeRX, InvWidth);
+		const VectorRegister4Float RY = VectorMultiply(EdgeRY, InvWidth);
+		const VectorRegister4Float RZ = VectorMultiply(EdgeRZ, InvWidth);
+		const VectorRegister4Float UX = VectorMultiply(EdgeUX, InvHeight);
+		const VectorRegister4Float UY = VectorMultiply(EdgeUY, InvHeight);
+		const VectorRegister4Float UZ = VectorMultiply(EdgeUZ, InvHeight);
+
+		// 朝屏幕里的方向 F = normalize(VR × VU) = -VN
+		VectorRegister4Float FX = VectorSubtract(VectorMultiply(RY, UZ), VectorMultiply(RZ, UY));
+		VectorRegister4Float FY = VectorSubtract(VectorMultiply(RZ, UX), VectorMultiply(RX, UZ));
+		VectorRegister4Float FZ = VectorSubtract(VectorMultiply(RX, UY), VectorMultiply(RY, UX));
+		const VectorRegister4Float InvF = SafeInvLength(Dot3(FX, FY, FZ, FX, FY, FZ));
+		FX = VectorMultiply(FX, InvF);
+		FY = VectorMultiply(FY, InvF);
+		FZ = VectorMultiply(FZ, InvF);
+
+		// 眼睛到屏幕左下角 VA = PA - PE
+		const VectorRegister4Float VAX = VectorSubtract(AX, VectorLoad(&Batch.PEX[Base]));
+		const VectorRegister4Float VAY = VectorSubtract(AY, VectorLoad(&Batch.PEY[Base]));
+		const VectorRegister4Float VAZ = VectorSubtract(AZ, VectorLoad(&Batch.PEZ[Base]));
+
+		// 眼睛到屏幕平面的距离 -VA·VN = VA·F，太近时钳到 MinScreenDistance
+		const VectorRegister4Float Distance = Dot3(VAX, VAY, VAZ, FX, FY, FZ);
+		const VectorRegister4Float SafeDistance = VectorSelect(
+			VectorCompareLT(VectorAbs(Distance), MinDistance), MinDistance, Distance);
+		const VectorRegister4Float NearOverDist = VectorDivide(Near, SafeDistance);
+
+		// 近裁切面上的 l/r/b/t
+		const VectorRegister4Float RightDotA = Dot3(RX, RY, RZ, VAX, VAY, VAZ);
+		const VectorRegister4Float UpDotA    = Dot3(UX, UY, UZ, VAX, VAY, VAZ);
+		const VectorRegister4Float Left   = VectorMultiply(RightDotA, NearOverDist);
+		const VectorRegister4Float Right  = VectorMultiply(VectorAdd(RightDotA, Width), NearOverDist);
+		const VectorRegister4Float Bottom = VectorMultiply(UpDotA, NearOverDist);
+		const VectorRegister4Float Top    = VectorMultiply(VectorAdd(UpDotA, Height), NearOverDist);
+
+		const VectorRegister4Float ExtentW = VectorSubtract(Right, Left);
+		const VectorRegister4Float ExtentH = VectorSubtract(Top, Bottom);
+		VectorStoreAligned(VectorDivide(TwoNear, ExtentW), OutMX);
+		VectorStoreAligned(VectorDivide(TwoNear, ExtentH), OutMY);
+		VectorStoreAligned(VectorNegate(VectorDivide(VectorAdd(Right, Left), ExtentW)), OutMA);
+		VectorStoreAligned(VectorNegate(VectorDivide(VectorAdd(Top, Bottom), ExtentH)), OutMB);
+
+		// 视图旋转：右 = VR，前 = F，上 = F × VR（重新正交化）
+		VectorStoreAligned(RX, OutRX); VectorStoreAligned(RY, OutRY); VectorStoreAligned(RZ, OutRZ);
+		VectorStoreAligned(FX, OutFX); VectorStoreAligned(FY, OutFY); VectorStoreAligned(FZ, OutFZ);
+		VectorStoreAligned(VectorSubtract(VectorMultiply(FY, RZ), VectorMultiply(FZ, RY)), OutUX);
+		VectorStoreAligned(VectorSubtract(VectorMultiply(FZ, RX), VectorMultiply(FX, RZ)), OutUY);
+		VectorStoreAligned(VectorSubtract(VectorMultiply(FX, RY), VectorMultiply(FY, RX)), OutUZ);
+
+		const int32 LaneCount = FMath::Min(4, Num - Base);
+		for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+		{
+			Batch.ProjectionMatrices[Base + Lane] = FMatrix44f(
+				FPlane4f(OutMX[Lane], 0.0f,        0.0f, 0.0f),
+				FPlane4f(0.0f,        OutMY[Lane], 0.0f, 0.0f),
+				FPlane4f(OutMA[Lane], OutMB[Lane], M22,  1.0f),
+				FPlane4f(0.0f,        0.0f,        M32,  0.0f));
+
+			Batch.ViewRotationMatrices[Base + Lane] = FMatrix44f(
+				FPlane4f(OutRX[Lane], OutUX[Lane], OutFX[Lane], 0.0f),
+				FPlane4f(OutRY[Lane], OutUY[Lane], OutFY[Lane], 0.0f),
+				FPlane4f(OutRZ[Lane], OutUZ[Lane], OutFZ[Lane], 0.0f),
+				FPlane4f(0.0f,        0.0f,        0.0f,        1.0f));
+		}
+	}
+}
@@ -1,6 +1,8 @@
 // 投影屏幕组件实现
 
 #include "AsymmetricScreenComponent.h"
+#include "AsymmetricCameraSubsystem.h"
+#include "Engine/World.h"
 
 UAsymmetricScreenComponent::UAsymmetricScreenComponent()
 {
@@ -10,6 +12,28 @@ UAsymmetricScreenComponent::UAsymmetricScreenComponent()
 	ScreenHeight = 90.0f;
 }
 
+void UAsymmetricScreenComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UWorld* World = GetWorld();
+	if (UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr)
+	{
+		Subsystem->RegisterScreen(this);
+	}
+}
+
+void UAsymmetricScreenComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	if (UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr)
+	{
+		Subsystem->UnregisterScreen(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 FVector2D UAsymmetricScreenComponent::GetScreenSize() const
 {
 	return FVector2D(ScreenWidth, ScreenHeight);
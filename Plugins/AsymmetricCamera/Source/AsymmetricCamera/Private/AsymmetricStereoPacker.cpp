@@ -0,0 +1,113 @@
+// 左右眼打包实现
+
+#include "AsymmetricStereoPacker.h"
+#include "ImagePixelData.h"
+#include "MovieRenderPipelineDataTypes.h"
+#include "Async/ParallelFor.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoPacker, Log, All);
+
+namespace
+{
+	// 每个任务拷贝的行数。8K 一行 RGBA8 约 30KB，64 行约 2MB，足够摊平任务调度开销
+	constexpr int32 RowsPerTask = 64;
+
+	template <typename PixelType>
+	TUniquePtr<FImagePixelData> PackTyped(const FImagePixelData& Left, const FImagePixelData& Right, EAsymmetricStereoLayout Layout)
+	{
+		const FIntPoint EyeSize = Left.GetSize();
+		const FIntPoint PackedSize = FAsymmetricStereoPacker::GetPackedSize(EyeSize, Layout);
+
+		TArray64<PixelType> Pixels;
+		Pixels.SetNumUninitialized(int64(PackedSize.X) * PackedSize.Y);
+
+		const void* LeftData = nullptr;
+		const void* RightData = nullptr;
+		int64 LeftBytes = 0;
+		int64 RightBytes = 0;
+		Left.GetRawData(LeftData, LeftBytes);
+		Right.GetRawData(RightData, RightBytes);
+
+		FAsymmetricStereoPacker::Pack(static_cast<const uint8*>(LeftData), static_cast<const uint8*>(RightData),
+			EyeSize, sizeof(PixelType), Layout, reinterpret_cast<uint8*>(Pixels.GetData()));
+
+		// 文件名、色彩空间等元数据沿用左眼的
+		FImagePixelDataPayloadPtr Payload;
+		if (const FImagePixelDataPayload* LeftPayload = Left.GetPayload<FImagePixelDataPayload>())
+		{
+			Payload = LeftPayload->Copy();
+		}
+
+		return MakeUnique<TImagePixelData<PixelType>>(PackedSize, MoveTemp(Pixels), Payload);
+	}
+}
+
+FIntPoint FAsymmetricStereoPacker::GetPackedSize(const FIntPoint& EyeSize, EAsymmetricStereoLayout Layout)
+{
+	switch (Layout)
+	{
+	case EAsymmetricStereoLayout::SideBySide: return FIntPoint(EyeSize.X * 2, EyeSize.Y);
+	case EAsymmetricStereoLayout::TopBottom:  return FIntPoint(EyeSize.X, EyeSize.Y * 2);
+	default:                                  return EyeSize;
+	}
+}
+
+void FAsymmetricStereoPacker::Pack(const uint8* Left, const uint8* Right, const FIntPoint& EyeSize, int32 BytesPerPixel,
+	EAsymmetricStereoLayout Layout, uint8* Out)
+{
+	const int64 EyeRowBytes = int64(EyeSize.X) * BytesPerPixel;
+	const int32 NumBlocks = FMath::DivideAndRoundUp(EyeSize.Y, RowsPerTask);
+
+	if (Layout == EAsymmetricStereoLayout::SideBySide)
+	{
+		const int64 OutRowBytes = EyeRowBytes * 2;
+		ParallelFor(NumBlocks, [&](int32 Block)
+		{
+			const int32 FirstRow = Block * RowsPerTask;
+			const int32 LastRow = FMath::Min(FirstRow + RowsPerTask, EyeSize.Y);
+			for (int32 Row = FirstRow; Row < LastRow; ++Row)
+			{
+				uint8* Dest = Out + Row * OutRowBytes;
+				FMemory::Memcpy(Dest, Left + Row * EyeRowBytes, EyeRowBytes);
+				FMemory::Memcpy(Dest + EyeRowBytes, Right + Row * EyeRowBytes, EyeRowBytes);
+			}
+		});
+	}
+	else
+	{
+		// TB 和 Mono：左眼整块在前，右眼整块在后（Mono 只拷左眼）
+		const int64 EyeBytes = EyeRowBytes * EyeSize.Y;
+		const bool bStereo = (Layout == EAsymmetricStereoLayout::TopBottom);
+		ParallelFor(bStereo ? NumBlocks * 2 : NumBlocks, [&](int32 Task)
+		{
+			const bool bRightEye = Task >= NumBlocks;
+			const int32 Block = bRightEye ? Task - NumBlocks : Task;
+			const int32 FirstRow = Block * RowsPerTask;
+			const int32 NumRows = FMath::Min(RowsPerTask, EyeSize.Y - FirstRow);
+			const uint8* Source = (bRightEye ? Right : Left) + FirstRow * EyeRowBytes;
+			uint8* Dest = Out + (bRightEye ? EyeBytes : 0) + FirstRow * EyeRowBytes;
+			FMemory::Memcpy(Dest, Source, NumRows * EyeRowBytes);
+		});
+	}
+}
+
+TUniquePtr<FImagePixelData> FAsymmetricStereoPacker::Pack(const FImagePixelData& Left, const FImagePixelData& Right,
+	EAsymmetricStereoLayout Layout)
+{
+	if (Left.GetSize() != Right.GetSize() || Left.GetType() != Right.GetType())
+	{
+		UE_LOG(LogAsymmetricStereoPacker, Error, TEXT("Eye images do not match (left %dx%d type %d, right %dx%d type %d)."),
+			Left.GetSize().X, Left.GetSize().Y, int32(Left.GetType()), Right.GetSize().X, Right.GetSize().Y, int32(Right.GetType()));
+		return nullptr;
+	}
+
+	switch (Left.GetType())
+	{
+	case EImagePixelType::Color:   return PackTyped<FColor>(Left, Right, Layout);
+	case EImagePixelType::Float16: return PackTyped<FFloat16Color>(Left, Right, Layout);
+	case EImagePixelType::Float32: return PackTyped<FLinearColor>(Left, Right, Layout);
+	default:
+		UE_LOG(LogAsymmetricStereoPacker, Error, TEXT("Unsupported pixel type %d."), int32(Left.GetType()));
+		return nullptr;
+	}
+}
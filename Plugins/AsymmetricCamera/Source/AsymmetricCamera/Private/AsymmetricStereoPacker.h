@@ -0,0 +1,35 @@
+// 左右眼图像打包为 SBS / TB 单帧：流式输出、原生合成器、图片输出节点共用
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricStereoTypes.h"
+
+struct FImagePixelData;
+
+/**
+ * 把两张同尺寸、同像素格式的眼图拷进一块预先分配好的输出缓冲。
+ * 每个像素只拷一次，按行分块用 ParallelFor 并行，纯内存带宽操作。
+ *
+ * SBS：输出宽度翻倍，每行 = 左眼一行 + 右眼一行
+ * TB ：输出高度翻倍，左眼在上、右眼在下（两段整块拷贝）
+ */
+struct FAsymmetricStereoPacker
+{
+	/** 打包后的尺寸；Mono 时返回眼图尺寸 */
+	static FIntPoint GetPackedSize(const FIntPoint& EyeSize, EAsymmetricStereoLayout Layout);
+
+	/**
+	 * 原始内存版本，行之间没有填充。
+	 * @param Out - 调用方预分配，大小至少为 GetPackedSize() 像素 * BytesPerPixel
+	 */
+	static void Pack(const uint8* Left, const uint8* Right, const FIntPoint& EyeSize, int32 BytesPerPixel,
+		EAsymmetricStereoLayout Layout, uint8* Out);
+
+	/**
+	 * FImagePixelData 版本，输出和输入同像素类型，Payload 取左眼的。
+	 * 两眼尺寸或像素类型不一致时返回 nullptr。
+	 */
+	static TUniquePtr<FImagePixelData> Pack(const FImagePixelData& Left, const FImagePixelData& Right,
+		EAsymmetricStereoLayout Layout);
+};
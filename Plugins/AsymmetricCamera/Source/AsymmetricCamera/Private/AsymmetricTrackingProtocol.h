@@ -0,0 +1,90 @@
+// 追踪 UDP 包格式：接收端和本地测试发送端共用
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+/**
+ * 固定 48 字节、小端、无对齐填充的二进制包。一包一个传感器采样，
+ * 和 VRPN Tracker / OSC 常见的 "id + 时间戳 + 位置 + 四元数" 结构一致，
+ * 第三方追踪软件只需要按这个布局发送即可：
+ *
+ *   偏移  类型      字段
+ *    0    uint32    Magic = 'ATRK'
+ *    4    uint16    Version = 1
+ *    6    uint16    SensorId
+ *    8    uint32    Sequence
+ *   12    uint64    SenderTimestampUs
+ *   20    float[3]  Position (X, Y, Z)，UE 轴向，厘米
+ *   32    float[4]  Orientation (X, Y, Z, W)
+ */
+namespace AsymmetricTrackingProtocol
+{
+	static constexpr uint32 Magic = 0x4B525441; // 'A' 'T' 'R' 'K'，按小端读出
+	static constexpr uint16 Version = 1;
+	static constexpr int32  PacketSize = 48;
+
+	/** 测试发送端和接收端共用的时钟（微秒），两端在同一台机器上时可以直接相减得到传输延迟 */
+	inline uint64 NowMicroseconds()
+	{
+		return static_cast<uint64>(static_cast<double>(FPlatformTime::Cycles64()) * FPlatformTime::GetSecondsPerCycle64() * 1000000.0);
+	}
+
+	struct FPacket
+	{
+		uint16    SensorId = 0;
+		uint32    Sequence = 0;
+		uint64    SenderTimestampUs = 0;
+		FVector3f Position = FVector3f::ZeroVector;
+		FQuat4f   Orientation = FQuat4f::Identity;
+	};
+
+	template <typename T>
+	inline void WriteField(uint8* Buffer, int32 Offset, const T& Value)
+	{
+		FMemory::Memcpy(Buffer + Offset, &Value, sizeof(T));
+	}
+
+	template <typename T>
+	inline T ReadField(const uint8* Buffer, int32 Offset)
+	{
+		T Value;
+		FMemory::Memcpy(&Value, Buffer + Offset, sizeof(T));
+		return Value;
+	}
+
+	/** 序列化到 Buffer（至少 PacketSize 字节） */
+	inline void Write(const FPacket& Packet, uint8* Buffer)
+	{
+		static_assert(PLATFORM_LITTLE_ENDIAN, "Tracking packets are little-endian on the wire");
+		WriteField(Buffer, 0, Magic);
+		WriteField(Buffer, 4, Version);
+		WriteField(Buffer, 6, Packet.SensorId);
+		WriteField(Buffer, 8, Packet.Sequence);
+		WriteField(Buffer, 12, Packet.SenderTimestampUs);
+		WriteField(Buffer, 20, Packet.Position.X);
+		WriteField(Buffer, 24, Packet.Position.Y);
+		WriteField(Buffer, 28, Packet.Position.Z);
+		WriteField(Buffer, 32, Packet.Orientation.X);
+		WriteField(Buffer, 36, Packet.Orientation.Y);
+		WriteField(Buffer, 40, Packet.Orientation.Z);
+		WriteField(Buffer, 44, Packet.Orientation.W);
+	}
+
+	/** 解包；长度、魔数或版本不对返回 false */
+	inline bool Read(const uint8* Buffer, int32 Size, FPacket& OutPacket)
+	{
+		if (Size != PacketSize || ReadField<uint32>(Buffer, 0) != Magic || ReadField<uint16>(Buffer, 4) != Version)
+		{
+			return false;
+		}
+
+		OutPacket.SensorId          = ReadField<uint16>(Buffer, 6);
+		OutPacket.Sequence          = ReadField<uint32>(Buffer, 8);
+		OutPacket.SenderTimestampUs = ReadField<uint64>(Buffer, 12);
+		OutPacket.Position          = FVector3f(ReadField<float>(Buffer, 20), ReadField<float>(Buffer, 24), ReadField<float>(Buffer, 28));
+		OutPacket.Orientation       = FQuat4f(ReadField<float>(Buffer, 32), ReadField<float>(Buffer, 36), ReadField<float>(Buffer, 40), ReadField<float>(Buffer, 44));
+		return true;
+	}
+}
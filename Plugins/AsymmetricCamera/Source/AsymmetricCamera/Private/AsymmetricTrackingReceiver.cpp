@@ -0,0 +1,96 @@
+// 追踪数据 UDP 接收线程实现
+
+#include "AsymmetricTrackingReceiver.h"
+#include "AsymmetricTrackingSubsystem.h"
+#include "AsymmetricTrackingProtocol.h"
+#include "Common/UdpSocketBuilder.h"
+#include "HAL/RunnableThread.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricTrackingReceiver, Log, All);
+
+FAsymmetricTrackingReceiver::FAsymmetricTrackingReceiver(UAsymmetricTrackingSubsystem* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+}
+
+FAsymmetricTrackingReceiver::~FAsymmetricTrackingReceiver()
+{
+	Shutdown();
+}
+
+bool FAsymmetricTrackingReceiver::Start(int32 Port)
+{
+	check(!Thread);
+
+	// 接收缓冲给大一点，追踪器以 1kHz 发送时游戏线程卡一下也不会被内核丢包
+	Socket = FUdpSocketBuilder(TEXT("AsymmetricTrackingReceiver"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToPort(Port)
+		.WithReceiveBufferSize(256 * 1024);
+
+	if (!Socket)
+	{
+		UE_LOG(LogAsymmetricTrackingReceiver, Error, TEXT("Failed to bind tracking UDP socket on port %d."), Port);
+		return false;
+	}
+
+	bStopping = false;
+	Thread = FRunnableThread::Create(this, TEXT("AsymmetricTrackingReceiver"), 0, TPri_AboveNormal);
+	if (!Thread)
+	{
+		UE_LOG(LogAsymmetricTrackingReceiver, Error, TEXT("Failed to start tracking receiver thread."));
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+		return false;
+	}
+
+	UE_LOG(LogAsymmetricTrackingReceiver, Log, TEXT("Tracking receiver listening on UDP port %d."), Port);
+	return true;
+}
+
+void FAsymmetricTrackingReceiver::Shutdown()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+}
+
+uint32 FAsymmetricTrackingReceiver::Run()
+{
+	// 多留一点空间，超长的包 RecvFrom 会截断，长度校验时直接拒掉
+	uint8 Buffer[AsymmetricTrackingProtocol::PacketSize + 16];
+	const FTimespan WaitTime = FTimespan::FromMilliseconds(50.0);
+
+	while (!bStopping)
+	{
+		// 阻塞等待可读，超时只是为了定期检查退出标志和统计清零请求
+		if (!Socket->Wait(ESocketWaitConditions::WaitForRead, WaitTime))
+		{
+			Subsystem->ApplyPendingStatsReset();
+			continue;
+		}
+
+		// 一次把内核缓冲里积压的包全部读完
+		int32 BytesRead = 0;
+		while (!bStopping && Socket->Recv(Buffer, sizeof(Buffer), BytesRead) && BytesRead > 0)
+		{
+			Subsystem->IngestPacket(Buffer, BytesRead, FPlatformTime::Seconds());
+		}
+	}
+
+	return 0;
+}
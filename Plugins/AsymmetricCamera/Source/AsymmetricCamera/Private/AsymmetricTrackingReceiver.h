@@ -0,0 +1,39 @@
+// 追踪数据 UDP 接收线程
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FSocket;
+class FRunnableThread;
+class UAsymmetricTrackingSubsystem;
+
+/**
+ * 独立线程阻塞等待 UDP 包，收到后立即交给子系统写入环形缓冲。
+ * 线程是各传感器环形缓冲的唯一生产者。
+ * 生命周期由 UAsymmetricTrackingSubsystem 管理，子系统销毁前一定会先 Stop。
+ */
+class FAsymmetricTrackingReceiver : public FRunnable
+{
+public:
+	explicit FAsymmetricTrackingReceiver(UAsymmetricTrackingSubsystem* InSubsystem);
+	virtual ~FAsymmetricTrackingReceiver() override;
+
+	/** 创建 socket 并启动线程 */
+	bool Start(int32 Port);
+
+	/** 通知线程退出并等待结束，关闭 socket */
+	void Shutdown();
+
+	// FRunnable 接口
+	virtual uint32 Run() override;
+	virtual void Stop() override { bStopping = true; }
+
+private:
+	UAsymmetricTrackingSubsystem* Subsystem = nullptr;
+	FSocket* Socket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{ false };
+};
@@ -0,0 +1,242 @@
+// 头部追踪数据接入子系统实现
+
+#include "AsymmetricTrackingSubsystem.h"
+#include "AsymmetricTrackingReceiver.h"
+#include "AsymmetricTrackingProtocol.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricTracking, Log, All);
+
+void UAsymmetricTrackingSubsystem::Deinitialize()
+{
+	StopReceiver();
+	Super::Deinitialize();
+}
+
+bool UAsymmetricTrackingSubsystem::StartReceiver(int32 Port)
+{
+	if (Port <= 0 || Port > 65535)
+	{
+		UE_LOG(LogAsymmetricTracking, Warning, TEXT("Invalid tracking port %d."), Port);
+		return false;
+	}
+
+	if (Receiver.IsValid())
+	{
+		if (ReceiverPort == Port)
+		{
+			return true;
+		}
+		StopReceiver();
+	}
+
+	TSharedPtr<FAsymmetricTrackingReceiver, ESPMode::ThreadSafe> NewReceiver = MakeShared<FAsymmetricTrackingReceiver, ESPMode::ThreadSafe>(this);
+	if (!NewReceiver->Start(Port))
+	{
+		return false;
+	}
+
+	Receiver = MoveTemp(NewReceiver);
+	ReceiverPort = Port;
+	return true;
+}
+
+void UAsymmetricTrackingSubsystem::StopReceiver()
+{
+	if (Receiver.IsValid())
+	{
+		Receiver->Shutdown();
+		Receiver.Reset();
+	}
+	ReceiverPort = 0;
+}
+
+bool UAsymmetricTrackingSubsystem::GetLatestSample(int32 SensorId, FAsymmetricTrackingSample& OutSample) const
+{
+	if (SensorId < 0 || SensorId >= MaxSensors)
+	{
+		return false;
+	}
+	return SensorRings[SensorId].PeekLatest(OutSample);
+}
+
+bool UAsymmetricTrackingSubsystem::PopSample(int32 SensorId, FAsymmetricTrackingSample& OutSample)
+{
+	if (SensorId < 0 || SensorId >= MaxSensors)
+	{
+		return false;
+	}
+	return SensorRings[SensorId].Pop(OutSample);
+}
+
+bool UAsymmetricTrackingSubsystem::IngestPacket(const uint8* Data, int32 Size, double ReceiveTime)
+{
+	ApplyPendingStatsReset();
+
+	AsymmetricTrackingProtocol::FPacket Packet;
+	if (!AsymmetricTrackingProtocol::Read(Data, Size, Packet) || Packet.SensorId >= MaxSensors)
+	{
+		PacketsRejected.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	FAsymmetricTrackingSample Sample;
+	Sample.Position          = Packet.Position;
+	Sample.Orientation       = Packet.Orientation.GetNormalized();
+	Sample.SenderTimestampUs = Packet.SenderTimestampUs;
+	Sample.ReceiveTime       = ReceiveTime;
+	Sample.Sequence          = Packet.Sequence;
+	Sample.SensorId          = Packet.SensorId;
+	SensorRings[Packet.SensorId].Push(Sample);
+
+	// 序号跳变计为丢包（第一包和发送端重启时序号回退不计）
+	uint32& Last = LastSequence[Packet.SensorId];
+	if (Last != 0 && Packet.Sequence > Last + 1)
+	{
+		SequenceGaps.fetch_add(Packet.Sequence - Last - 1, std::memory_order_relaxed);
+	}
+	Last = Packet.Sequence;
+
+	PacketsReceived.fetch_add(1, std::memory_order_relaxed);
+	BytesReceived.fetch_add(Size, std::memory_order_relaxed);
+
+	// 传输延迟只在发送端和本机同一时钟时有意义（本地测试发送端），
+	// 外部追踪器的时间戳和本机无关，超出合理范围的直接忽略
+	const uint64 NowUs = AsymmetricTrackingProtocol::NowMicroseconds();
+	if (Packet.SenderTimestampUs != 0 && NowUs >= Packet.SenderTimestampUs && NowUs - Packet.SenderTimestampUs < 10000000ull)
+	{
+		const uint64 LatencyUs = NowUs - Packet.SenderTimestampUs;
+		LatencySamples.fetch_add(1, std::memory_order_relaxed);
+		LatencySumUs.fetch_add(LatencyUs, std::memory_order_relaxed);
+		if (LatencyUs > LatencyMaxUs.load(std::memory_order_relaxed))
+		{
+			LatencyMaxUs.store(LatencyUs, std::memory_order_relaxed); // 只有接收线程写，不需要 CAS
+		}
+	}
+	return true;
+}
+
+FAsymmetricTrackingStats UAsymmetricTrackingSubsystem::GetStats() const
+{
+	FAsymmetricTrackingStats Stats;
+	Stats.PacketsReceived = PacketsReceived.load(std::memory_order_relaxed);
+	Stats.PacketsRejected = PacketsRejected.load(std::memory_order_relaxed);
+	Stats.BytesReceived   = BytesReceived.load(std::memory_order_relaxed);
+	Stats.SequenceGaps    = SequenceGaps.load(std::memory_order_relaxed);
+	Stats.LatencySamples  = LatencySamples.load(std::memory_order_relaxed);
+	Stats.MaxLatencyUs    = static_cast<double>(LatencyMaxUs.load(std::memory_order_relaxed));
+	if (Stats.LatencySamples > 0)
+	{
+		Stats.AverageLatencyUs = static_cast<double>(LatencySumUs.load(std::memory_order_relaxed)) / Stats.LatencySamples;
+	}
+	return Stats;
+}
+
+void UAsymmetricTrackingSubsystem::ResetStats()
+{
+	// 接收线程在跑时由它自己清零，否则会和它的读-改-写交错（LatencyMaxUs、LastSequence 都不是原子操作）。
+	// 没在跑时没有写者，直接清零
+	if (Receiver.IsValid())
+	{
+		bStatsResetPending.store(true, std::memory_order_release);
+	}
+	else
+	{
+		bStatsResetPending.store(true, std::memory_order_relaxed);
+		ApplyPendingStatsReset();
+	}
+}
+
+void UAsymmetricTrackingSubsystem::ApplyPendingStatsReset()
+{
+	if (!bStatsResetPending.exchange(false, std::memory_order_acquire))
+	{
+		return;
+	}
+
+	// 序号基准一起清掉，清零后第一包不会把清零前的间隔算成丢包
+	FMemory::Memzero(LastSequence);
+	PacketsReceived.store(0, std::memory_order_relaxed);
+	PacketsRejected.store(0, std::memory_order_relaxed);
+	BytesReceived.store(0, std::memory_order_relaxed);
+	SequenceGaps.store(0, std::memory_order_relaxed);
+	LatencySamples.store(0, std::memory_order_relaxed);
+	LatencySumUs.store(0, std::memory_order_relaxed);
+	LatencyMaxUs.store(0, std::memory_order_relaxed);
+}
+
+namespace
+{
+	UAsymmetricTrackingSubsystem* GetTrackingSubsystem()
+	{
+		return GEngine ? GEngine->GetEngineSubsystem<UAsymmetricTrackingSubsystem>() : nullptr;
+	}
+
+	void StartTrackingReceiver(const TArray<FString>& Args)
+	{
+		if (UAsymmetricTrackingSubsystem* Subsystem = GetTrackingSubsystem())
+		{
+			const int32 Port = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 7700;
+			Subsystem->StartReceiver(Port);
+		}
+	}
+
+	void StopTrackingReceiver()
+	{
+		if (UAsymmetricTrackingSubsystem* Subsystem = GetTrackingSubsystem())
+		{
+			Subsystem->StopReceiver();
+		}
+	}
+
+	void DumpTrackingStats(const TArray<FString>& Args)
+	{
+		UAsymmetricTrackingSubsystem* Subsystem = GetTrackingSubsystem();
+		if (!Subsystem)
+		{
+			return;
+		}
+
+		const FAsymmetricTrackingStats Stats = Subsystem->GetStats();
+		UE_LOG(LogAsymmetricTracking, Display, TEXT("Tracking receiver: %s (port %d)"),
+			Subsystem->IsReceiving() ? TEXT("running") : TEXT("stopped"), Subsystem->GetReceiverPort());
+		UE_LOG(LogAsymmetricTracking, Display, TEXT("  packets %llu, rejected %llu, sequence gaps %llu, bytes %llu"),
+			Stats.PacketsReceived, Stats.PacketsRejected, Stats.SequenceGaps, Stats.BytesReceived);
+		UE_LOG(LogAsymmetricTracking, Display, TEXT("  transit latency avg %.1f us, max %.1f us (%llu samples)"),
+			Stats.AverageLatencyUs, Stats.MaxLatencyUs, Stats.LatencySamples);
+
+		// 各传感器最新采样的年龄
+		const double Now = FPlatformTime::Seconds();
+		for (int32 SensorId = 0; SensorId < UAsymmetricTrackingSubsystem::MaxSensors; ++SensorId)
+		{
+			FAsymmetricTrackingSample Sample;
+			if (Subsystem->GetLatestSample(SensorId, Sample))
+			{
+				UE_LOG(LogAsymmetricTracking, Display, TEXT("  sensor %2d: seq %u, age %.2f ms, pos (%.1f, %.1f, %.1f)"),
+					SensorId, Sample.Sequence, (Now - Sample.ReceiveTime) * 1000.0,
+					Sample.Position.X, Sample.Position.Y, Sample.Position.Z);
+			}
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Subsystem->ResetStats();
+		}
+	}
+
+	FAutoConsoleCommand GTrackingStartCommand(
+		TEXT("AsymmetricCamera.Tracking.Start"),
+		TEXT("Start the tracking UDP receiver. Optional argument: port (default 7700)."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&StartTrackingReceiver));
+
+	FAutoConsoleCommand GTrackingStopCommand(
+		TEXT("AsymmetricCamera.Tracking.Stop"),
+		TEXT("Stop the tracking UDP receiver."),
+		FConsoleCommandDelegate::CreateStatic(&StopTrackingReceiver));
+
+	FAutoConsoleCommand GTrackingStatsCommand(
+		TEXT("AsymmetricCamera.Tracking.Stats"),
+		TEXT("Print tracking receiver throughput, transit latency and per-sensor sample age. Pass 'reset' to clear the counters afterwards."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpTrackingStats));
+}
@@ -0,0 +1,155 @@
+// 本地追踪测试发送端：控制台命令 AsymmetricCamera.Tracking.TestSender
+// 在同一台机器上模拟追踪器发包，测量接收端的吞吐和传输延迟
+
+#include "AsymmetricTrackingSubsystem.h"
+#include "AsymmetricTrackingProtocol.h"
+#include "Async/Async.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricTrackingSender, Log, All);
+
+namespace
+{
+	/** 同一时间只跑一个测试发送端，两个同时发会互相抢接收端的统计 */
+	std::atomic<bool> GTrackingTestSenderRunning{ false };
+
+	struct FTrackingTestSendResult
+	{
+		uint64 Sent = 0;
+		uint64 SendFailures = 0;
+		double SendDuration = 0.0;
+	};
+
+	/** 按设定频率发包，在后台线程调用 */
+	FTrackingTestSendResult SendTrackingTestPackets(double RateHz, double Seconds, int32 Port, int32 SensorId)
+	{
+		FTrackingTestSendResult Result;
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		FSocket* Socket = FUdpSocketBuilder(TEXT("AsymmetricTrackingTestSender")).WithSendBufferSize(256 * 1024);
+		if (!Socket)
+		{
+			UE_LOG(LogAsymmetricTrackingSender, Error, TEXT("Failed to create test sender socket."));
+			return Result;
+		}
+
+		TSharedRef<FInternetAddr> Destination = SocketSubsystem->CreateInternetAddr();
+		Destination->SetLoopbackAddress();
+		Destination->SetPort(Port);
+
+		const double Interval  = (RateHz > 0.0) ? 1.0 / RateHz : 0.0;
+		const double StartTime = FPlatformTime::Seconds();
+		double NextSendTime = StartTime;
+		uint32 Sequence = 1;
+		uint8 Buffer[AsymmetricTrackingProtocol::PacketSize];
+
+		for (double Now = StartTime; Now - StartTime < Seconds; Now = FPlatformTime::Seconds())
+		{
+			if (Interval > 0.0 && Now < NextSendTime)
+			{
+				// 离下一包还早就让出时间片，快到了就自旋，保证高频发送时的节奏
+				if (NextSendTime - Now > 0.001)
+				{
+					FPlatformProcess::SleepNoStats(0.0f);
+				}
+				continue;
+			}
+			NextSendTime += Interval;
+
+			// 模拟头部在屏幕前绕圈，顺带轻微点头
+			const float Time = static_cast<float>(Now - StartTime);
+			AsymmetricTrackingProtocol::FPacket Packet;
+			Packet.SensorId          = static_cast<uint16>(SensorId);
+			Packet.Sequence          = Sequence++;
+			Packet.Position          = FVector3f(20.0f * FMath::Cos(Time), 20.0f * FMath::Sin(Time), 5.0f * FMath::Sin(Time * 2.0f));
+			Packet.Orientation       = FQuat4f(FRotator3f(5.0f * FMath::Sin(Time * 2.0f), 10.0f * FMath::Sin(Time), 0.0f));
+			Packet.SenderTimestampUs = AsymmetricTrackingProtocol::NowMicroseconds();
+			AsymmetricTrackingProtocol::Write(Packet, Buffer);
+
+			int32 BytesSent = 0;
+			if (Socket->SendTo(Buffer, sizeof(Buffer), BytesSent, *Destination) && BytesSent == sizeof(Buffer))
+			{
+				++Result.Sent;
+			}
+			else
+			{
+				++Result.SendFailures;
+			}
+		}
+		Result.SendDuration = FPlatformTime::Seconds() - StartTime;
+
+		Socket->Close();
+		SocketSubsystem->DestroySocket(Socket);
+		return Result;
+	}
+
+	void ReportTrackingTestSender(const FTrackingTestSendResult& Result, const FAsymmetricTrackingStats& Stats, double RateHz, int32 Port, int32 SensorId)
+	{
+		const double SendDuration = FMath::Max(Result.SendDuration, UE_SMALL_NUMBER);
+		const double LossPercent = (Result.Sent > 0) ? 100.0 * (1.0 - static_cast<double>(Stats.PacketsReceived) / Result.Sent) : 0.0;
+
+		UE_LOG(LogAsymmetricTrackingSender, Display, TEXT("Tracking test sender: sensor %d -> 127.0.0.1:%d, target %s, %.2fs"),
+			SensorId, Port, (RateHz > 0.0) ? *FString::Printf(TEXT("%.0f Hz"), RateHz) : TEXT("unthrottled"), Result.SendDuration);
+		UE_LOG(LogAsymmetricTrackingSender, Display, TEXT("  sent %llu (%.0f pkt/s, %llu send failures), received %llu (%.0f pkt/s), loss %.2f%%"),
+			Result.Sent, Result.Sent / SendDuration, Result.SendFailures, Stats.PacketsReceived, Stats.PacketsReceived / SendDuration, LossPercent);
+		UE_LOG(LogAsymmetricTrackingSender, Display, TEXT("  transit latency avg %.1f us, max %.1f us"),
+			Stats.AverageLatencyUs, Stats.MaxLatencyUs);
+	}
+
+	void RunTrackingTestSender(const TArray<FString>& Args)
+	{
+		UAsymmetricTrackingSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UAsymmetricTrackingSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			return;
+		}
+
+		const double RateHz   = (Args.Num() > 0) ? FMath::Max(FCString::Atod(*Args[0]), 0.0) : 1000.0;
+		const double Seconds  = (Args.Num() > 1) ? FMath::Clamp(FCString::Atod(*Args[1]), 0.1, 60.0) : 2.0;
+		const int32  Port     = (Args.Num() > 2) ? FCString::Atoi(*Args[2]) : (Subsystem->IsReceiving() ? Subsystem->GetReceiverPort() : 7700);
+		const int32  SensorId = (Args.Num() > 3) ? FMath::Clamp(FCString::Atoi(*Args[3]), 0, UAsymmetricTrackingSubsystem::MaxSensors - 1) : 0;
+
+		if (GTrackingTestSenderRunning.exchange(true))
+		{
+			UE_LOG(LogAsymmetricTrackingSender, Warning, TEXT("Tracking test sender is already running."));
+			return;
+		}
+
+		if (!Subsystem->StartReceiver(Port))
+		{
+			GTrackingTestSenderRunning = false;
+			return;
+		}
+		Subsystem->ResetStats();
+
+		// 单独开线程发包，游戏线程照常运行；接收线程独立运行，测到的就是接收路径本身的开销。
+		// 最长发 60 秒，不占线程池的工作线程
+		Async(EAsyncExecution::Thread, [WeakSubsystem = TWeakObjectPtr<UAsymmetricTrackingSubsystem>(Subsystem), RateHz, Seconds, Port, SensorId]()
+		{
+			const FTrackingTestSendResult Result = SendTrackingTestPackets(RateHz, Seconds, Port, SensorId);
+
+			// 给接收线程一点时间把内核缓冲里的包读完
+			FPlatformProcess::Sleep(0.1f);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakSubsystem, Result, RateHz, Port, SensorId]()
+			{
+				GTrackingTestSenderRunning = false;
+				if (UAsymmetricTrackingSubsystem* Subsystem = WeakSubsystem.Get())
+				{
+					ReportTrackingTestSender(Result, Subsystem->GetStats(), RateHz, Port, SensorId);
+				}
+			});
+		});
+	}
+
+	FAutoConsoleCommand GTrackingTestSenderCommand(
+		TEXT("AsymmetricCamera.Tracking.TestSender"),
+		TEXT("Act as a local head tracker: send synthetic tracking packets to the receiver over loopback and report throughput, loss and transit latency. ")
+		TEXT("Sends from a background thread and logs the report when done. Arguments: [rate Hz, 0 = unthrottled (default 1000)] [seconds (default 2)] [port] [sensor id]."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunTrackingTestSender));
+}
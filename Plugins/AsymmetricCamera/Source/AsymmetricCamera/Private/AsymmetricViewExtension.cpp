@@ -1,53 +1,99 @@
 // 场景视图扩展实现，在这里覆盖投影矩阵
 
 #include "AsymmetricViewExtension.h"
-#include "AsymmetricCameraComponent.h"
-#include "AsymmetricScreenComponent.h"
-#include "Math/InverseRotationMatrix.h"
+#include "AsymmetricProjectionKernel.h"
+#include "AsymmetricCameraStats.h"
+#include "AsymmetricTrackingSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "RenderingThread.h"
 #include "SceneView.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricCamera, Log, All);
 
+// 渲染开始时两种眼睛采样的年龄：游戏线程采样 vs late latch 重采样
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Eye Sample Age: Game Thread (ms)"), STAT_AsymmetricEyeAgeGameThread, STATGROUP_AsymmetricCamera);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Eye Sample Age: Late Latch (ms)"), STAT_AsymmetricEyeAgeLateLatch, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Late Latch Updates"), STAT_AsymmetricLateLatchUpdates, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Late Latch Skipped"), STAT_AsymmetricLateLatchSkipped, STATGROUP_AsymmetricCamera);
+
+// 每 View 历史表的开销
+DECLARE_CYCLE_STAT(TEXT("View History Lookup"), STAT_AsymmetricViewHistoryLookup, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_COUNTER_STAT(TEXT("View History Probes"), STAT_AsymmetricViewHistoryProbes, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("View History Entries"), STAT_AsymmetricViewHistoryEntries, STATGROUP_AsymmetricCamera);
+DECLARE_MEMORY_STAT(TEXT("View History Memory"), STAT_AsymmetricViewHistoryMemory, STATGROUP_AsymmetricCamera);
+
 // 调试日志计数器：只在前几帧打印，避免每帧刷屏
 static int32 GAsymmetricDebugLogFrames = 0;
 
+namespace
+{
+	/** 按快照里的追踪参数读取最新采样（任意线程），未启用、没有数据或超时返回 false */
+	bool SampleTrackedEye(const FAsymmetricProjectionState& State, FAsymmetricTrackingSample& OutSample)
+	{
+		return State.bUseTracking && State.Tracking
+			&& State.Tracking->GetLatestSample(State.TrackingSensorId, OutSample)
+			&& FPlatformTime::Seconds() - OutSample.ReceiveTime <= State.TrackingTimeout;
+	}
+}
+
 FAsymmetricViewExtension::FAsymmetricViewExtension(
 	const FAutoRegister& AutoRegister,
 	UWorld* InWorld,
-	UAsymmetricCameraComponent* InComponent)
+	const TSharedRef<const FAsymmetricCameraRegistry, ESPMode::ThreadSafe>& InRegistry)
 	: FWorldSceneViewExtension(AutoRegister, InWorld)
-	, CameraComponent(InComponent)
+	, Registry(InRegistry)
 {
+	INC_MEMORY_STAT_BY(STAT_AsymmetricViewHistoryMemory, ViewHistory.GetMemorySize());
+}
+
+FAsymmetricViewExtension::~FAsymmetricViewExtension()
+{
+	DEC_MEMORY_STAT_BY(STAT_AsymmetricViewHistoryMemory, ViewHistory.GetMemorySize());
+	DEC_DWORD_STAT_BY(STAT_AsymmetricViewHistoryEntries, ViewHistory.Num());
+}
+
+bool FAsymmetricViewExtension::IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const
+{
+	return FWorldSceneViewExtension::IsActiveThisFrame_Internal(Context) && Registry->Num() > 0;
 }
 
 void FAsymmetricViewExtension::SetupViewProjectionMatrix(FSceneViewProjectionData& InOutProjectionData)
 {
 	// 运行时路径：MRQ 不走这里，走 SetupView
-	if (!CameraComponent.IsValid() || !CameraComponent->bUseAsymmetricProjection)
+	// bEnabled 已包含屏幕正交基有效（没有屏幕组件也没开外部数据时四角重合，正交基无效）
+	const FAsymmetricProjectionStateBuffer* StateBuffer = Registry->GetActive();
+	FAsymmetricProjectionState State;
+	if (!StateBuffer || !StateBuffer->Read(State) || !State.bEnabled)
 	{
 		return;
 	}
 
-	FVector EyePosition = CameraComponent->GetEyePosition();
-
-	FRotator ViewRotation;
-	FMatrix ProjectionMatrix;
-
-	if (!CameraComponent->CalculateOffAxisProjection(EyePosition, ViewRotation, ProjectionMatrix))
+	// 多屏模式下每个屏幕 View 的投影由多 View 渲染设备提供，这里不再覆盖
+	if (State.bMultiScreenActive)
 	{
 		return;
 	}
 
-	// 用屏幕旋转构建 ViewRotationMatrix，和 LocalPlayer.cpp:1244 一样：
+	const FAsymmetricScreenBasis& Basis = State.Basis;
+
+	// 眼睛来自追踪子系统时直接重读最新采样（比 Tick 里发布的更新），late latch 也要和它比较新旧
+	FAsymmetricTrackingSample TrackedSample;
+	const bool bTrackedEye = SampleTrackedEye(State, TrackedSample);
+	const FVector EyePosition = bTrackedEye
+		? State.TrackingToWorld.TransformPosition(FVector(TrackedSample.Position))
+		: State.EyePosition;
+
+	// 立体偏移：沿屏幕右方向偏移（和 CalculateOffAxisProjection 一致）
+	const FVector ProjectionEye = EyePosition + State.GetStereoShift();
+
+	const FMatrix ProjectionMatrix = FAsymmetricProjectionKernel::MakeProjectionMatrix(
+		FAsymmetricProjectionKernel::ComputeFrustumExtents(Basis, ProjectionEye, State.NearClip, State.FarClip));
+
+	// ViewRotationMatrix 直接由屏幕正交基构建，等价于 LocalPlayer.cpp:1244 的
 	//   FInverseRotationMatrix(ViewRotation) * SwizzleMatrix
 	// SwizzleMatrix 将 UE 坐标系（X=前，Y=右，Z=上）转换为渲染坐标系（X=右，Y=上，Z=前）
-	static const FMatrix SwizzleMatrix(
-		FPlane(0, 0, 1, 0),
-		FPlane(1, 0, 0, 0),
-		FPlane(0, 1, 0, 0),
-		FPlane(0, 0, 0, 1)
-	);
-	const FMatrix ViewRotationMatrix = FInverseRotationMatrix(ViewRotation) * SwizzleMatrix;
+	const FMatrix ViewRotationMatrix = FAsymmetricProjectionKernel::MakeViewRotationMatrix(Basis);
+	const FRotator ViewRotation = FAsymmetricProjectionKernel::MakeViewRotation(Basis);
 
 	// 调试日志（只打前 3 帧，排查投影矩阵是否正确）
 	if (GAsymmetricDebugLogFrames < 3)
@@ -68,13 +114,20 @@ void FAsymmetricViewExtension::SetupViewProjectionMatrix(FSceneViewProjectionDat
 	InOutProjectionData.ViewRotationMatrix = ViewRotationMatrix;
 	InOutProjectionData.ProjectionMatrix = ProjectionMatrix;
 
+	// 记录 late latch 输入，等 SetupView 拿到 View 标识后在 BeginRenderViewFamily 里发给渲染线程
+	if (bTrackedEye && State.bLateLatch)
+	{
+		PendingLateLatchView.State = State;
+		PendingLateLatchView.GameThreadSampleTime = TrackedSample.ReceiveTime;
+		bPendingLateLatchView = true;
+	}
+
 	// 约束视口比例匹配屏幕宽高比（防止拉伸）
 	// 当视口比例和屏幕比例不一致时，加上 Pillarbox（左右黑边）或 Letterbox（上下黑边）
-	if (CameraComponent->bMatchViewportAspectRatio && CameraComponent->ScreenComponent)
+	if (State.bMatchViewportAspectRatio)
 	{
-		const FVector2D ScreenSize = CameraComponent->ScreenComponent->GetScreenSize();
-		const float ScreenW = ScreenSize.X;
-		const float ScreenH = ScreenSize.Y;
+		const float ScreenW = State.ScreenSize.X;
+		const float ScreenH = State.ScreenSize.Y;
 		if (ScreenW <= SMALL_NUMBER || ScreenH <= SMALL_NUMBER)
 		{
 			return;
@@ -126,12 +179,27 @@ void FAsymmetricViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneV
 	// 所以在这里对离线渲染应用非对称投影。
 	if (!InView.bIsOfflineRender)
 	{
+		// 运行时：记下刚被 SetupViewProjectionMatrix 覆盖的 View，渲染线程按它匹配
+		if (bPendingLateLatchView)
+		{
+			PendingLateLatchView.ViewState = InView.State;
+			PendingLateLatchView.StereoViewIndex = InView.StereoViewIndex;
+			PendingLateLatch.Views.Add(MoveTemp(PendingLateLatchView));
+			PendingLateLatchView = FLateLatchInput::FView();
+			bPendingLateLatchView = false;
+		}
 		return;
 	}
 
-	if (!CameraComponent.IsValid()
-		|| !CameraComponent->bUseAsymmetricProjection
-		|| !CameraComponent->bEnableMRQSupport)
+	// Render Pass 按 ViewState 给这个 View 准备的画面分块（左右眼、多个相机各自一份）
+	FAsymmetricCameraRegistry::FOfflineTile Tile;
+	const bool bTiled = Registry->FindOfflineTile(InView.State, Tile);
+
+	// 按 View 的 Actor 找相机（MRQ 渲染的是当前镜头绑定的相机 Actor），找不到用活动相机
+	const AActor* ViewActor = InView.ViewActor;
+	const FAsymmetricProjectionStateBuffer* StateBuffer = Registry->FindForViewActor(ViewActor ? ViewActor->GetUniqueID() : 0);
+	FAsymmetricProjectionState State;
+	if (!StateBuffer || !StateBuffer->Read(State) || !State.bEnabled || !State.bEnableMRQSupport)
 	{
 		return;
 	}
@@ -139,32 +207,58 @@ void FAsymmetricViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneV
 	// 直接使用视图已设定的 ViewLocation 作为眼睛位置，
 	// 这样 MoviePipelineAsymmetricStereoPass::GetCameraInfo 已应用的左右眼偏移会被正确保留。
 	// 如果改用组件中心位置，左右眼会得到相同的投影矩阵（没有视差）。
-	FVector EyePosition = InView.ViewLocation;
-	FRotator ViewRotation;
-	FMatrix ProjectionMatrix;
+	const FVector EyePosition = InView.ViewLocation;
+	const FAsymmetricScreenBasis& Basis = State.Basis;
 
-	if (!CameraComponent->CalculateOffAxisProjection(EyePosition, ViewRotation, ProjectionMatrix))
+	const FVector ProjectionEye = EyePosition + State.GetStereoShift();
+	if (!Basis.IsValid())
 	{
 		return;
 	}
 
-	// 判断当前是哪只眼（0=左眼/单目，1=右眼），每眼独立维护前帧数据。
-	// 不区分眼别时，第二只眼会把第一只眼当前帧的位置当成"前帧"，导致运动模糊向量错误。
-	int32 EyeIdx = 0;
-	if (CameraComponent->EyeSeparation > SMALL_NUMBER)
+	// MRQ 高分辨率分块：MRQ 自己对投影矩阵做的分块缩放不适用于偏心投影（偏心项没有一起缩放），
+	// 这里按 Render Pass 提供的 Tile 区域直接从视锥范围切出子视锥，再加上同样的空间采样抖动
+	FAsymmetricFrustumExtents Extents = FAsymmetricProjectionKernel::ComputeFrustumExtents(Basis, ProjectionEye, State.NearClip, State.FarClip);
+	if (bTiled)
+	{
+		Extents = FAsymmetricProjectionKernel::MakeSubFrustumExtents(Extents, Tile.Rect);
+	}
+
+	const FRotator ViewRotation = FAsymmetricProjectionKernel::MakeViewRotation(Basis);
+	FMatrix ProjectionMatrix = FAsymmetricProjectionKernel::MakeProjectionMatrix(Extents);
+	if (bTiled)
+	{
+		ProjectionMatrix.M[2][0] += Tile.ClipJitter.X;
+		ProjectionMatrix.M[2][1] += Tile.ClipJitter.Y;
+	}
+
+	// 按 View 标识取前帧数据，每个 View（左右眼、多相机）独立维护。
+	// 不区分 View 时，第二只眼会把第一只眼当前帧的位置当成"前帧"，导致运动模糊向量错误。
+	// MRQ 给每个相机分配独立的 ViewState，直接用它区分；没有 ViewState 时退回按眼睛在屏幕哪一侧区分左右眼。
+	FAsymmetricViewKey ViewKey;
+	ViewKey.ViewState = InView.State;
+	ViewKey.StereoViewIndex = InView.StereoViewIndex;
+	if (!InView.State && State.EyeSeparation > SMALL_NUMBER)
 	{
-		FVector ScreenBL, ScreenBR, ScreenTL, ScreenTR;
-		CameraComponent->GetEffectiveScreenCorners(ScreenBL, ScreenBR, ScreenTL, ScreenTR);
-		const FVector ScreenRight = (ScreenBR - ScreenBL).GetSafeNormal();
-		const FVector BaseEyePos = CameraComponent->GetEyePosition();
 		// 点积正数说明眼睛在屏幕右侧（右眼），负数在左侧（左眼）
-		const float Side = FVector::DotProduct(EyePosition - BaseEyePos, ScreenRight);
-		EyeIdx = (Side >= 0.0f) ? 1 : 0;
+		const float Side = FVector::DotProduct(EyePosition - State.EyePosition, Basis.Right);
+		ViewKey.StereoViewIndex = (Side >= 0.0f) ? 1 : 0;
 	}
 
+	const int32 NumEntriesBefore = ViewHistory.Num();
+	bool bAdded = false;
+	int32 Probes = 0;
+	FViewPreviousData* PrevDataPtr = nullptr;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AsymmetricViewHistoryLookup);
+		PrevDataPtr = &ViewHistory.FindOrAdd(ViewKey, InViewFamily.FrameNumber, bAdded, &Probes);
+	}
+	INC_DWORD_STAT_BY(STAT_AsymmetricViewHistoryProbes, Probes);
+	INC_DWORD_STAT_BY(STAT_AsymmetricViewHistoryEntries, ViewHistory.Num() - NumEntriesBefore);
+
 	// 写入前帧变换数据，供运动模糊速度缓冲区计算使用。
 	// 第一帧没有前帧数据，不设 PreviousViewTransform（首帧无运动模糊，是 MRQ 固有限制）。
-	FPerEyePreviousData& PrevData = PrevDataPerEye[EyeIdx];
+	FViewPreviousData& PrevData = *PrevDataPtr;
 	if (PrevData.bHasData)
 	{
 		InView.PreviousViewTransform = FTransform(PrevData.ViewRotation.Quaternion(), PrevData.EyePosition);
@@ -181,3 +275,57 @@ void FAsymmetricViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneV
 	InView.ViewRotation = ViewRotation;
 	InView.UpdateViewMatrix();
 }
+
+void FAsymmetricViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	// 每个 ViewFamily 都发一份（没有覆盖任何 View 时是空的），渲染线程不会拿上一个 Family 的输入去改场景捕获之类的 View
+	FLateLatchInput Input = MoveTemp(PendingLateLatch);
+	PendingLateLatch = FLateLatchInput();
+	PendingLateLatchView = FLateLatchInput::FView();
+	bPendingLateLatchView = false;
+
+	ENQUEUE_RENDER_COMMAND(AsymmetricLateLatchInput)(
+		[Extension = SharedThis(this), Input = MoveTemp(Input)](FRHICommandListImmediate&) mutable
+		{
+			Extension->LateLatch_RenderThread = MoveTemp(Input);
+		});
+}
+
+void FAsymmetricViewExtension::PreRenderView_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView)
+{
+	const FLateLatchInput::FView* Input = LateLatch_RenderThread.Views.FindByPredicate([&InView](const FLateLatchInput::FView& View)
+	{
+		return View.ViewState == InView.State && View.StereoViewIndex == InView.StereoViewIndex;
+	});
+	if (!Input)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	SET_FLOAT_STAT(STAT_AsymmetricEyeAgeGameThread, (Now - Input->GameThreadSampleTime) * 1000.0);
+
+	// 没有比游戏线程更新的采样（或追踪已超时）就保留游戏线程的结果
+	FAsymmetricTrackingSample Sample;
+	if (!SampleTrackedEye(Input->State, Sample) || Sample.ReceiveTime <= Input->GameThreadSampleTime)
+	{
+		SET_FLOAT_STAT(STAT_AsymmetricEyeAgeLateLatch, (Now - Input->GameThreadSampleTime) * 1000.0);
+		INC_DWORD_STAT(STAT_AsymmetricLateLatchSkipped);
+		return;
+	}
+
+	// 屏幕不动，只有眼睛变了：重算视锥范围，视图旋转仍由屏幕正交基决定
+	const FAsymmetricProjectionState& State = Input->State;
+	const FVector EyePosition = State.TrackingToWorld.TransformPosition(FVector(Sample.Position));
+	const FMatrix ProjectionMatrix = FAsymmetricProjectionKernel::MakeProjectionMatrix(
+		FAsymmetricProjectionKernel::ComputeFrustumExtents(State.Basis, EyePosition + State.GetStereoShift(), State.NearClip, State.FarClip));
+
+	// 在 View Uniform Buffer 构建前更新，UpdateViewMatrix 会一并刷新视锥剔除平面
+	InView.UpdateProjectionMatrix(ProjectionMatrix);
+	InView.ViewLocation = EyePosition;
+	InView.ViewRotation = FAsymmetricProjectionKernel::MakeViewRotation(State.Basis);
+	InView.UpdateViewMatrix();
+
+	SET_FLOAT_STAT(STAT_AsymmetricEyeAgeLateLatch, (Now - Sample.ReceiveTime) * 1000.0);
+	INC_DWORD_STAT(STAT_AsymmetricLateLatchUpdates);
+}
@@ -4,35 +4,82 @@
 
 #include "CoreMinimal.h"
 #include "SceneViewExtension.h"
+#include "AsymmetricCameraRegistry.h"
+#include "AsymmetricViewHistoryMap.h"
 
-class UAsymmetricCameraComponent;
+class FSceneViewStateInterface;
 
 /**
  * 场景视图扩展，把玩家相机的投影矩阵替换成离轴非对称投影。
  * 高性能路径：直接改主相机的投影，不需要 Render Target。
+ *
+ * 每个世界只有一个扩展实例，由 UAsymmetricCameraSubsystem 持有。每个 View 只在相机注册表里查一次：
+ * 运行时用活动相机，离线渲染（MRQ）按 View 的 Actor 找它自己的相机。
+ * 回调只读相机每帧发布的 FAsymmetricProjectionState 快照（和组件共享同一个双缓冲），
+ * 不解析弱指针、不访问 UObject，在渲染线程或并行 View 初始化里调用也是安全的。
+ *
+ * Late latch：眼睛来自追踪子系统时，游戏线程把投影输入快照发给渲染线程，
+ * PreRenderView_RenderThread 里重新读一次最新追踪采样，在 View Uniform Buffer 构建前重算投影和视图矩阵，
+ * 省掉游戏线程到渲染线程之间 1~2 帧的头部运动延迟。
  */
 class FAsymmetricViewExtension : public FWorldSceneViewExtension
 {
 public:
-	FAsymmetricViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld, UAsymmetricCameraComponent* InComponent);
+	FAsymmetricViewExtension(const FAutoRegister& AutoRegister, UWorld* InWorld,
+		const TSharedRef<const FAsymmetricCameraRegistry, ESPMode::ThreadSafe>& InRegistry);
+	virtual ~FAsymmetricViewExtension() override;
 
 	// ISceneViewExtension 接口
 	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
 	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
-	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override {}
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
 	virtual void SetupViewProjectionMatrix(FSceneViewProjectionData& InOutProjectionData) override;
+	virtual void PreRenderView_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView) override;
+
+protected:
+	/** 世界里没有登记任何相机时不参与渲染 */
+	virtual bool IsActiveThisFrame_Internal(const FSceneViewExtensionContext& Context) const override;
 
 private:
-	TWeakObjectPtr<UAsymmetricCameraComponent> CameraComponent;
+	/** 子系统维护的相机注册表，扩展只读（只在游戏线程访问） */
+	TSharedRef<const FAsymmetricCameraRegistry, ESPMode::ThreadSafe> Registry;
+
+	/**
+	 * Late latch 输入：每个被 SetupViewProjectionMatrix 覆盖过的 View 一份游戏线程所用的状态快照，整份拷给渲染线程。
+	 * 按 ViewState + StereoViewIndex 匹配，场景捕获等其他 View 不受影响；
+	 * 不同 View 可能来自不同相机（分屏、切换活动相机），所以状态跟着 View 走。
+	 */
+	struct FLateLatchInput
+	{
+		struct FView
+		{
+			const FSceneViewStateInterface* ViewState = nullptr;
+			int32 StereoViewIndex = INDEX_NONE;
+			FAsymmetricProjectionState State;
+			double GameThreadSampleTime = 0.0;      // 游戏线程所用追踪采样的接收时间
+		};
+		TArray<FView, TInlineAllocator<4>> Views;
+	};
+
+	/** 游戏线程：本帧正在收集的 late latch 输入 */
+	FLateLatchInput PendingLateLatch;
+
+	/** 游戏线程：SetupViewProjectionMatrix 刚覆盖的 View 的状态，等 SetupView 补上 View 标识 */
+	FLateLatchInput::FView PendingLateLatchView;
+
+	/** 游戏线程：SetupViewProjectionMatrix 刚覆盖了一个 View，等 SetupView 记下它的标识 */
+	bool bPendingLateLatchView = false;
+
+	/** 渲染线程：当前渲染的 ViewFamily 对应的 late latch 输入 */
+	FLateLatchInput LateLatch_RenderThread;
 
-	// 每眼前帧数据，用于立体运动模糊。
-	// 索引 0=左眼（或单目），索引 1=右眼。
-	// 固定 2 元素数组，不做堆分配，覆盖所有使用场景。
-	struct FPerEyePreviousData
+	// 每个 View 的前帧数据，用于运动模糊（立体左右眼、多相机各自独立）。
+	// 按 View 标识（ViewState / 立体索引）存在定长开放寻址表里，运行期不分配内存。
+	struct FViewPreviousData
 	{
 		bool bHasData = false;           // 是否有前帧数据（第一帧时为 false）
 		FVector EyePosition = FVector::ZeroVector;   // 前帧眼睛世界坐标
 		FRotator ViewRotation = FRotator::ZeroRotator; // 前帧视图旋转
 	};
-	FPerEyePreviousData PrevDataPerEye[2];
+	TAsymmetricViewHistoryMap<FViewPreviousData, 64> ViewHistory;
 };
@@ -0,0 +1,135 @@
+// 每个 View 的历史数据表：固定容量开放寻址哈希，不做堆分配
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * View 的稳定标识。
+ * ViewState 是每个玩家 / MRQ 每个相机独有的持久状态；同一个 ViewState 下再用立体 View 索引区分。
+ * 历史只用于离线渲染，多屏 View 不走这里（多屏模式不应用到 MRQ），所以不需要屏幕维度。
+ */
+struct FAsymmetricViewKey
+{
+	const void* ViewState = nullptr;
+	int32 StereoViewIndex = INDEX_NONE;
+
+	bool operator==(const FAsymmetricViewKey& Other) const
+	{
+		return ViewState == Other.ViewState && StereoViewIndex == Other.StereoViewIndex;
+	}
+
+	uint32 GetHash() const
+	{
+		return HashCombineFast(PointerHash(ViewState), ::GetTypeHash(StereoViewIndex));
+	}
+};
+
+/**
+ * 线性探测的定长哈希表，键是 FAsymmetricViewKey。
+ *
+ * - 所有槽位内嵌在对象里，运行期不分配内存。
+ * - 不支持删除：View 消失后它的槽位会逐渐变旧，超过 StaleFrames 帧没用过的槽位可以被新 View 复用
+ *   （在探测链上原地替换，不会打断其他键的探测链）。
+ * - 表满且没有过期槽位时，复用探测链上最久没用过的槽位。
+ */
+template <typename ValueType, int32 Capacity, uint64 StaleFrames = 120>
+class TAsymmetricViewHistoryMap
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	/**
+	 * 查找或插入。
+	 * @param FrameNumber  当前帧号，用来标记槽位最近使用时间
+	 * @param bOutAdded    新插入（或复用了旧槽位）时为 true，此时 Value 已重置为默认值
+	 * @param OutProbes    可选，返回本次探测的槽位数
+	 */
+	ValueType& FindOrAdd(const FAsymmetricViewKey& Key, uint64 FrameNumber, bool& bOutAdded, int32* OutProbes = nullptr)
+	{
+		const uint32 Start = Key.GetHash() & Mask;
+		int32 ReuseIndex = INDEX_NONE;     // 第一个空槽或过期槽
+		int32 OldestIndex = INDEX_NONE;    // 表满时的兜底：最久没用过的槽
+		int32 Probes = 0;
+
+		for (int32 Step = 0; Step < Capacity; ++Step)
+		{
+			const int32 Index = (Start + Step) & Mask;
+			FSlot& Slot = Slots[Index];
+			++Probes;
+
+			if (!Slot.bOccupied)
+			{
+				// 空槽说明键不在表里，探测链到此为止
+				if (ReuseIndex == INDEX_NONE)
+				{
+					ReuseIndex = Index;
+				}
+				break;
+			}
+
+			if (Slot.Key == Key)
+			{
+				Slot.LastUsedFrame = FrameNumber;
+				bOutAdded = false;
+				if (OutProbes)
+				{
+					*OutProbes = Probes;
+				}
+				return Slot.Value;
+			}
+
+			if (ReuseIndex == INDEX_NONE && FrameNumber - Slot.LastUsedFrame > StaleFrames)
+			{
+				ReuseIndex = Index;
+			}
+			if (OldestIndex == INDEX_NONE || Slot.LastUsedFrame < Slots[OldestIndex].LastUsedFrame)
+			{
+				OldestIndex = Index;
+			}
+		}
+
+		const int32 TargetIndex = (ReuseIndex != INDEX_NONE) ? ReuseIndex : OldestIndex;
+		FSlot& Target = Slots[TargetIndex];
+		NumOccupied += Target.bOccupied ? 0 : 1;
+		Target.bOccupied = true;
+		Target.Key = Key;
+		Target.LastUsedFrame = FrameNumber;
+		Target.Value = ValueType();
+
+		bOutAdded = true;
+		if (OutProbes)
+		{
+			*OutProbes = Probes;
+		}
+		return Target.Value;
+	}
+
+	/** 清空全部槽位 */
+	void Reset()
+	{
+		for (FSlot& Slot : Slots)
+		{
+			Slot = FSlot();
+		}
+		NumOccupied = 0;
+	}
+
+	int32 Num() const { return NumOccupied; }
+	static constexpr int32 GetCapacity() { return Capacity; }
+	static constexpr SIZE_T GetMemorySize() { return sizeof(FSlot) * Capacity; }
+
+private:
+	static constexpr uint32 Mask = Capacity - 1;
+
+	struct FSlot
+	{
+		FAsymmetricViewKey Key;
+		uint64 LastUsedFrame = 0;
+		bool bOccupied = false;
+		ValueType Value;
+	};
+
+	FSlot Slots[Capacity];
+	int32 NumOccupied = 0;
+};
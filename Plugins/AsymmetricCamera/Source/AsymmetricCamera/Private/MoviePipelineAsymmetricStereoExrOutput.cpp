@@ -0,0 +1,238 @@
+// MRQ 多视图 EXR 输出实现
+
+#include "MoviePipelineAsymmetricStereoExrOutput.h"
+#include "MoviePipelineAsymmetricStereoPass.h"
+#include "MoviePipeline.h"
+#include "MovieRenderPipelineDataTypes.h"
+#include "ImagePixelData.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+
+#if WITH_ASYMMETRIC_EXR
+THIRD_PARTY_INCLUDES_START
+#include "OpenEXR/ImfChannelList.h"
+#include "OpenEXR/ImfFrameBuffer.h"
+#include "OpenEXR/ImfHeader.h"
+#include "OpenEXR/ImfIO.h"
+#include "OpenEXR/ImfOutputFile.h"
+#include "OpenEXR/ImfStandardAttributes.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoExrOutput, Log, All);
+
+#if WITH_ASYMMETRIC_EXR
+namespace
+{
+	/** OpenEXR 输出流写进内存，最后一次性写盘（路径走 UE 的文件系统，支持非 ASCII 路径） */
+	class FAsymmetricExrMemoryStream : public Imf::OStream
+	{
+	public:
+		FAsymmetricExrMemoryStream() : Imf::OStream("") {}
+
+		virtual void write(const char Bytes[], int Count) override
+		{
+			const int64 End = Position + Count;
+			if (End > Data.Num())
+			{
+				Data.SetNumUninitialized(End, EAllowShrinking::No);
+			}
+			FMemory::Memcpy(Data.GetData() + Position, Bytes, Count);
+			Position = End;
+		}
+
+		virtual uint64_t tellp() override { return Position; }
+		virtual void seekp(uint64_t InPosition) override { Position = int64(InPosition); }
+
+		TArray64<uint8> Data;
+
+	private:
+		int64 Position = 0;
+	};
+
+	Imf::Compression ToExrCompression(EAsymmetricExrCompression InCompression)
+	{
+		switch (InCompression)
+		{
+		case EAsymmetricExrCompression::None: return Imf::NO_COMPRESSION;
+		case EAsymmetricExrCompression::RLE:  return Imf::RLE_COMPRESSION;
+		case EAsymmetricExrCompression::ZIPS: return Imf::ZIPS_COMPRESSION;
+		case EAsymmetricExrCompression::PIZ:  return Imf::PIZ_COMPRESSION;
+		case EAsymmetricExrCompression::DWAA: return Imf::DWAA_COMPRESSION;
+		default:                              return Imf::ZIP_COMPRESSION;
+		}
+	}
+
+	/** 把一只眼的 RGBA 四个通道加入通道表和帧缓冲；ChannelPrefix 为空表示默认视图 */
+	void AddEyeChannels(Imf::Header& Header, Imf::FrameBuffer& FrameBuffer, const FImagePixelData& Eye, const char* ChannelPrefix)
+	{
+		const void* RawData = nullptr;
+		int64 RawSize = 0;
+		Eye.GetRawData(RawData, RawSize);
+
+		const bool bHalf = Eye.GetType() == EImagePixelType::Float16;
+		const Imf::PixelType PixelType = bHalf ? Imf::HALF : Imf::FLOAT;
+		const size_t ChannelBytes = bHalf ? sizeof(FFloat16) : sizeof(float);
+		const size_t PixelBytes = ChannelBytes * 4;
+		const size_t RowBytes = PixelBytes * Eye.GetSize().X;
+
+		// FFloat16Color / FLinearColor 都是 R、G、B、A 顺序
+		static const char* const ChannelNames[] = { "R", "G", "B", "A" };
+		for (int32 Channel = 0; Channel < 4; ++Channel)
+		{
+			const std::string Name = std::string(ChannelPrefix) + ChannelNames[Channel];
+			Header.channels().insert(Name, Imf::Channel(PixelType));
+
+			char* Base = const_cast<char*>(static_cast<const char*>(RawData)) + ChannelBytes * Channel;
+			FrameBuffer.insert(Name, Imf::Slice(PixelType, Base, PixelBytes, RowBytes));
+		}
+	}
+
+	/** 编码一帧多视图 EXR 并写盘，可在任意线程调用 */
+	bool WriteMultiViewExr(const FString& InPath, const FImagePixelData& Left, const FImagePixelData& Right, Imf::Compression InCompression)
+	{
+		const FIntPoint Size = Left.GetSize();
+		try
+		{
+			Imf::Header Header(Size.X, Size.Y);
+			Header.compression() = InCompression;
+
+			// 默认视图（第一个）的通道不带前缀，其余视图的通道以 "<视图名>." 开头
+			Imf::StringVector Views;
+			Views.push_back("left");
+			Views.push_back("right");
+			Imf::addMultiView(Header, Views);
+
+			Imf::FrameBuffer FrameBuffer;
+			AddEyeChannels(Header, FrameBuffer, Left, "");
+			AddEyeChannels(Header, FrameBuffer, Right, "right.");
+
+			FAsymmetricExrMemoryStream Stream;
+			{
+				Imf::OutputFile File(Stream, Header, Imf::globalThreadCount());
+				File.setFrameBuffer(FrameBuffer);
+				File.writePixels(Size.Y);
+			}
+
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(InPath), /*Tree=*/true);
+			if (!FFileHelper::SaveArrayToFile(Stream.Data, *InPath))
+			{
+				UE_LOG(LogAsymmetricStereoExrOutput, Error, TEXT("Failed to write %s"), *InPath);
+				return false;
+			}
+			return true;
+		}
+		catch (const std::exception& Exception)
+		{
+			UE_LOG(LogAsymmetricStereoExrOutput, Error, TEXT("OpenEXR failed to encode %s: %s"), *InPath, UTF8_TO_TCHAR(Exception.what()));
+			return false;
+		}
+	}
+}
+#endif // WITH_ASYMMETRIC_EXR
+
+UMoviePipelineAsymmetricStereoExrOutput::FPendingWrites::FPendingWrites()
+{
+	WriteFinished = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+UMoviePipelineAsymmetricStereoExrOutput::FPendingWrites::~FPendingWrites()
+{
+	FPlatformProcess::ReturnSynchEventToPool(WriteFinished);
+}
+
+UMoviePipelineAsymmetricStereoExrOutput::UMoviePipelineAsymmetricStereoExrOutput()
+{
+	Compression = EAsymmetricExrCompression::ZIP;
+	MaxPendingWrites = 8;
+	PendingWrites = MakeShared<FPendingWrites, ESPMode::ThreadSafe>();
+}
+
+void UMoviePipelineAsymmetricStereoExrOutput::SetupForPipelineImpl(UMoviePipeline* InPipeline)
+{
+	Super::SetupForPipelineImpl(InPipeline);
+#if !WITH_ASYMMETRIC_EXR
+	UE_LOG(LogAsymmetricStereoExrOutput, Error, TEXT("%s: multi-view EXR output is not available on this platform, nothing will be written."), *GetName());
+#endif
+}
+
+void UMoviePipelineAsymmetricStereoExrOutput::OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame)
+{
+#if WITH_ASYMMETRIC_EXR
+	TArray<FStereoEyeImages, TInlineAllocator<4>> Passes;
+	if (!GetEyeImages(*InMergedOutputFrame, Passes))
+	{
+		return;
+	}
+
+	// 每个渲染 Pass 各写一个多视图 EXR，两眼只在同一 Pass 内配对
+	for (const FStereoEyeImages& Pass : Passes)
+	{
+		WritePassExr(InMergedOutputFrame->FrameOutputState, Pass);
+	}
+#endif
+}
+
+void UMoviePipelineAsymmetricStereoExrOutput::WritePassExr(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass)
+{
+#if WITH_ASYMMETRIC_EXR
+	const FImagePixelData* Left = InPass.Left;
+	const FImagePixelData* Right = InPass.Right;
+	if (Left->GetSize() != Right->GetSize() || Left->GetType() != Right->GetType() || Left->GetType() == EImagePixelType::Color)
+	{
+		UE_LOG(LogAsymmetricStereoExrOutput, Error,
+			TEXT("Pass '%s': eye images must be floating point and share size and format, skipping frame %d."),
+			*InPass.PassName, InFrameOutputState.OutputFrameNumber);
+		return;
+	}
+
+	// 后台积压太多时在这里等，限制每帧两眼拷贝占用的内存。
+	// 写完一帧就会触发事件；超时只是兜底，和 FFmpeg 流式写入的等待方式一致
+	while (PendingWrites->Count.GetValue() >= MaxPendingWrites)
+	{
+		PendingWrites->WriteFinished->Wait(100);
+	}
+
+	const FString OutputPath = ResolveFrameOutputPath(InFrameOutputState,
+		FString::Printf(TEXT("stereo_%s%s"), *GetShotName(InFrameOutputState.ShotIndex), *GetPassSuffix(InPass)), TEXT("exr"));
+
+	// 合并帧之后还要交给其他输出节点，这里拷一份带到后台
+	TSharedPtr<FImagePixelData, ESPMode::ThreadSafe> LeftCopy(Left->CopyImageData().Release());
+	TSharedPtr<FImagePixelData, ESPMode::ThreadSafe> RightCopy(Right->CopyImageData().Release());
+	const Imf::Compression ExrCompression = ToExrCompression(Compression);
+
+	PendingWrites->Count.Increment();
+	TFuture<bool> WriteFuture = Async(EAsyncExecution::ThreadPool,
+		[OutputPath, LeftCopy, RightCopy, ExrCompression, Pending = PendingWrites]()
+		{
+			const bool bWritten = WriteMultiViewExr(OutputPath, *LeftCopy, *RightCopy, ExrCompression);
+			Pending->Count.Decrement();
+			Pending->WriteFinished->Trigger();
+			return bWritten;
+		});
+
+	// 交给 MRQ 跟踪写盘进度：逐 Shot 刷盘和输出文件清单都依赖它
+	MoviePipeline::FMoviePipelineOutputFutureData OutputData;
+	const TArray<UMoviePipelineExecutorShot*>& Shots = GetPipeline()->GetActiveShotList();
+	OutputData.Shot = Shots.IsValidIndex(InFrameOutputState.ShotIndex) ? Shots[InFrameOutputState.ShotIndex] : nullptr;
+	OutputData.PassIdentifier = FMoviePipelinePassIdentifier(InPass.PassName);
+	OutputData.FilePath = OutputPath;
+
+	GetPipeline()->AddOutputFuture(MoveTemp(WriteFuture), OutputData);
+#endif
+}
+
+bool UMoviePipelineAsymmetricStereoExrOutput::HasFinishedProcessingImpl()
+{
+	return PendingWrites->Count.GetValue() == 0;
+}
+
+#if WITH_EDITOR
+FText UMoviePipelineAsymmetricStereoExrOutput::GetDisplayText() const
+{
+	return NSLOCTEXT("MovieRenderPipeline", "AsymmetricStereoExrOutput_DisplayName", "Asymmetric Stereo EXR (Multi-View)");
+}
+#endif
@@ -0,0 +1,135 @@
+// MRQ 立体图片输出实现
+
+#include "MoviePipelineAsymmetricStereoImageOutput.h"
+#include "MoviePipelineAsymmetricStereoPass.h"
+#include "AsymmetricFFmpegArgs.h"
+#include "AsymmetricStereoPacker.h"
+#include "MoviePipeline.h"
+#include "MoviePipelineImageQuantization.h"
+#include "MovieRenderPipelineDataTypes.h"
+#include "ImagePixelData.h"
+#include "ImageWriteQueue.h"
+#include "ImageWriteTask.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoImageOutput, Log, All);
+
+namespace
+{
+	EImageFormat ToImageFormat(EAsymmetricStereoImageFormat InFormat)
+	{
+		switch (InFormat)
+		{
+		case EAsymmetricStereoImageFormat::JPEG: return EImageFormat::JPEG;
+		case EAsymmetricStereoImageFormat::EXR:  return EImageFormat::EXR;
+		default:                                 return EImageFormat::PNG;
+		}
+	}
+
+	const TCHAR* GetExtension(EAsymmetricStereoImageFormat InFormat)
+	{
+		switch (InFormat)
+		{
+		case EAsymmetricStereoImageFormat::JPEG: return TEXT("jpeg");
+		case EAsymmetricStereoImageFormat::EXR:  return TEXT("exr");
+		default:                                 return TEXT("png");
+		}
+	}
+}
+
+UMoviePipelineAsymmetricStereoImageOutput::UMoviePipelineAsymmetricStereoImageOutput()
+{
+	ImageFormat = EAsymmetricStereoImageFormat::PNG;
+	JpegQuality = 95;
+}
+
+void UMoviePipelineAsymmetricStereoImageOutput::SetupForPipelineImpl(UMoviePipeline* InPipeline)
+{
+	Super::SetupForPipelineImpl(InPipeline);
+	ImageWriteQueue = &FModuleManager::Get().LoadModuleChecked<IImageWriteQueueModule>(TEXT("ImageWriteQueue")).GetWriteQueue();
+}
+
+void UMoviePipelineAsymmetricStereoImageOutput::OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame)
+{
+	TArray<FStereoEyeImages, TInlineAllocator<4>> Passes;
+	if (!GetEyeImages(*InMergedOutputFrame, Passes))
+	{
+		return;
+	}
+
+	// 每个渲染 Pass 各写一张打包图，两眼只在同一 Pass 内配对
+	for (const FStereoEyeImages& Pass : Passes)
+	{
+		WritePassImage(InMergedOutputFrame->FrameOutputState, Pass);
+	}
+}
+
+void UMoviePipelineAsymmetricStereoImageOutput::WritePassImage(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass)
+{
+	const EAsymmetricStereoLayout Layout = GetStereoPass()->StereoLayout;
+
+	// PNG / JPEG 先把两眼量化到 8 位 sRGB 再打包；EXR 直接打包浮点数据。
+	// 打包结果就是写盘任务的像素数据，入队后由写线程编码，不再拷贝。
+	TUniquePtr<FImagePixelData> Packed;
+	if (ImageFormat == EAsymmetricStereoImageFormat::EXR)
+	{
+		Packed = FAsymmetricStereoPacker::Pack(*InPass.Left, *InPass.Right, Layout);
+	}
+	else
+	{
+		const TUniquePtr<FImagePixelData> LeftQuantized  = UE::MoviePipeline::QuantizeImagePixelDataToBitDepth(InPass.Left, 8);
+		const TUniquePtr<FImagePixelData> RightQuantized = UE::MoviePipeline::QuantizeImagePixelDataToBitDepth(InPass.Right, 8);
+		if (LeftQuantized.IsValid() && RightQuantized.IsValid())
+		{
+			Packed = FAsymmetricStereoPacker::Pack(*LeftQuantized, *RightQuantized, Layout);
+		}
+	}
+
+	if (!Packed.IsValid())
+	{
+		UE_LOG(LogAsymmetricStereoImageOutput, Error, TEXT("Pass '%s': eye images differ in size or pixel format, skipping frame %d."),
+			*InPass.PassName, InFrameOutputState.OutputFrameNumber);
+		return;
+	}
+
+	const FString OutputPath = ResolveFrameOutputPath(InFrameOutputState, FString::Printf(TEXT("stereo_%s_%s%s"),
+		FAsymmetricFFmpegArgs::GetLayoutName(Layout), *GetShotName(InFrameOutputState.ShotIndex), *GetPassSuffix(InPass)),
+		GetExtension(ImageFormat));
+
+	TUniquePtr<FImageWriteTask> WriteTask = MakeUnique<FImageWriteTask>();
+	WriteTask->Format = ToImageFormat(ImageFormat);
+	WriteTask->CompressionQuality = (ImageFormat == EAsymmetricStereoImageFormat::JPEG) ? JpegQuality : (int32)EImageCompressionQuality::Default;
+	WriteTask->Filename = OutputPath;
+	WriteTask->bOverwriteFile = true;
+	WriteTask->PixelData = MoveTemp(Packed);
+
+	// 交给 MRQ 跟踪写盘进度：逐 Shot 刷盘和输出文件清单都依赖它
+	MoviePipeline::FMoviePipelineOutputFutureData OutputData;
+	const TArray<UMoviePipelineExecutorShot*>& Shots = GetPipeline()->GetActiveShotList();
+	OutputData.Shot = Shots.IsValidIndex(InFrameOutputState.ShotIndex) ? Shots[InFrameOutputState.ShotIndex] : nullptr;
+	OutputData.PassIdentifier = FMoviePipelinePassIdentifier(InPass.PassName);
+	OutputData.FilePath = OutputPath;
+
+	GetPipeline()->AddOutputFuture(ImageWriteQueue->Enqueue(MoveTemp(WriteTask)), OutputData);
+}
+
+void UMoviePipelineAsymmetricStereoImageOutput::BeginFinalizeImpl()
+{
+	if (ImageWriteQueue)
+	{
+		FinalizeFence = ImageWriteQueue->CreateFence();
+	}
+}
+
+bool UMoviePipelineAsymmetricStereoImageOutput::HasFinishedProcessingImpl()
+{
+	return !FinalizeFence.IsValid() || FinalizeFence.WaitFor(FTimespan::Zero());
+}
+
+#if WITH_EDITOR
+FText UMoviePipelineAsymmetricStereoImageOutput::GetDisplayText() const
+{
+	return NSLOCTEXT("MovieRenderPipeline", "AsymmetricStereoImageOutput_DisplayName", "Asymmetric Stereo Images");
+}
+#endif
@@ -0,0 +1,123 @@
+// MRQ 立体输出节点基类实现
+
+#include "MoviePipelineAsymmetricStereoOutputBase.h"
+#include "MoviePipelineAsymmetricStereoPass.h"
+#include "MoviePipeline.h"
+#include "MoviePipelineOutputSetting.h"
+#include "MoviePipelinePrimaryConfig.h"
+#include "MoviePipelineQueue.h"
+#include "MovieRenderPipelineDataTypes.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoOutputBase, Log, All);
+
+void UMoviePipelineAsymmetricStereoOutputBase::SetupForPipelineImpl(UMoviePipeline* InPipeline)
+{
+	StereoPass = InPipeline->GetPipelinePrimaryConfig()->FindSetting<UMoviePipelineAsymmetricStereoPass>();
+	if (!StereoPass.IsValid())
+	{
+		UE_LOG(LogAsymmetricStereoOutputBase, Warning,
+			TEXT("%s: no Asymmetric Stereo render pass in this job, nothing will be written."), *GetName());
+	}
+	else if (StereoPass->StereoLayout == EAsymmetricStereoLayout::None)
+	{
+		UE_LOG(LogAsymmetricStereoOutputBase, Warning,
+			TEXT("%s: the Asymmetric Stereo pass is set to Mono, nothing will be written."), *GetName());
+	}
+}
+
+void UMoviePipelineAsymmetricStereoOutputBase::TeardownForPipelineImpl(UMoviePipeline* InPipeline)
+{
+	StereoPass = nullptr;
+}
+
+bool UMoviePipelineAsymmetricStereoOutputBase::GetEyeImages(const FMoviePipelineMergerOutputFrame& InMergedOutputFrame,
+	TArray<FStereoEyeImages, TInlineAllocator<4>>& OutPasses) const
+{
+	OutPasses.Reset();
+	if (!StereoPass.IsValid() || StereoPass->StereoLayout == EAsymmetricStereoLayout::None)
+	{
+		return false;
+	}
+
+	// 眼别由立体 Pass 的相机名决定（已考虑 bSwapEyes），同一 Pass 名的两张图才配成一对
+	const FString& MainPassName = StereoPass->GetMainPassName();
+	for (const TPair<FMoviePipelinePassIdentifier, TUniquePtr<FImagePixelData>>& Pair : InMergedOutputFrame.ImageOutputData)
+	{
+		const bool bLeftEye  = Pair.Key.CameraName == TEXT("LeftEye");
+		const bool bRightEye = Pair.Key.CameraName == TEXT("RightEye");
+		if (!bLeftEye && !bRightEye)
+		{
+			continue;
+		}
+
+		FStereoEyeImages* Pass = OutPasses.FindByPredicate([&Pair](const FStereoEyeImages& Existing) { return Existing.PassName == Pair.Key.Name; });
+		if (!Pass)
+		{
+			Pass = &OutPasses.AddDefaulted_GetRef();
+			Pass->PassName = Pair.Key.Name;
+			Pass->bMainPass = (Pair.Key.Name == MainPassName);
+		}
+		(bLeftEye ? Pass->Left : Pass->Right) = Pair.Value.Get();
+	}
+
+	for (int32 Index = OutPasses.Num() - 1; Index >= 0; --Index)
+	{
+		if (!OutPasses[Index].Left || !OutPasses[Index].Right)
+		{
+			UE_LOG(LogAsymmetricStereoOutputBase, Warning, TEXT("%s: pass '%s' is missing one eye in frame %d, skipping it."),
+				*GetName(), *OutPasses[Index].PassName, InMergedOutputFrame.FrameOutputState.OutputFrameNumber);
+			OutPasses.RemoveAt(Index);
+		}
+	}
+
+	// 主画面在最前，其余 Pass 保持原有顺序
+	OutPasses.StableSort([](const FStereoEyeImages& A, const FStereoEyeImages& B) { return A.bMainPass && !B.bMainPass; });
+	return OutPasses.Num() > 0;
+}
+
+FString UMoviePipelineAsymmetricStereoOutputBase::GetPassSuffix(const FStereoEyeImages& InPass)
+{
+	return InPass.bMainPass ? FString() : TEXT("_") + InPass.PassName.Replace(TEXT(" "), TEXT("_"));
+}
+
+FString UMoviePipelineAsymmetricStereoOutputBase::ResolveOutputDirectory(const FMoviePipelineFrameOutputState& InFrameOutputState) const
+{
+	const UMoviePipelineOutputSetting* OutputSettings = GetPipeline()->GetPipelinePrimaryConfig()->FindSetting<UMoviePipelineOutputSetting>();
+	check(OutputSettings);
+
+	FString OutputDirectory;
+	FMoviePipelineFormatArgs FinalFormatArgs;
+	GetPipeline()->ResolveFilenameFormatArguments(OutputSettings->OutputDirectory.Path, TMap<FString, FString>(),
+		OutputDirectory, FinalFormatArgs, &InFrameOutputState);
+
+	if (FPaths::IsRelative(OutputDirectory))
+	{
+		OutputDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+	}
+	return OutputDirectory;
+}
+
+FString UMoviePipelineAsymmetricStereoOutputBase::GetShotName(int32 InShotIndex) const
+{
+	const TArray<UMoviePipelineExecutorShot*>& Shots = GetPipeline()->GetActiveShotList();
+	const UMoviePipelineExecutorShot* Shot = Shots.IsValidIndex(InShotIndex) ? Shots[InShotIndex] : nullptr;
+
+	FString ShotName = (Shot && !Shot->OuterName.IsEmpty())
+		? Shot->OuterName
+		: FString::Printf(TEXT("shot%02d"), InShotIndex);
+	ShotName.ReplaceInline(TEXT(" "), TEXT("_"));
+	return ShotName;
+}
+
+FString UMoviePipelineAsymmetricStereoOutputBase::ResolveFrameOutputPath(const FMoviePipelineFrameOutputState& InFrameOutputState,
+	const FString& InFileNamePrefix, const TCHAR* InExtension) const
+{
+	// 帧号交给 MRQ 解析，和逐眼输出的帧号、补零位数保持一致
+	FString FileName;
+	FMoviePipelineFormatArgs FinalFormatArgs;
+	GetPipeline()->ResolveFilenameFormatArguments(InFileNamePrefix + TEXT(".{frame_number}"), TMap<FString, FString>(),
+		FileName, FinalFormatArgs, &InFrameOutputState);
+
+	return FPaths::Combine(ResolveOutputDirectory(InFrameOutputState), FileName + TEXT(".") + InExtension);
+}
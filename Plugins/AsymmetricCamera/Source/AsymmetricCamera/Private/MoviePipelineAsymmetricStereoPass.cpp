@@ -2,121 +2,371 @@
 
 #include "MoviePipelineAsymmetricStereoPass.h"
 #include "AsymmetricCameraComponent.h"
+#include "AsymmetricCameraSubsystem.h"
+#include "AsymmetricProjectionKernel.h"
+#include "AsymmetricCameraStats.h"
+#include "AsymmetricCompositeManifest.h"
+#include "AsymmetricCompositeScheduler.h"
+#include "AsymmetricFFmpegArgs.h"
+#include "AsymmetricFFmpegProcess.h"
+#include "AsymmetricNativeCompositor.h"
+#include "MoviePipelineAsymmetricStereoOutputBase.h"
 #include "MoviePipeline.h"
 #include "MoviePipelineQueue.h"
 #include "MoviePipelineOutputSetting.h"
 #include "MoviePipelinePrimaryConfig.h"
 #include "MovieRenderPipelineDataTypes.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
 #include "GameFramework/PlayerController.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/Async.h"
+#include "Hash/xxhash.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoPass, Log, All);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Composite Shots Finished"), STAT_AsymmetricCompositeShotsFinished, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Composite Shots Failed"), STAT_AsymmetricCompositeShotsFailed, STATGROUP_AsymmetricCamera);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Composite Frames Encoded"), STAT_AsymmetricCompositeFramesEncoded, STATGROUP_AsymmetricCamera);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Composite MB Read"), STAT_AsymmetricCompositeMBRead, STATGROUP_AsymmetricCamera);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Composite MB Written"), STAT_AsymmetricCompositeMBWritten, STATGROUP_AsymmetricCamera);
+
 namespace
 {
-	// 获取 FFmpeg 编码器名称字符串
-	FString GetFFmpegCodecString(EFFmpegVideoCodec InCodec)
+	constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+	/** 输出版本的文件名主干：stereo_<布局>_<Shot>，额外版本再加 _<后缀> */
+	FString GetTargetBaseName(const FShotCompositeRecord& Record, int32 TargetIndex)
 	{
-		switch (InCodec)
+		const FAsymmetricCompositeOutputTarget& Target = Record.Targets[TargetIndex];
+		FString BaseName = FString::Printf(TEXT("stereo_%s_%s"), FAsymmetricFFmpegArgs::GetLayoutName(Target.Layout), *Record.ShotName);
+		if (!Target.Suffix.IsEmpty())
 		{
-		case EFFmpegVideoCodec::H264: return TEXT("libx264");
-		case EFFmpegVideoCodec::H265: return TEXT("libx265");
-		default:                      return TEXT("libx264");
+			BaseName += TEXT("_") + Target.Suffix;
 		}
+		return BaseName;
+	}
+
+	/** 图片序列合成输出第 FrameIndex 个配对帧的路径：<主干>_<帧号>.<源扩展名>，帧号从 StartFrameNumber 连续递增 */
+	FString GetStereoImageOutputPath(const FShotCompositeRecord& Record, int32 TargetIndex, int32 FrameIndex)
+	{
+		return FPaths::Combine(Record.OutputDir, FString::Printf(TEXT("%s_%05d%s"),
+			*GetTargetBaseName(Record, TargetIndex), Record.StartFrameNumber + FrameIndex, *Record.LeftEye.GetExtension()));
 	}
 
-	// 获取输出容器格式字符串（H.265 强制 MKV）
-	FString GetFFmpegFormatString(EFFmpegOutputFormat InFormat)
+	/** 报告和汇总日志里的状态 */
+	const TCHAR* GetCompositeStatusName(const FShotCompositeRecord& Record)
 	{
-		switch (InFormat)
+		if (!Record.bCompositeFinished)
 		{
-		case EFFmpegOutputFormat::MP4: return TEXT("mp4");
-		case EFFmpegOutputFormat::MOV: return TEXT("mov");
-		case EFFmpegOutputFormat::MKV: return TEXT("mkv");
-		case EFFmpegOutputFormat::AVI: return TEXT("avi");
-		default:                       return TEXT("mp4");
+			return TEXT("skipped");
 		}
+		if (Record.bSkippedUnchanged)
+		{
+			return TEXT("unchanged");
+		}
+		return Record.bCompositeSucceeded ? TEXT("ok") : TEXT("failed");
+	}
+
+	/** Video 模式的输出文件 */
+	FString GetStereoVideoOutputPath(const FShotCompositeRecord& Record, int32 TargetIndex)
+	{
+		const FAsymmetricCompositeOutputTarget& Target = Record.Targets[TargetIndex];
+		return FPaths::Combine(Record.OutputDir, FString::Printf(TEXT("%s.%s"),
+			*GetTargetBaseName(Record, TargetIndex), *FAsymmetricFFmpegArgs::GetOutputFormat(Target.VideoCodec, Target.OutputFormat)));
 	}
 
-	// 获取像素格式（固定 yuv420p，兼容最广）
-	FString GetFFmpegPixFmtForCodec(EFFmpegVideoCodec /*InCodec*/)
+	/** 清单里一个输出版本的名字：视频为文件名，图片序列为文件名主干（不含帧号） */
+	FString GetTargetOutputName(const FShotCompositeRecord& Record, int32 TargetIndex, bool bVideo)
 	{
-		return TEXT("yuv420p");
+		return bVideo ? FPaths::GetCleanFilename(GetStereoVideoOutputPath(Record, TargetIndex)) : GetTargetBaseName(Record, TargetIndex);
 	}
 
-	// 获取视频质量参数字符串
-	// -preset slow：慢速编码，相同 CRF 下压缩率更高、质量更好
-	FString GetFFmpegQualityArgs(EFFmpegVideoCodec /*InCodec*/, int32 InCRF)
+	/** 一个输出版本在磁盘上的文件数和字节数；图片序列逐帧统计，缺的帧不计数。逐个 stat，在后台线程调用 */
+	FAsymmetricCompositeManifest::FOutput MeasureTargetOutput(const FShotCompositeRecord& Record, int32 TargetIndex, bool bVideo)
 	{
-		return FString::Printf(TEXT("-crf %d -preset slow"), InCRF);
+		IFileManager& FileManager = IFileManager::Get();
+		FAsymmetricCompositeManifest::FOutput Output;
+		Output.Name = GetTargetOutputName(Record, TargetIndex, bVideo);
+		if (bVideo)
+		{
+			const int64 Size = FileManager.FileSize(*GetStereoVideoOutputPath(Record, TargetIndex));
+			Output.NumFiles = (Size >= 0) ? 1 : 0;
+			Output.Bytes = FMath::Max<int64>(0, Size);
+			return Output;
+		}
+
+		for (int32 Index = 0; Index < Record.GetNumFramePairs(); ++Index)
+		{
+			const int64 Size = FileManager.FileSize(*GetStereoImageOutputPath(Record, TargetIndex, Index));
+			Output.NumFiles += (Size >= 0) ? 1 : 0;
+			Output.Bytes += FMath::Max<int64>(0, Size);
+		}
+		return Output;
 	}
 
-	// 获取立体 3D 元数据参数
-	// H.264：嵌入 Frame Packing SEI；H.265：使用 MKV 容器 stereo_mode 元数据
-	FString GetStereoMetadataArgs(EFFmpegVideoCodec InCodec, EAsymmetricStereoLayout InLayout)
+	/** 输入帧内容抽样：文件头一块（EXR 的头和偏移表都在这里）加上均匀分布的若干小块 */
+	constexpr int64 CompositeInputHeaderBytes = 64 * 1024;
+	constexpr int64 CompositeInputSampleBytes = 4 * 1024;
+	constexpr int32 CompositeInputNumSamples = 16;
+
+	/** 把一个输入文件的大小和内容抽样写进摘要；文件打不开时只记大小 -1 */
+	void HashCompositeInputFile(FXxHash64Builder& Builder, const FString& FilePath, TArray<uint8>& Buffer)
 	{
-		switch (InCodec)
+		TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		const int64 Size = Handle ? Handle->Size() : -1;
+		Builder.Update(*FilePath, FilePath.Len() * sizeof(TCHAR));
+		Builder.Update(&Size, sizeof(Size));
+		if (!Handle || Size <= 0)
 		{
-		case EFFmpegVideoCodec::H264:
+			return;
+		}
+
+		const auto HashBlock = [&Builder, &Buffer, &Handle, Size](int64 Offset, int64 Bytes)
+		{
+			Bytes = FMath::Min(Bytes, Size - Offset);
+			Buffer.SetNumUninitialized(int32(Bytes), EAllowShrinking::No);
+			if (Bytes > 0 && Handle->Seek(Offset) && Handle->Read(Buffer.GetData(), Bytes))
 			{
-				// Frame Packing Arrangement SEI: type 3=SBS, type 4=TB，VLC/PotPlayer 可自动识别
-				const int32 FramePackingType = (InLayout == EAsymmetricStereoLayout::SideBySide) ? 3 : 4;
-				return FString::Printf(TEXT("-x264-params frame-packing=%d"), FramePackingType);
+				Builder.Update(Buffer.GetData(), Bytes);
 			}
-		case EFFmpegVideoCodec::H265:
+		};
+
+		HashBlock(0, CompositeInputHeaderBytes);
+		if (Size > CompositeInputHeaderBytes)
+		{
+			const int64 Span = Size - CompositeInputHeaderBytes;
+			for (int32 Sample = 0; Sample < CompositeInputNumSamples; ++Sample)
 			{
-				// x265 不支持 frame-packing CLI 参数，改用 MKV 容器的 stereo_mode 元数据
-				const TCHAR* StereoMode = (InLayout == EAsymmetricStereoLayout::SideBySide)
-					? TEXT("side_by_side_left") : TEXT("top_bottom_left");
-				return FString::Printf(TEXT("-metadata:s:v stereo_mode=%s"), StereoMode);
+				HashBlock(CompositeInputHeaderBytes + Span * Sample / CompositeInputNumSamples, CompositeInputSampleBytes);
 			}
-		default:
-			return FString();
 		}
 	}
 
-	// 获取最终输出格式（H.265 强制使用 MKV 以支持 stereo_mode 元数据）
-	FString GetOutputFormat(EFFmpegVideoCodec InCodec, EFFmpegOutputFormat InFormat)
+	/**
+	 * 参与合成的两眼帧的摘要：帧号区间，每帧的路径、大小和内容抽样（文件头 + 16 个均匀分布的 4 KB 块）。
+	 * 不含修改时间：MRQ 每次导出都会重写源帧，带上修改时间的话重新渲染过的 Shot 永远不会被跳过；
+	 * 未压缩格式（EXR、BMP 等）重新渲染后大小不变，靠内容抽样认出画面变了。
+	 * 只改动了抽样块之间一小片像素的重新渲染检测不到，需要时关掉 bSkipUnchangedShots 或删掉清单强制重做。
+	 */
+	uint64 HashCompositeInputs(const FShotCompositeRecord& Record)
 	{
-		if (InCodec == EFFmpegVideoCodec::H265)
+		FXxHash64Builder Builder;
+		for (const FAsymmetricFrameRange& Range : Record.Frames.Ranges)
 		{
-			return TEXT("mkv");
+			Builder.Update(&Range.First, sizeof(Range.First));
+			Builder.Update(&Range.Last, sizeof(Range.Last));
 		}
-		return GetFFmpegFormatString(InFormat);
+
+		TArray<uint8> Buffer;
+		Buffer.Reserve(int32(CompositeInputHeaderBytes));
+		Record.Frames.ForEachFrame([&Record, &Builder, &Buffer](int32 Index, int32 Frame)
+		{
+			HashCompositeInputFile(Builder, Record.LeftEye.GetFramePath(Frame), Buffer);
+			HashCompositeInputFile(Builder, Record.RightEye.GetFramePath(Frame), Buffer);
+		});
+		return Builder.Finalize().Hash;
 	}
 
-	/** 解析 FFmpeg 可执行文件路径。
-	 *  始终转换为绝对路径，处理编辑器 FFilePath 属性可能存储相对路径的情况。
-	 *  路径为空时回退到系统 PATH 中的 ffmpeg。 */
-	FString ResolveFFmpegPath(const FFilePath& UserPath)
+	/**
+	 * 和清单条目比对，返回需要重新合成的原因；输入、设置和输出都和条目一致时返回 nullptr。
+	 * 读输入内容、stat 输出文件，在后台线程调用。
+	 */
+	const TCHAR* GetCompositeOutdatedReason(const FShotCompositeRecord& Record, uint64 InputHash,
+		const FAsymmetricCompositeManifest::FEntry* Entry, bool bVideo)
 	{
-		if (UserPath.FilePath.IsEmpty())
+		if (!Entry)
 		{
-			UE_LOG(LogAsymmetricStereoPass, Warning,
-				TEXT("FFmpegPath is empty — falling back to system PATH. "
-				     "Set an absolute path in the pass settings to avoid this."));
-			return TEXT("ffmpeg");
+			return TEXT("the shot is not in the composite manifest");
+		}
+		if (Entry->State != FAsymmetricCompositeManifest::EState::Complete)
+		{
+			return TEXT("the previous composite did not finish and left incomplete output");
+		}
+		if (Entry->InputHash != InputHash)
+		{
+			return TEXT("input frames changed");
+		}
+		if (Entry->SettingsHash != Record.SettingsHash)
+		{
+			return TEXT("composite settings changed");
+		}
+		if (Entry->Outputs.Num() != Record.Targets.Num())
+		{
+			return TEXT("output targets changed");
 		}
 
-		// 确保路径始终是绝对路径，与编辑器存储方式无关
-		FString Resolved = UserPath.FilePath;
-		if (FPaths::IsRelative(Resolved))
+		// 输出被删、被截断或被改写过都要重做
+		for (int32 TargetIndex = 0; TargetIndex < Record.Targets.Num(); ++TargetIndex)
 		{
-			Resolved = FPaths::ConvertRelativePathToFull(Resolved);
-			UE_LOG(LogAsymmetricStereoPass, Warning,
-				TEXT("FFmpegPath was relative, resolved to absolute: %s"), *Resolved);
+			if (!(MeasureTargetOutput(Record, TargetIndex, bVideo) == Entry->Outputs[TargetIndex]))
+			{
+				return TEXT("output files are missing or were modified");
+			}
+		}
+		return nullptr;
+	}
+
+	/** Shot 结束时磁盘上的源文件字节数和每个输出版本的文件数、字节数 */
+	struct FShotFileStats
+	{
+		int64 BytesRead = 0;
+		TArray<FShotOutputFiles> Outputs;
+	};
+
+	/** 只统计参与合成的帧，缺帧一侧多出来的文件没有被读取。逐个 stat，在后台线程调用 */
+	FShotFileStats MeasureShotFiles(const FShotCompositeRecord& Record, bool bVideo)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		FShotFileStats Stats;
+		Record.Frames.ForEachFrame([&Record, &Stats, &FileManager](int32 Index, int32 Frame)
+		{
+			Stats.BytesRead += FMath::Max<int64>(0, FileManager.FileSize(*Record.LeftEye.GetFramePath(Frame)));
+			Stats.BytesRead += FMath::Max<int64>(0, FileManager.FileSize(*Record.RightEye.GetFramePath(Frame)));
+		});
+
+		for (int32 TargetIndex = 0; TargetIndex < Record.Targets.Num(); ++TargetIndex)
+		{
+			const FAsymmetricCompositeManifest::FOutput Output = MeasureTargetOutput(Record, TargetIndex, bVideo);
+			Stats.Outputs.Add({ Output.NumFiles, Output.Bytes });
+		}
+		return Stats;
+	}
+
+	/** 把一个 FFmpeg 任务的计量累加到 Shot；bCountFrames 为 false 的任务（stream copy 拼接）不计编码帧数 */
+	void AccumulateJobTelemetry(FShotCompositeRecord& Record, const FAsymmetricCompositeScheduler::FJobResult& Result, bool bCountFrames)
+	{
+		if (!Result.bLaunched)
+		{
+			return;
 		}
+		Record.Telemetry.NoteStart(Result.StartTime);
+		Record.Telemetry.CpuSeconds += Result.CpuSeconds;
+		if (bCountFrames && Result.Progress.bValid)
+		{
+			Record.Telemetry.FramesEncoded += Result.Progress.Frame;
+		}
+	}
+
+	/**
+	 * 把一条 FFmpeg 命令交给进程池。参数向量直接传给进程，不经过 shell，也不写 bat / 日志文件；
+	 * FFmpeg 的输出由进程池从管道读出，结束时随 FJobResult::Log 一起回调。
+	 */
+	void EnqueueFFmpegJob(FAsymmetricCompositeScheduler& Scheduler, const FShotCompositeRecord& Record,
+		const FString& FFmpegExe, TArray<FString>&& Args, const FString& JobTag,
+		TFunction<void(const FAsymmetricCompositeScheduler::FJobResult&)>&& OnCompleted)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Log,
+			TEXT("Queued FFmpeg for shot '%s%s':\n  %s %s"), *Record.ShotName, *JobTag, *FFmpegExe,
+			*FAsymmetricFFmpegProcess::BuildCommandLine(Args));
+
+		FAsymmetricCompositeScheduler::FJob Job;
+		Job.Name = Record.ShotName + JobTag;
+		Job.Executable = FFmpegExe;
+		Job.Arguments = MoveTemp(Args);
+		Job.OnCompleted = MoveTemp(OnCompleted);
+		Scheduler.Enqueue(MoveTemp(Job));
+	}
 
-		FPaths::NormalizeFilename(Resolved);
-		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Using FFmpeg: %s"), *Resolved);
-		return Resolved;
+	/**
+	 * 滤镜图：每个输出版本一路 hstack / vstack（可选缩放），输出标签为 [v0] [v1] ...
+	 * 多个版本时两眼各 split 成多路，眼图仍只解码一次。
+	 */
+	FString BuildStereoFilterGraph(const TArray<FAsymmetricCompositeOutputTarget>& Targets)
+	{
+		const int32 NumTargets = Targets.Num();
+		FString Graph;
+		if (NumTargets > 1)
+		{
+			Graph += FString::Printf(TEXT("[0:v]split=%d"), NumTargets);
+			for (int32 Index = 0; Index < NumTargets; ++Index)
+			{
+				Graph += FString::Printf(TEXT("[l%d]"), Index);
+			}
+			Graph += FString::Printf(TEXT(";[1:v]split=%d"), NumTargets);
+			for (int32 Index = 0; Index < NumTargets; ++Index)
+			{
+				Graph += FString::Printf(TEXT("[r%d]"), Index);
+			}
+			Graph += TEXT(";");
+		}
+
+		for (int32 Index = 0; Index < NumTargets; ++Index)
+		{
+			const FAsymmetricCompositeOutputTarget& Target = Targets[Index];
+			const FString Left  = (NumTargets > 1) ? FString::Printf(TEXT("[l%d]"), Index) : FString(TEXT("[0:v]"));
+			const FString Right = (NumTargets > 1) ? FString::Printf(TEXT("[r%d]"), Index) : FString(TEXT("[1:v]"));
+			Graph += FString::Printf(TEXT("%s%s%s=inputs=2:shortest=1"), *Left, *Right,
+				(Target.Layout == EAsymmetricStereoLayout::TopBottom) ? TEXT("vstack") : TEXT("hstack"));
+			if (Target.IsScaled())
+			{
+				// yuv420p 要求偶数尺寸
+				Graph += FString::Printf(TEXT(",scale=trunc(iw*%g/2)*2:trunc(ih*%g/2)*2"), Target.Scale, Target.Scale);
+			}
+			Graph += FString::Printf(TEXT("[v%d]"), Index);
+			if (Index + 1 < NumTargets)
+			{
+				Graph += TEXT(";");
+			}
+		}
+		return Graph;
+	}
+
+	/** 左右眼两个 concat 输入加滤镜图，合成 Shot 和合成分段共用 */
+	void AppendStereoConcatInputs(TArray<FString>& Args, const FString& FrameRate,
+		const FString& LeftListPath, const FString& RightListPath, const TArray<FAsymmetricCompositeOutputTarget>& Targets)
+	{
+		// concat demuxer 不支持 -framerate，帧率用 -r 在输入端指定，输出端每个输出各自再给一次
+		Args.Append({
+			TEXT("-y"),
+			TEXT("-r"), FrameRate, TEXT("-f"), TEXT("concat"), TEXT("-safe"), TEXT("0"), TEXT("-i"), LeftListPath,
+			TEXT("-r"), FrameRate, TEXT("-f"), TEXT("concat"), TEXT("-safe"), TEXT("0"), TEXT("-i"), RightListPath,
+			TEXT("-filter_complex"), BuildStereoFilterGraph(Targets) });
+	}
+
+	/** 一个输出的开头：取滤镜图的第 TargetIndex 路，输出选项只对紧随其后的输出文件生效 */
+	void AppendOutputMap(TArray<FString>& Args, int32 TargetIndex, const FString& FrameRate)
+	{
+		Args.Append({ TEXT("-map"), FString::Printf(TEXT("[v%d]"), TargetIndex), TEXT("-r"), FrameRate });
+	}
+
+	/**
+	 * 一个进程里每个输出的 -threads。-threads 是输出选项，每个输出各自起一组编码线程，
+	 * 所以把每进程的线程预算平分给各个输出，进程总线程数才和自动并发数的估算一致。
+	 */
+	int32 GetThreadsPerTarget(int32 ThreadsPerProcess, int32 NumTargets)
+	{
+		return (ThreadsPerProcess > 0) ? FMath::Max(ThreadsPerProcess / FMath::Max(NumTargets, 1), 1) : 0;
+	}
+
+	/**
+	 * 一个视频输出的编码参数。
+	 * @param GopFrames          - 大于 0 时固定 GOP（分段编码）
+	 * @param bContainerMetadata - 是否同时写容器级立体元数据；分段编码时留到拼接那一步写
+	 */
+	void AppendVideoEncodeArgs(TArray<FString>& Args, const FAsymmetricCompositeOutputTarget& Target, int32 Threads,
+		int32 GopFrames, bool bContainerMetadata)
+	{
+		Args.Append({ TEXT("-c:v"), FAsymmetricFFmpegArgs::GetCodecString(Target.VideoCodec) });
+		FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetQualityArgs(Target.VideoCodec, Target.Quality));
+		Args.Append({ TEXT("-pix_fmt"), FAsymmetricFFmpegArgs::GetPixFmt(Target.VideoCodec) });
+		if (GopFrames > 0)
+		{
+			FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetFixedGopArgs(Target.VideoCodec, GopFrames));
+		}
+		FAsymmetricFFmpegArgs::Append(Args, bContainerMetadata
+			? FAsymmetricFFmpegArgs::GetStereoMetadataArgs(Target.VideoCodec, Target.Layout)
+			: FAsymmetricFFmpegArgs::GetStereoEncoderArgs(Target.VideoCodec, Target.Layout));
+		// 限制单个编码器的线程数，多个 Shot 并行时才不会互相抢核
+		FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetThreadsArg(Threads));
 	}
 }
 
@@ -136,68 +386,240 @@ UMoviePipelineAsymmetricStereoPass::UMoviePipelineAsymmetricStereoPass()
 	CompositeQuality = 18;
 	OutputFormat   = EFFmpegOutputFormat::MP4;
 	bDeleteSourceAfterComposite = true;
+	bCompositeDuringRender = true;
+	bUseNativeImageCompositor = true;
+	bSegmentedVideoEncode = true;
+	SegmentLengthFrames = 480;
 	bDebugSaveConcatFiles = false;
-	// FFmpegPath 默认留空，用户必须在 Pass 设置里填写绝对路径（或留空使用系统 PATH）
+	bWriteCompositeReport = true;
+	bSkipUnchangedShots = true;
+	MaxConcurrentComposites = 0;
+	FFmpegThreadsPerProcess = 8;
+	// FFmpegPath 默认留空：合成时在系统 PATH 里查找 ffmpeg 的绝对路径，找不到则合成失败并报错；也可以在 Pass 设置里填写绝对路径
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
 // MRQ 生命周期
 // ─────────────────────────────────────────────────────────────────────────────
 
+UAsymmetricCameraComponent* UMoviePipelineAsymmetricStereoPass::ResolveCameraComponent() const
+{
+	UWorld* World = GetWorld();
+	const UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr;
+
+	// 显式绑定的 Actor：配置资产里存的是编辑器关卡的路径，渲染在 PIE 世界里时要换成 PIE 副本的路径
+	if (!CameraActor.IsNull())
+	{
+		FSoftObjectPath ActorPath = CameraActor.ToSoftObjectPath();
+#if WITH_EDITOR
+		ActorPath.FixupForPIE();
+#endif
+		const AActor* Actor = Cast<AActor>(ActorPath.ResolveObject());
+		if (UAsymmetricCameraComponent* Comp = Actor ? Actor->FindComponentByClass<UAsymmetricCameraComponent>() : nullptr)
+		{
+			return Comp;
+		}
+		UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("Camera Actor %s is not loaded or has no AsymmetricCameraComponent."), *ActorPath.ToString());
+	}
+
+	if (!Subsystem)
+	{
+		return nullptr;
+	}
+
+	if (!CameraTag.IsNone())
+	{
+		if (UAsymmetricCameraComponent* Comp = Subsystem->FindCameraByTag(CameraTag))
+		{
+			return Comp;
+		}
+		UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("No AsymmetricCameraComponent tagged '%s'."), *CameraTag.ToString());
+	}
+
+	// 没有显式绑定：当前镜头的相机，再否则最先登记的
+	if (UAsymmetricCameraComponent* Comp = Subsystem->GetActiveCamera())
+	{
+		return Comp;
+	}
+	const TArray<UAsymmetricCameraComponent*> Cameras = Subsystem->GetCameras();
+	return (Cameras.Num() > 0) ? Cameras[0] : nullptr;
+}
+
 void UMoviePipelineAsymmetricStereoPass::SetupImpl(const MoviePipeline::FMoviePipelineRenderPassInitSettings& InPassInitSettings)
 {
 	Super::SetupImpl(InPassInitSettings);
 
-	CachedCameraComponent = nullptr;
-	UWorld* World = GetWorld();
-	if (World)
+	CachedCameraComponent = ResolveCameraComponent();
+	if (UAsymmetricCameraComponent* Comp = CachedCameraComponent.Get())
 	{
-		for (TActorIterator<AActor> It(World); It; ++It)
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Found AsymmetricCameraComponent on actor: %s"), *GetNameSafe(Comp->GetOwner()));
+
+		// 显式绑定的相机固定为活动相机，视图扩展和这里算眼睛偏移用的是同一台
+		UWorld* World = GetWorld();
+		UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr;
+		if (Subsystem && (!CameraActor.IsNull() || !CameraTag.IsNone()))
 		{
-			UAsymmetricCameraComponent* Comp = It->FindComponentByClass<UAsymmetricCameraComponent>();
-			if (Comp)
-			{
-				CachedCameraComponent = Comp;
-				UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Found AsymmetricCameraComponent on actor: %s"), *It->GetName());
-				break;
-			}
+			PreviousPinnedCamera = Subsystem->GetPinnedCamera();
+			Subsystem->SetActiveCamera(Comp);
+			bPinnedCamera = true;
 		}
 	}
-
-	if (!CachedCameraComponent.IsValid())
+	else
 	{
 		UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("No AsymmetricCameraComponent found in scene. Stereo eye offset will use camera right vector only."));
 	}
 
-	// Reset composite state for this render session
-	CompositeQueue.Reset();
-	TempConcatFiles.Reset();
-	CurrentCompositeIndex = 0;
-	bExportFinished = true;
+	// Render Pass 每个 Shot 都会 Setup / Teardown 一次，合成状态要跨 Shot 保留，
+	// 只在新的一次渲染开始时重置
+	UMoviePipeline* Pipeline = GetPipeline();
+	if (Pipeline != BoundPipeline.Get())
+	{
+		ResetCompositeState();
+		BoundPipeline = Pipeline;
+		BindShotWorkFinished();
+	}
 }
 
 void UMoviePipelineAsymmetricStereoPass::TeardownImpl()
 {
+	UWorld* World = GetWorld();
+	UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr;
+	if (bPinnedCamera)
+	{
+		if (Subsystem)
+		{
+			Subsystem->SetActiveCamera(PreviousPinnedCamera.Get());
+		}
+		PreviousPinnedCamera = nullptr;
+		bPinnedCamera = false;
+	}
 	CachedCameraComponent = nullptr;
+
+	// Tile 区域只在本 Pass 的 View 计算期间有效，ViewState 随 Pass 释放后地址可能被复用
+	if (Subsystem)
+	{
+		Subsystem->ClearOfflineRenderTiles();
+	}
+
+	// Shot 之间的 Teardown 不能打断渲染期间已经开始的合成；只有渲染被取消时才终止 FFmpeg
+	UMoviePipeline* Pipeline = GetPipeline();
+	if (Pipeline && Pipeline->IsShutdownRequested())
+	{
+		ResetCompositeState();
+	}
 	Super::TeardownImpl();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-// 导出生命周期（渲染完成后调用 FFmpeg 合成）
+// 合成生命周期（Shot 写盘完成后即可开始合成，BeginExportImpl 只补齐剩余 Shot）
 // ─────────────────────────────────────────────────────────────────────────────
 
-void UMoviePipelineAsymmetricStereoPass::BuildCompositeQueue()
+void UMoviePipelineAsymmetricStereoPass::ResetCompositeState()
+{
+	UnbindShotWorkFinished();
+	BoundPipeline = nullptr;
+
+	// 析构进程池会终止仍在运行的 FFmpeg
+	CompositeScheduler.Reset();
+	CompositeQueue.Reset();
+	QueuedShots.Reset();
+	CompositeManifests.Reset();
+
+	// 进程内合成没法中途杀掉，置位取消标记让它跳过剩余帧，回调时按标记丢弃结果
+	if (NativeCompositeCancelFlag.IsValid())
+	{
+		*NativeCompositeCancelFlag = true;
+	}
+	NativeCompositeCancelFlag = MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(false);
+	NativeCompositeQueue.Reset();
+	bNativeCompositeRunning = false;
+	NumPendingFileTasks = 0;
+
+	NumCompositesFinished = 0;
+	TotalFramesEncoded = 0;
+	TotalBytesRead = 0;
+	TotalBytesWritten = 0;
+	bExportFinished = true;
+
+	SET_DWORD_STAT(STAT_AsymmetricCompositeShotsFinished, 0);
+	SET_DWORD_STAT(STAT_AsymmetricCompositeShotsFailed, 0);
+	SET_DWORD_STAT(STAT_AsymmetricCompositeFramesEncoded, 0);
+	SET_FLOAT_STAT(STAT_AsymmetricCompositeMBRead, 0.0f);
+	SET_FLOAT_STAT(STAT_AsymmetricCompositeMBWritten, 0.0f);
+}
+
+void UMoviePipelineAsymmetricStereoPass::BindShotWorkFinished()
+{
+	UMoviePipeline* Pipeline = BoundPipeline.Get();
+	if (!Pipeline || !bCompositeDuringRender || HasStereoOutputNode()
+		|| CompositeMode == EAsymmetricCompositeMode::Disabled || StereoLayout == EAsymmetricStereoLayout::None)
+	{
+		return;
+	}
+
+	// 只有逐 Shot 刷盘时，Shot 完成回调触发时该 Shot 的所有帧才保证已经写完
+	const UMoviePipelineOutputSetting* OutputSetting = Pipeline->GetPipelinePrimaryConfig()->FindSetting<UMoviePipelineOutputSetting>();
+	if (!OutputSetting || !OutputSetting->bFlushDiskWritesPerShot)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Warning,
+			TEXT("bCompositeDuringRender requires 'Flush Disk Writes Per Shot' in the Output settings; "
+			     "shots will be composited after the whole render instead."));
+		return;
+	}
+
+	ShotWorkFinishedHandle = Pipeline->OnMoviePipelineShotWorkFinished().AddUObject(
+		this, &UMoviePipelineAsymmetricStereoPass::OnShotWorkFinished);
+}
+
+void UMoviePipelineAsymmetricStereoPass::UnbindShotWorkFinished()
+{
+	if (UMoviePipeline* Pipeline = BoundPipeline.Get())
+	{
+		Pipeline->OnMoviePipelineShotWorkFinished().Remove(ShotWorkFinishedHandle);
+	}
+	ShotWorkFinishedHandle.Reset();
+}
+
+void UMoviePipelineAsymmetricStereoPass::OnShotWorkFinished(FMoviePipelineOutputData InOutputData)
+{
+	if (!InOutputData.bSuccess)
+	{
+		return;
+	}
+
+	// 后面的 Shot 还在渲染，这个 Shot 的帧已全部落盘，可以先开始合成
+	QueueShotComposites(InOutputData);
+}
+
+void UMoviePipelineAsymmetricStereoPass::EnsureCompositeScheduler()
+{
+	if (CompositeScheduler.IsValid())
+	{
+		return;
+	}
+
+	// 每个 FFmpeg 进程自己也是多线程的，并发数按 -threads 折算，避免几个进程互相抢核
+	const int32 Concurrency = (MaxConcurrentComposites > 0)
+		? MaxConcurrentComposites
+		: FAsymmetricCompositeScheduler::ComputeDefaultConcurrency(FFmpegThreadsPerProcess);
+	CompositeScheduler = MakeShared<FAsymmetricCompositeScheduler>(Concurrency);
+	bExportFinished = false;
+
+	UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Composite pool started: up to %d concurrent FFmpeg process(es), %d thread(s) each."),
+		CompositeScheduler->GetMaxConcurrency(), FFmpegThreadsPerProcess);
+}
+
+void UMoviePipelineAsymmetricStereoPass::QueueShotComposites(const FMoviePipelineOutputData& OutputData)
 {
 	// MRQ 渲染完成后，通过 GetOutputDataParams() 拿到完整的输出文件清单。
 	// 数据结构：
 	//   FMoviePipelineOutputData
 	//     .ShotData[]                           — 每个 Shot 一条记录
 	//       .Shot                               — UMoviePipelineExecutorShot*
-	//       .RenderPassData[PassIdentifier]
+	//       .RenderPassData[PassIdentifier]     — PassIdentifier.CameraName 为 LeftEye / RightEye
 	//         .FilePaths[]                      — 绝对路径，所有帧
 	//
-	// 按 Shot 收集 LeftEye 和 RightEye 文件路径，排序后构建 FShotCompositeRecord。
-	// 排序保证帧顺序正确，不依赖起始帧号或文件名格式。
+	// 按 Shot × 渲染 Pass 把两眼文件压缩为 目录 + 文件名模式 + 帧号区间，每个组合一条 FShotCompositeRecord。
 
 	UMoviePipeline* Pipeline = GetPipeline();
 	if (!Pipeline)
@@ -205,7 +627,6 @@ void UMoviePipelineAsymmetricStereoPass::BuildCompositeQueue()
 		return;
 	}
 
-	const FMoviePipelineOutputData OutputData = Pipeline->GetOutputDataParams();
 	const FFrameRate EffectiveFrameRate = Pipeline->GetPipelinePrimaryConfig()
 		->GetEffectiveFrameRate(Pipeline->GetTargetSequence());
 
@@ -213,203 +634,557 @@ void UMoviePipelineAsymmetricStereoPass::BuildCompositeQueue()
 	{
 		const FMoviePipelineShotOutputData& ShotOutput = OutputData.ShotData[ShotIdx];
 
-		FShotCompositeRecord Record;
-		Record.FrameRate = EffectiveFrameRate;
-		// 用 Shot Section 名称作为输出文件名的一部分，空格替换为下划线
+		// 渲染期间已经提交过的 Shot 跳过（BeginExportImpl 时拿到的是全部 Shot）
 		const UMoviePipelineExecutorShot* Shot = ShotOutput.Shot.Get();
-		FString RawShotName = (Shot && !Shot->OuterName.IsEmpty())
+		if (Shot && QueuedShots.Contains(Shot))
+		{
+			continue;
+		}
+
+		// 逐 Shot 回调里只有一条 ShotData，编号取 Shot 在整个任务里的序号
+		const int32 ShotNumber = Shot ? Pipeline->GetActiveShotList().IndexOfByKey(Shot) : INDEX_NONE;
+
+		// 用 Shot Section 名称作为输出文件名的一部分，空格替换为下划线
+		FString ShotName = (Shot && !Shot->OuterName.IsEmpty())
 			? Shot->OuterName
-			: FString::Printf(TEXT("shot%02d"), ShotIdx);
-		RawShotName.ReplaceInline(TEXT(" "), TEXT("_"));
-		Record.ShotName = RawShotName;
+			: FString::Printf(TEXT("shot%02d"), (ShotNumber != INDEX_NONE) ? ShotNumber : ShotIdx);
+		ShotName.ReplaceInline(TEXT(" "), TEXT("_"));
 
-		// Iterate all render passes for this shot and classify by eye name
+		// 每个渲染 Pass（FinalImage、后处理材质、Stencil 层等）单独一条记录，各自合成为独立的 SBS/TB 输出。
+		// 一次遍历：眼别直接取 Pass 标识里的相机名（已考虑 bSwapEyes），文件只解析帧号，不逐个保存路径
+		TMap<FString, FShotCompositeRecord> RecordsByPass;
+		int32 NumUnmatchedFiles = 0;
 		for (const auto& PassPair : ShotOutput.RenderPassData)
 		{
+			const bool bLeftEye  = PassPair.Key.CameraName == TEXT("LeftEye");
+			const bool bRightEye = PassPair.Key.CameraName == TEXT("RightEye");
+			if (!bLeftEye && !bRightEye)
+			{
+				continue;
+			}
+
+			FShotCompositeRecord* Record = RecordsByPass.Find(PassPair.Key.Name);
+			if (!Record)
+			{
+				Record = &RecordsByPass.Add(PassPair.Key.Name);
+				Record->FrameRate = EffectiveFrameRate;
+				Record->PassName = PassPair.Key.Name;
+				// 主画面沿用 Shot 名，其他 Pass 追加 Pass 名，输出文件和临时文件互不重名
+				Record->ShotName = (PassPair.Key.Name == PassIdentifier.Name)
+					? ShotName
+					: FString::Printf(TEXT("%s_%s"), *ShotName, *PassPair.Key.Name.Replace(TEXT(" "), TEXT("_")));
+			}
+
+			FAsymmetricFrameSequence& Eye = bLeftEye ? Record->LeftEye : Record->RightEye;
 			for (const FString& FilePath : PassPair.Value.FilePaths)
 			{
-				const FString FileName = FPaths::GetCleanFilename(FilePath);
+				NumUnmatchedFiles += Eye.AddFile(FilePath) ? 0 : 1;
+			}
+		}
 
-				if (FileName.Contains(TEXT("LeftEye")))
-				{
-					Record.LeftEyePaths.Add(FilePath);
-				}
-				else if (FileName.Contains(TEXT("RightEye")))
+		if (NumUnmatchedFiles > 0)
+		{
+			UE_LOG(LogAsymmetricStereoPass, Warning,
+				TEXT("Shot '%s': %d eye file(s) do not match the first file's name pattern (or have no frame number) and were not composited."),
+				*ShotName, NumUnmatchedFiles);
+		}
+
+		if (RecordsByPass.Num() == 0)
+		{
+			UE_LOG(LogAsymmetricStereoPass, Warning,
+				TEXT("Shot '%s': no LeftEye / RightEye output found. "
+				     "Make sure {camera_name} is included in the MRQ output filename template."), *ShotName);
+			continue;
+		}
+
+		// 各 Pass 互相独立，分别入队，由进程池并行合成
+		bool bAnyQueued = false;
+		for (TPair<FString, FShotCompositeRecord>& PassRecord : RecordsByPass)
+		{
+			bAnyQueued |= SubmitCompositeRecord(MoveTemp(PassRecord.Value));
+		}
+		if (bAnyQueued && Shot)
+		{
+			QueuedShots.Add(Shot);
+		}
+	}
+
+	// 立即启动第一批，不等 Ticker
+	if (CompositeScheduler.IsValid())
+	{
+		CompositeScheduler->Update();
+	}
+}
+
+bool UMoviePipelineAsymmetricStereoPass::SubmitCompositeRecord(FShotCompositeRecord&& Record)
+{
+	// OutputDir 取两眼目录的父目录（如 .../CamTest/11/），
+	// 避免 concat 列表文件落在某一眼的子目录下导致路径找不到。
+	Record.OutputDir = FPaths::GetPath(!Record.LeftEye.IsEmpty() ? Record.LeftEye.Directory : Record.RightEye.Directory);
+
+	// 按帧号配对，不依赖文件名字符串排序（未补零的帧号也正确），缺帧的一侧不参与合成
+	Record.Frames = FAsymmetricFrameRanges::Intersect(Record.LeftEye.Frames, Record.RightEye.Frames);
+	Record.StartFrameNumber = Record.Frames.GetFirstFrame();
+
+	if (Record.Frames.IsEmpty())
+	{
+		UE_LOG(LogAsymmetricStereoPass, Warning,
+			TEXT("'%s': missing LeftEye or RightEye files (left=%d, right=%d). "
+			     "Make sure {camera_name} is included in the MRQ output filename template."),
+			*Record.ShotName, Record.LeftEye.Num(), Record.RightEye.Num());
+		return false;
+	}
+
+	if (Record.Frames.Num() != Record.LeftEye.Num() || Record.Frames.Num() != Record.RightEye.Num())
+	{
+		UE_LOG(LogAsymmetricStereoPass, Warning,
+			TEXT("'%s': left and right eyes cover different frames (left=%d, right=%d), compositing the %d frames both have."),
+			*Record.ShotName, Record.LeftEye.Num(), Record.RightEye.Num(), Record.Frames.Num());
+	}
+
+	UE_LOG(LogAsymmetricStereoPass, Log,
+		TEXT("'%s' (pass %s): %d frame pairs (%d-%d, %d missing) queued for composite."),
+		*Record.ShotName, *Record.PassName, Record.Frames.Num(), Record.Frames.GetFirstFrame(), Record.Frames.GetLastFrame(),
+		Record.Frames.GetNumMissing());
+
+	Record.Targets = GetCompositeTargets();
+	Record.Telemetry.QueuedTime = FPlatformTime::Seconds();
+	EnsureCompositeScheduler();
+
+	// 清单只在合成结束后保存一次；途中崩溃或取消留下的输出和清单里记录的文件数、字节数对不上，下次导出会重新合成
+	const int32 RecordIndex = CompositeQueue.Add(MoveTemp(Record));
+	if (bSkipUnchangedShots)
+	{
+		CheckCompositeUpToDateAsync(RecordIndex);
+	}
+	else
+	{
+		EnqueueCompositeForShot(RecordIndex);
+	}
+	return true;
+}
+
+void UMoviePipelineAsymmetricStereoPass::BeginExportImpl()
+{
+	if (CompositeMode == EAsymmetricCompositeMode::Disabled || StereoLayout == EAsymmetricStereoLayout::None)
+	{
+		return;
+	}
+
+	if (HasStereoOutputNode())
+	{
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("A stereo output node wrote the stereo frames during render, skipping file-based composite."));
+		return;
+	}
+
+	// 渲染已全部结束，不再需要逐 Shot 回调
+	UnbindShotWorkFinished();
+
+	const int32 NumQueuedDuringRender = CompositeQueue.Num();
+	if (UMoviePipeline* Pipeline = GetPipeline())
+	{
+		QueueShotComposites(Pipeline->GetOutputDataParams());
+	}
+
+	if (CompositeQueue.Num() == 0)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("No stereo shot pairs found — skipping FFmpeg composite."));
+		bExportFinished = true;
+		return;
+	}
+
+	UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Render finished: %d shot(s) already composited or compositing during render, %d queued now."),
+		NumQueuedDuringRender, CompositeQueue.Num() - NumQueuedDuringRender);
+}
+
+bool UMoviePipelineAsymmetricStereoPass::HasFinishedExportingImpl()
+{
+	if (bExportFinished)
+	{
+		return true;
+	}
+
+	// 进程池自己挂在 Ticker 上轮询，这里只看是否全部结束
+	if (CompositeScheduler.IsValid() && !CompositeScheduler->IsIdle())
+	{
+		return false;
+	}
+	if (bNativeCompositeRunning || NativeCompositeQueue.Num() > 0 || NumPendingFileTasks > 0)
+	{
+		return false;
+	}
+
+	FinishExport();
+	return true;
+}
+
+void UMoviePipelineAsymmetricStereoPass::HandleShotCompositeFinished(int32 RecordIndex, bool bLaunched, int32 ReturnCode, double Seconds, const FString& FFmpegLog)
+{
+	if (!CompositeQueue.IsValidIndex(RecordIndex))
+	{
+		return;
+	}
+
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	Record.bCompositeFinished = true;
+	Record.bCompositeSucceeded = bLaunched && ReturnCode == 0;
+	Record.CompositeReturnCode = ReturnCode;
+	Record.CompositeSeconds = Seconds;
+	Record.Telemetry.EndTime = FPlatformTime::Seconds();
+
+	// 源文件可能马上被删除，字节数先统计。每帧每眼、每个输出都要 stat 一次，
+	// 长 Shot 放在网络存储上会卡住游戏线程（边渲染边合成时就是渲染卡顿），放到后台统计完再回来收尾
+	++NumPendingFileTasks;
+	const bool bVideo = CompositeMode == EAsymmetricCompositeMode::Video;
+	Async(EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), CancelFlag = NativeCompositeCancelFlag,
+		 RecordCopy = Record, RecordIndex, bVideo, bLaunched, ReturnCode, FFmpegLog]()
+		{
+			FShotFileStats Stats = MeasureShotFiles(RecordCopy, bVideo);
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, CancelFlag, RecordIndex, bLaunched, ReturnCode, FFmpegLog, Stats = MoveTemp(Stats)]() mutable
 				{
-					Record.RightEyePaths.Add(FilePath);
-				}
-			}
+					UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+					if (!This || *CancelFlag)
+					{
+						return;
+					}
+
+					--This->NumPendingFileTasks;
+					FShotCompositeRecord& FinishedRecord = This->CompositeQueue[RecordIndex];
+					FinishedRecord.Telemetry.BytesRead = Stats.BytesRead;
+					FinishedRecord.Telemetry.BytesWritten = 0;
+					for (const FShotOutputFiles& Output : Stats.Outputs)
+					{
+						FinishedRecord.Telemetry.BytesWritten += Output.Bytes;
+					}
+					FinishedRecord.OutputFiles = MoveTemp(Stats.Outputs);
+					This->CompleteShotComposite(RecordIndex, bLaunched, ReturnCode, FFmpegLog);
+				});
+		});
+}
+
+void UMoviePipelineAsymmetricStereoPass::CompleteShotComposite(int32 RecordIndex, bool bLaunched, int32 ReturnCode, const FString& FFmpegLog)
+{
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	FShotCompositeTelemetry& Telemetry = Record.Telemetry;
+	++NumCompositesFinished;
+	if (bSkipUnchangedShots)
+	{
+		UpdateCompositeManifest(Record);
+	}
+
+	INC_DWORD_STAT(STAT_AsymmetricCompositeShotsFinished);
+	INC_DWORD_STAT_BY(STAT_AsymmetricCompositeShotsFailed, Record.bCompositeSucceeded ? 0 : 1);
+	INC_DWORD_STAT_BY(STAT_AsymmetricCompositeFramesEncoded, uint32(Telemetry.FramesEncoded));
+	INC_FLOAT_STAT_BY(STAT_AsymmetricCompositeMBRead, float(Telemetry.BytesRead / BytesPerMB));
+	INC_FLOAT_STAT_BY(STAT_AsymmetricCompositeMBWritten, float(Telemetry.BytesWritten / BytesPerMB));
+
+	// CSV 记录运行总量：Accumulate 只在 Shot 结束那一帧出现一个尖峰，和 STAT 计数器的含义对不上
+	TotalFramesEncoded += Telemetry.FramesEncoded;
+	TotalBytesRead += Telemetry.BytesRead;
+	TotalBytesWritten += Telemetry.BytesWritten;
+	CSV_CUSTOM_STAT(AsymmetricComposite, ShotsFinished, NumCompositesFinished, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsymmetricComposite, FramesEncoded, int32(TotalFramesEncoded), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsymmetricComposite, MBRead, float(TotalBytesRead / BytesPerMB), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsymmetricComposite, MBWritten, float(TotalBytesWritten / BytesPerMB), ECsvCustomStatOp::Set);
+
+	if (Record.bCompositeSucceeded)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Log,
+			TEXT("%s composite succeeded for shot '%s': %lld frames in %.1f s (%.1f fps), waited %.1f s in queue, "
+			     "read %.1f MB, wrote %.1f MB, CPU %.1f s."),
+			Record.bUsedNativeCompositor ? TEXT("Native") : TEXT("FFmpeg"), *Record.ShotName, Telemetry.FramesEncoded,
+			Telemetry.GetEncodeSeconds(), Telemetry.GetEncodeFps(), Telemetry.GetQueueWaitSeconds(),
+			Telemetry.BytesRead / BytesPerMB, Telemetry.BytesWritten / BytesPerMB, Telemetry.CpuSeconds);
+		if (bDeleteSourceAfterComposite)
+		{
+			DeleteSourceFiles(Record);
+		}
+	}
+	else if (!bLaunched)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Error,
+			TEXT("Failed to launch FFmpeg for shot '%s'. "
+			     "Check FFmpegPath or run ThirdParty/FFmpeg/download_ffmpeg.ps1."),
+			*Record.ShotName);
+	}
+	else if (Record.bUsedNativeCompositor)
+	{
+		// 逐帧错误已由合成器写入日志
+		UE_LOG(LogAsymmetricStereoPass, Error,
+			TEXT("Native composite failed for shot '%s', keeping source files."), *Record.ShotName);
+	}
+	else
+	{
+		UE_LOG(LogAsymmetricStereoPass, Error,
+			TEXT("FFmpeg exited with code %d for shot '%s', keeping source files."),
+			ReturnCode, *Record.ShotName);
+
+		// 管道里截获的最后若干行输出，直接打到 Output Log
+		if (!FFmpegLog.IsEmpty())
+		{
+			UE_LOG(LogAsymmetricStereoPass, Error, TEXT("FFmpeg output:\n%s"), *FFmpegLog);
 		}
+	}
 
-		// OutputDir 取两眼目录的父目录（如 .../CamTest/11/），
-		// 避免 concat 列表文件和 ffmpeg 日志落在某一眼的子目录下导致路径找不到。
-		if (Record.LeftEyePaths.Num() > 0)
+	if (bDebugSaveConcatFiles && Record.bCompositeSucceeded && !FFmpegLog.IsEmpty())
+	{
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("FFmpeg output for shot '%s':\n%s"), *Record.ShotName, *FFmpegLog);
+	}
+
+	// 临时文件按 Shot 清理，多个 Shot 并行时不必等全部结束
+	if (bDebugSaveConcatFiles)
+	{
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Debug mode: concat files retained for shot '%s':"), *Record.ShotName);
+		for (const FString& TempFile : Record.TempFiles)
+		{
+			UE_LOG(LogAsymmetricStereoPass, Log, TEXT("  %s"), *TempFile);
+		}
+	}
+	else
+	{
+		for (const FString& TempFile : Record.TempFiles)
 		{
-			const FString LeftEyeDir = FPaths::GetPath(Record.LeftEyePaths[0]);
-			Record.OutputDir = FPaths::GetPath(LeftEyeDir); // 上一级
+			IFileManager::Get().Delete(*TempFile, /*bRequireExists=*/false);
 		}
-		else if (Record.RightEyePaths.Num() > 0)
+	}
+	Record.TempFiles.Reset();
+
+	FNotificationInfo Info(FText::FromString(Record.bCompositeSucceeded
+		? FString::Printf(TEXT("立体合成：Shot '%s' 完成（%d/%d）"), *Record.ShotName, NumCompositesFinished, CompositeQueue.Num())
+		: FString::Printf(TEXT("立体合成：Shot '%s' 失败（%d/%d），详见 Output Log"), *Record.ShotName, NumCompositesFinished, CompositeQueue.Num())));
+	Info.ExpireDuration = 3.0f;
+	Info.bUseLargeFont = false;
+	Info.bFireAndForget = true;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+TArray<FAsymmetricCompositeOutputTarget> UMoviePipelineAsymmetricStereoPass::GetCompositeTargets() const
+{
+	TArray<FAsymmetricCompositeOutputTarget> Targets;
+
+	// 主输出：沿用 Pass 的布局和编码设置，文件名不带后缀
+	FAsymmetricCompositeOutputTarget& Main = Targets.AddDefaulted_GetRef();
+	Main.Suffix.Reset();
+	Main.Layout = StereoLayout;
+	Main.Scale = 1.0f;
+	Main.VideoCodec = VideoCodec;
+	Main.OutputFormat = OutputFormat;
+	Main.Quality = CompositeQuality;
+
+	for (const FAsymmetricCompositeOutputTarget& Extra : AdditionalOutputTargets)
+	{
+		if (!Extra.bEnabled || Extra.Layout == EAsymmetricStereoLayout::None)
 		{
-			const FString RightEyeDir = FPaths::GetPath(Record.RightEyePaths[0]);
-			Record.OutputDir = FPaths::GetPath(RightEyeDir);
+			continue;
 		}
 
-		// Sort guarantees ascending frame order regardless of number format or start offset
-		// 排序保证帧升序，无论文件名格式或起始帧号
-		Record.LeftEyePaths.Sort();
-		Record.RightEyePaths.Sort();
-
-		// 从第一个左眼文件名中提取起始帧号（用于 ImageSequence 输出帧号对齐）。
-		// MRQ 文件名末尾固定为 .NNNNN.ext 格式（ZeroPadFrameNumbers 控制位数，默认 4 位）。
-		if (Record.LeftEyePaths.Num() > 0)
+		FAsymmetricCompositeOutputTarget Target = Extra;
+		Target.Scale = FMath::Clamp(Target.Scale, 0.05f, 1.0f);
+		if (Target.Suffix.IsEmpty())
 		{
-			const FString FirstFile = FPaths::GetBaseFilename(Record.LeftEyePaths[0]);
-			// 找最后一段纯数字（帧号部分），例如 "LeftEye.0015" → "0015"
-			int32 DotIdx = INDEX_NONE;
-			FirstFile.FindLastChar(TEXT('.'), DotIdx);
-			if (DotIdx != INDEX_NONE)
-			{
-				const FString FramePart = FirstFile.Mid(DotIdx + 1);
-				if (FramePart.IsNumeric())
-				{
-					Record.StartFrameNumber = FCString::Atoi(*FramePart);
-				}
-			}
+			Target.Suffix = FString::Printf(TEXT("out%d"), Targets.Num());
 		}
 
-		if (Record.LeftEyePaths.Num() > 0 && Record.RightEyePaths.Num() > 0)
+		// 同布局同后缀会写到同一个文件
+		const bool bDuplicate = Targets.ContainsByPredicate([&Target](const FAsymmetricCompositeOutputTarget& Existing)
 		{
-			UE_LOG(LogAsymmetricStereoPass, Log,
-				TEXT("Shot '%s': %d left + %d right eye frames queued for composite."),
-				*Record.ShotName, Record.LeftEyePaths.Num(), Record.RightEyePaths.Num());
-			CompositeQueue.Add(MoveTemp(Record));
-		}
-		else
+			return Existing.Layout == Target.Layout && Existing.Suffix == Target.Suffix;
+		});
+		if (bDuplicate)
 		{
-			UE_LOG(LogAsymmetricStereoPass, Warning,
-				TEXT("Shot '%s': missing LeftEye or RightEye files (left=%d, right=%d). "
-				     "Make sure {camera_name} is included in the MRQ output filename template."),
-				*Record.ShotName, Record.LeftEyePaths.Num(), Record.RightEyePaths.Num());
+			UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("Output target '%s' (%s) duplicates another target's file name, skipping it."),
+				*Target.Suffix, FAsymmetricFFmpegArgs::GetLayoutName(Target.Layout));
+			continue;
 		}
+		Targets.Add(MoveTemp(Target));
 	}
+	return Targets;
 }
 
-void UMoviePipelineAsymmetricStereoPass::BeginExportImpl()
+FAsymmetricCompositeManifest& UMoviePipelineAsymmetricStereoPass::GetCompositeManifest(const FString& OutputDir)
 {
-	if (CompositeMode == EAsymmetricCompositeMode::Disabled || StereoLayout == EAsymmetricStereoLayout::None)
+	TSharedPtr<FAsymmetricCompositeManifest>& Manifest = CompositeManifests.FindOrAdd(OutputDir);
+	if (!Manifest.IsValid())
 	{
-		return;
+		Manifest = MakeShared<FAsymmetricCompositeManifest>(OutputDir);
+		Manifest->Load();
 	}
+	return *Manifest;
+}
+
+uint64 UMoviePipelineAsymmetricStereoPass::ComputeSettingsHash(const FShotCompositeRecord& Record) const
+{
+	FXxHash64Builder Builder;
+	const auto UpdateValue = [&Builder](const auto& Value) { Builder.Update(&Value, sizeof(Value)); };
+
+	const bool  bVideo = CompositeMode == EAsymmetricCompositeMode::Video;
+	const bool  bNative = !bVideo && bUseNativeImageCompositor;
+	const int32 SegmentFrames = bVideo ? GetSegmentLengthFrames(Record) : 0;
+	const int32 GopFrames = (SegmentFrames > 0) ? GetSegmentGopFrames(Record) : 0;
+	UpdateValue(CompositeMode);
+	UpdateValue(bNative);
+	UpdateValue(Record.FrameRate.Numerator);
+	UpdateValue(Record.FrameRate.Denominator);
+	UpdateValue(Record.StartFrameNumber);
+	UpdateValue(SegmentFrames);
+	UpdateValue(GopFrames);
+
+	for (const FAsymmetricCompositeOutputTarget& Target : Record.Targets)
+	{
+		UpdateValue(Target.Layout);
+		UpdateValue(Target.Scale);
+		UpdateValue(Target.VideoCodec);
+		UpdateValue(Target.OutputFormat);
+		UpdateValue(Target.Quality);
+		Builder.Update(*Target.Suffix, Target.Suffix.Len() * sizeof(TCHAR));
+	}
+	return Builder.Finalize().Hash;
+}
 
-	BuildCompositeQueue();
+void UMoviePipelineAsymmetricStereoPass::CheckCompositeUpToDateAsync(int32 RecordIndex)
+{
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	Record.SettingsHash = ComputeSettingsHash(Record);
 
-	if (CompositeQueue.Num() == 0)
+	// 清单在游戏线程读取，比对用的条目拷一份；读输入内容抽样、stat 输出文件都在后台做
+	TOptional<FAsymmetricCompositeManifest::FEntry> Entry;
+	if (const FAsymmetricCompositeManifest::FEntry* Found = GetCompositeManifest(Record.OutputDir).Find(Record.ShotName))
 	{
-		UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("No stereo shot pairs found — skipping FFmpeg composite."));
-		bExportFinished = true;
-		return;
+		Entry = *Found;
 	}
 
-	bExportFinished = false;
-	CurrentCompositeIndex = 0;
-	LaunchFFmpegForShot(CompositeQueue[CurrentCompositeIndex]);
+	++NumPendingFileTasks;
+	const bool bVideo = CompositeMode == EAsymmetricCompositeMode::Video;
+	Async(EAsyncExecution::ThreadPool,
+		[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), CancelFlag = NativeCompositeCancelFlag,
+		 RecordCopy = Record, RecordIndex, Entry = MoveTemp(Entry), bVideo]()
+		{
+			const uint64 InputHash = HashCompositeInputs(RecordCopy);
+			const TCHAR* Reason = GetCompositeOutdatedReason(RecordCopy, InputHash, Entry.GetPtrOrNull(), bVideo);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, CancelFlag, RecordIndex, InputHash, Reason]()
+			{
+				UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+				if (!This || *CancelFlag)
+				{
+					return;
+				}
+
+				--This->NumPendingFileTasks;
+				FShotCompositeRecord& CheckedRecord = This->CompositeQueue[RecordIndex];
+				CheckedRecord.InputHash = InputHash;
+				if (!Reason)
+				{
+					This->FinishUnchangedComposite(RecordIndex);
+					return;
+				}
+
+				UE_LOG(LogAsymmetricStereoPass, Log, TEXT("'%s': %s, recompositing."), *CheckedRecord.ShotName, Reason);
+				This->EnqueueCompositeForShot(RecordIndex);
+				if (This->CompositeScheduler.IsValid())
+				{
+					This->CompositeScheduler->Update();
+				}
+			});
+		});
 }
 
-bool UMoviePipelineAsymmetricStereoPass::HasFinishedExportingImpl()
+void UMoviePipelineAsymmetricStereoPass::FinishUnchangedComposite(int32 RecordIndex)
 {
-	if (bExportFinished)
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	UE_LOG(LogAsymmetricStereoPass, Log,
+		TEXT("'%s': inputs, settings and outputs match the composite manifest, skipping composite."), *Record.ShotName);
+	Record.bCompositeFinished = true;
+	Record.bCompositeSucceeded = true;
+	Record.bSkippedUnchanged = true;
+	Record.CompositeReturnCode = 0;
+	Record.Telemetry.EndTime = Record.Telemetry.QueuedTime;
+	++NumCompositesFinished;
+	if (bDeleteSourceAfterComposite)
 	{
-		return true;
+		DeleteSourceFiles(Record);
 	}
+}
 
-	// Still waiting for current FFmpeg process
-	if (ActiveFFmpegProcess.IsValid() && FPlatformProcess::IsProcRunning(ActiveFFmpegProcess))
+void UMoviePipelineAsymmetricStereoPass::UpdateCompositeManifest(const FShotCompositeRecord& Record)
+{
+	FAsymmetricCompositeManifest& Manifest = GetCompositeManifest(Record.OutputDir);
+	if (Record.bCompositeFinished && !Record.bCompositeSucceeded)
 	{
-		return false;
+		Manifest.Remove(Record.ShotName);
 	}
-
-	// Current process has finished — check result and advance queue
-	if (ActiveFFmpegProcess.IsValid())
+	else
 	{
-		int32 ReturnCode = 0;
-		FPlatformProcess::GetProcReturnCode(ActiveFFmpegProcess, &ReturnCode);
-		FPlatformProcess::CloseProc(ActiveFFmpegProcess);
-		ActiveFFmpegProcess.Reset();
-
-		const FShotCompositeRecord& FinishedRecord = CompositeQueue[CurrentCompositeIndex];
-		if (ReturnCode == 0)
+		FAsymmetricCompositeManifest::FEntry Entry;
+		Entry.State = Record.bCompositeFinished ? FAsymmetricCompositeManifest::EState::Complete : FAsymmetricCompositeManifest::EState::InProgress;
+		Entry.InputHash = Record.InputHash;
+		Entry.SettingsHash = Record.SettingsHash;
+		Entry.NumFramePairs = Record.GetNumFramePairs();
+		Entry.Updated = FDateTime::UtcNow();
+		if (Record.bCompositeFinished)
 		{
-			UE_LOG(LogAsymmetricStereoPass, Log, TEXT("FFmpeg composite succeeded for shot '%s'."), *FinishedRecord.ShotName);
-			if (bDeleteSourceAfterComposite)
+			// 文件数和字节数是 Shot 结束时在后台统计好的
+			const bool bVideo = CompositeMode == EAsymmetricCompositeMode::Video;
+			for (int32 TargetIndex = 0; TargetIndex < Record.OutputFiles.Num(); ++TargetIndex)
 			{
-				DeleteSourceFiles(FinishedRecord);
+				FAsymmetricCompositeManifest::FOutput& Output = Entry.Outputs.AddDefaulted_GetRef();
+				Output.Name = GetTargetOutputName(Record, TargetIndex, bVideo);
+				Output.NumFiles = Record.OutputFiles[TargetIndex].NumFiles;
+				Output.Bytes = Record.OutputFiles[TargetIndex].Bytes;
 			}
 		}
-		else
-		{
-			UE_LOG(LogAsymmetricStereoPass, Error,
-				TEXT("FFmpeg exited with code %d for shot '%s', keeping source files."),
-				ReturnCode, *FinishedRecord.ShotName);
-
-			// Print the FFmpeg log file contents to make the error visible in Output Log
-			const FString FFmpegLogPath = FPaths::Combine(FinishedRecord.OutputDir,
-				FString::Printf(TEXT("_ffmpeg_log_%s.txt"), *FinishedRecord.ShotName));
-			FString FFmpegOutput;
-			if (FFileHelper::LoadFileToString(FFmpegOutput, *FFmpegLogPath) && !FFmpegOutput.IsEmpty())
-			{
-				UE_LOG(LogAsymmetricStereoPass, Error, TEXT("FFmpeg output:\n%s"), *FFmpegOutput);
-			}
-			else
-			{
-				UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("FFmpeg log file not found or empty: %s"), *FFmpegLogPath);
-			}
-		}
-
-		++CurrentCompositeIndex;
+		Manifest.Set(Record.ShotName, Entry);
 	}
+	Manifest.Save();
+}
 
-	// Launch the next shot if any remain
-	if (CurrentCompositeIndex < CompositeQueue.Num())
+void UMoviePipelineAsymmetricStereoPass::FinishExport()
+{
+	int32 NumSucceeded = 0;
+	int32 NumUnchanged = 0;
+	double TotalProcessSeconds = 0.0;
+	if (CompositeQueue.Num() > 0)
 	{
-		LaunchFFmpegForShot(CompositeQueue[CurrentCompositeIndex]);
-		return false;
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("  %-32s %-9s %-6s %9s %10s %9s %10s %10s %9s"),
+			TEXT("Shot"), TEXT("Status"), TEXT("Method"), TEXT("Encode"), TEXT("Rate"), TEXT("Queued"), TEXT("Read"), TEXT("Written"), TEXT("CPU"));
+	}
+	for (const FShotCompositeRecord& Record : CompositeQueue)
+	{
+		NumSucceeded += Record.bCompositeSucceeded ? 1 : 0;
+		NumUnchanged += Record.bSkippedUnchanged ? 1 : 0;
+		TotalProcessSeconds += Record.CompositeSeconds;
+		const FShotCompositeTelemetry& Telemetry = Record.Telemetry;
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("  %-32s %-9s %-6s %7.1f s %6.1f fps %7.1f s %7.1f MB %7.1f MB %7.1f s"), *Record.ShotName,
+			GetCompositeStatusName(Record),
+			Record.bUsedNativeCompositor ? TEXT("native") : TEXT("ffmpeg"),
+			Telemetry.GetEncodeSeconds(), Telemetry.GetEncodeFps(), Telemetry.GetQueueWaitSeconds(),
+			Telemetry.BytesRead / BytesPerMB, Telemetry.BytesWritten / BytesPerMB, Telemetry.CpuSeconds);
 	}
+	const int32 NumFailed = CompositeQueue.Num() - NumSucceeded;
 
-	// Clean up or retain temp files based on debug setting
-	if (TempConcatFiles.Num() > 0)
+	if (bWriteCompositeReport)
 	{
-		if (bDebugSaveConcatFiles)
-		{
-			UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Debug mode: concat/log files retained for inspection:"));
-			for (const FString& TempFile : TempConcatFiles)
-			{
-				UE_LOG(LogAsymmetricStereoPass, Log, TEXT("  %s"), *TempFile);
-			}
-		}
-		else
-		{
-			for (const FString& TempFile : TempConcatFiles)
-			{
-				IFileManager::Get().Delete(*TempFile, /*bRequireExists=*/false);
-			}
-		}
+		WriteCompositeReports();
 	}
 
 	// 显示完成通知
 	if (CompositeQueue.Num() > 0)
 	{
-		FNotificationInfo Info(FText::FromString(
-			FString::Printf(TEXT("立体合成完成：%d 个 Shot 已处理"), CompositeQueue.Num())));
+		FNotificationInfo Info(FText::FromString(NumFailed == 0
+			? FString::Printf(TEXT("立体合成完成：%d 个 Shot 已处理"), CompositeQueue.Num())
+			: FString::Printf(TEXT("立体合成完成：%d 个 Shot 成功，%d 个失败"), NumSucceeded, NumFailed)));
 		Info.ExpireDuration = 5.0f;
 		Info.bUseLargeFont = false;
 		Info.bFireAndForget = true;
 		FSlateNotificationManager::Get().AddNotification(Info);
 
-		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Stereo composite finished: %d shot(s) processed."), CompositeQueue.Num());
+		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Stereo composite finished: %d shot(s) processed, %d unchanged and skipped, %d failed, %.1f s total FFmpeg time."),
+			CompositeQueue.Num(), NumUnchanged, NumFailed, TotalProcessSeconds);
 	}
 
+	CompositeScheduler.Reset();
 	bExportFinished = true;
-	return true;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -444,6 +1219,50 @@ FString UMoviePipelineAsymmetricStereoPass::GetCameraNameOverride(const int32 In
 	return GetCameraName(InCameraIndex);
 }
 
+namespace
+{
+	/** 是否分块渲染（任一方向多于一个 Tile） */
+	bool IsStereoPassTiled(const FMoviePipelineRenderPassMetrics& SampleState)
+	{
+		return SampleState.TileCounts.X > 1 || SampleState.TileCounts.Y > 1;
+	}
+
+	/**
+	 * 当前采样的 Tile 在整幅输出画面里的归一化区域（左上角为原点），向四周扩出重叠边。
+	 * 分块时再按 OverlappedSubpixelShift（像素，MRQ 累加 Tile 时按它移回）平移，
+	 * 这个采样的亚像素位置由区域本身表达，和不分块渲染的同一个采样对齐。不分块时是 (0,0)-(1,1)。
+	 */
+	FBox2D GetStereoPassTileRect(const FMoviePipelineRenderPassMetrics& SampleState)
+	{
+		if (!IsStereoPassTiled(SampleState))
+		{
+			return FBox2D(FVector2D(0.0, 0.0), FVector2D(1.0, 1.0));
+		}
+
+		const FIntPoint TileCounts(FMath::Max(SampleState.TileCounts.X, 1), FMath::Max(SampleState.TileCounts.Y, 1));
+		const FIntPoint TileSize(FMath::Max(SampleState.TileSize.X, 1), FMath::Max(SampleState.TileSize.Y, 1));
+		const FVector2D FullSize(TileCounts.X * TileSize.X, TileCounts.Y * TileSize.Y);
+		const FVector2D Shift = SampleState.OverlappedSubpixelShift;
+
+		const FVector2D Min(
+			(SampleState.TileIndexes.X * TileSize.X - SampleState.OverlappedPad.X + Shift.X) / FullSize.X,
+			(SampleState.TileIndexes.Y * TileSize.Y - SampleState.OverlappedPad.Y + Shift.Y) / FullSize.Y);
+		const FVector2D Max(
+			((SampleState.TileIndexes.X + 1) * TileSize.X + SampleState.OverlappedPad.X + Shift.X) / FullSize.X,
+			((SampleState.TileIndexes.Y + 1) * TileSize.Y + SampleState.OverlappedPad.Y + Shift.Y) / FullSize.Y);
+		return FBox2D(Min, Max);
+	}
+
+	/**
+	 * 叠加在子视锥上的裁剪空间抖动。分块时采样偏移已经含在 GetStereoPassTileRect 的亚像素平移里，
+	 * 再加 ProjectionMatrixJitterAmount 会偏两次；不分块时按 MRQ 给的抖动。
+	 */
+	FVector2D GetStereoPassTileJitter(const FMoviePipelineRenderPassMetrics& SampleState)
+	{
+		return IsStereoPassTiled(SampleState) ? FVector2D::ZeroVector : SampleState.ProjectionMatrixJitterAmount;
+	}
+}
+
 UE::MoviePipeline::FImagePassCameraViewData UMoviePipelineAsymmetricStereoPass::GetCameraInfo(
 	FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload) const
 {
@@ -451,50 +1270,65 @@ UE::MoviePipeline::FImagePassCameraViewData UMoviePipelineAsymmetricStereoPass::
 	UE::MoviePipeline::FImagePassCameraViewData OutCameraData =
 		UMoviePipelineImagePassBase::GetCameraInfo(InOutSampleState, OptPayload);
 
-	if (StereoLayout == EAsymmetricStereoLayout::None)
-	{
-		return OutCameraData;
-	}
-
-	const int32 CameraIndex = InOutSampleState.OutputState.CameraIndex;
-	const int32 EyeIdx      = GetEyeIndex(CameraIndex);
-	const float EyeSign     = (EyeIdx == 0) ? -1.0f : 1.0f;
-
-	// 沿屏幕右方向计算眼睛偏移量
-	FVector EyeOffset;
+	// 屏幕正交基只算一次，眼睛偏移和离轴投影都用它
+	FAsymmetricScreenBasis Basis;
 	if (CachedCameraComponent.IsValid())
 	{
-		FVector ScreenBL, ScreenBR, ScreenTL, ScreenTR;
-		CachedCameraComponent->GetEffectiveScreenCorners(ScreenBL, ScreenBR, ScreenTL, ScreenTR);
-		const FVector ScreenRight = (ScreenBR - ScreenBL).GetSafeNormal();
-		EyeOffset = ScreenRight * EyeSign * (EyeSeparation * 0.5f);
+		Basis = CachedCameraComponent->GetScreenBasis();
 	}
-	else
+
+	if (StereoLayout != EAsymmetricStereoLayout::None)
 	{
-		const FVector RightVector = FRotationMatrix(OutCameraData.ViewInfo.Rotation).GetScaledAxis(EAxis::Y);
-		EyeOffset = RightVector * EyeSign * (EyeSeparation * 0.5f);
-	}
+		const int32 CameraIndex = InOutSampleState.OutputState.CameraIndex;
+		const int32 EyeIdx      = GetEyeIndex(CameraIndex);
+		const float EyeSign     = (EyeIdx == 0) ? -1.0f : 1.0f;
 
-	OutCameraData.ViewInfo.Location += EyeOffset;
+		// 沿屏幕右方向计算眼睛偏移量
+		FVector EyeOffset;
+		if (Basis.IsValid())
+		{
+			EyeOffset = Basis.Right * EyeSign * (EyeSeparation * 0.5f);
+		}
+		else
+		{
+			const FVector RightVector = FRotationMatrix(OutCameraData.ViewInfo.Rotation).GetScaledAxis(EAxis::Y);
+			EyeOffset = RightVector * EyeSign * (EyeSeparation * 0.5f);
+		}
+
+		OutCameraData.ViewInfo.Location += EyeOffset;
+	}
 
 	// 应用非对称离轴投影（如果有 AsymmetricCameraComponent）。
 	// ComponentEyeSeparation 必须为 0，IPD 只由本 Pass 的 EyeSeparation 控制。
-	if (CachedCameraComponent.IsValid() && CachedCameraComponent->bUseAsymmetricProjection)
+	// 这里给 MRQ 的是整幅画面的矩阵（MRQ 会自己按 Tile 缩放它），分块的子视锥由视图扩展在 SetupView 里替换（见 GetSceneViewForSampleState）
+	if (Basis.IsValid() && CachedCameraComponent->bUseAsymmetricProjection)
 	{
-		FVector    EyePosition = OutCameraData.ViewInfo.Location;
-		FRotator   ProjViewRotation;
-		FMatrix    ProjectionMatrix;
+		const FAsymmetricFrustumExtents Extents = FAsymmetricProjectionKernel::ComputeFrustumExtents(
+			Basis, OutCameraData.ViewInfo.Location, CachedCameraComponent->NearClip, CachedCameraComponent->FarClip);
 
-		if (CachedCameraComponent->CalculateOffAxisProjection(EyePosition, ProjViewRotation, ProjectionMatrix))
-		{
-			OutCameraData.bUseCustomProjectionMatrix = true;
-			OutCameraData.CustomProjectionMatrix     = ProjectionMatrix;
-		}
+		OutCameraData.bUseCustomProjectionMatrix = true;
+		OutCameraData.CustomProjectionMatrix     = FAsymmetricProjectionKernel::MakeProjectionMatrix(Extents);
 	}
 
 	return OutCameraData;
 }
 
+FSceneView* UMoviePipelineAsymmetricStereoPass::GetSceneViewForSampleState(
+	FSceneViewFamily* ViewFamily, FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload)
+{
+	// 高分辨率分块：按这个 View 将要使用的 ViewState 把采样的 Tile 区域交给视图扩展，
+	// 基类创建 View 后调用的 SetupView 按 View 自己的 ViewState 取回并切出离轴子视锥。
+	// 左右眼、多个相机的 ViewState 不同，不会取到别的 View 的 Tile；单目（Mono）也走这里，分块渲染同样需要
+	UWorld* World = GetWorld();
+	if (UAsymmetricCameraSubsystem* Subsystem = World ? World->GetSubsystem<UAsymmetricCameraSubsystem>() : nullptr)
+	{
+		Subsystem->SetOfflineRenderTile(GetSceneViewStateInterface(OptPayload),
+			GetStereoPassTileRect(InOutSampleState), GetStereoPassTileJitter(InOutSampleState));
+	}
+
+	return Super::GetSceneViewForSampleState(ViewFamily, InOutSampleState, OptPayload);
+}
+
 void UMoviePipelineAsymmetricStereoPass::BlendPostProcessSettings(
 	FSceneView* InView, FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload)
 {
@@ -513,40 +1347,86 @@ FText UMoviePipelineAsymmetricStereoPass::GetDisplayText() const
 // 私有辅助函数
 // ─────────────────────────────────────────────────────────────────────────────
 
+bool UMoviePipelineAsymmetricStereoPass::HasStereoOutputNode() const
+{
+	const UMoviePipeline* Pipeline = GetPipeline();
+	return Pipeline && Pipeline->GetPipelinePrimaryConfig()->FindSetting<UMoviePipelineAsymmetricStereoOutputBase>() != nullptr;
+}
+
 int32 UMoviePipelineAsymmetricStereoPass::GetEyeIndex(const int32 InCameraIndex) const
 {
 	return bSwapEyes ? (1 - InCameraIndex) : InCameraIndex;
 }
 
-FString UMoviePipelineAsymmetricStereoPass::WriteConcatList(
-    const TArray<FString>& FilePaths, const FString& ListFilePath) const
+namespace
 {
-	// FFmpeg concat demuxer 格式：每行一个文件，路径用单引号括起来。
-	// 这种方式对帧号格式、起始帧和文件名间隔均无要求。
-    TArray<FString> Lines;
-	Lines.Reserve(FilePaths.Num());
-    for (const FString& Path : FilePaths)
-    {
-        FString Normalized = Path;
-        FPaths::NormalizeFilename(Normalized);
+	/** 追加一行 concat demuxer 条目 */
+	void AppendConcatEntry(FString& Content, FString&& Path)
+	{
+		// FFmpeg concat demuxer 格式：每行一个文件，路径用单引号括起来。
+		// 这种方式对帧号格式、起始帧和文件名间隔均无要求。
+		FPaths::NormalizeFilename(Path);
 		// 转义路径中的单引号（concat list 格式要求）
-        Normalized.ReplaceInline(TEXT("'"), TEXT("'\\''"));
-        Lines.Add(FString::Printf(TEXT("file '%s'"), *Normalized));
-    }
+		Path.ReplaceInline(TEXT("'"), TEXT("'\\''"));
+		Content += TEXT("file '");
+		Content += Path;
+		Content += TEXT("'\n");
+	}
+
+	FString SaveConcatList(const FString& Content, const FString& ListFilePath)
+	{
+		if (FFileHelper::SaveStringToFile(Content, *ListFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			return ListFilePath;
+		}
+
+		UE_LOG(LogAsymmetricStereoPass, Error, TEXT("Failed to write concat list: %s"), *ListFilePath);
+		return FString();
+	}
+}
 
-    const FString Content = FString::Join(Lines, TEXT("\n")) + TEXT("\n");
-    if (FFileHelper::SaveStringToFile(Content, *ListFilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
-    {
-        return ListFilePath;
-    }
+FString UMoviePipelineAsymmetricStereoPass::WriteConcatList(const TArray<FString>& FilePaths, const FString& ListFilePath) const
+{
+	FString Content;
+	for (const FString& Path : FilePaths)
+	{
+		AppendConcatEntry(Content, CopyTemp(Path));
+	}
+	return SaveConcatList(Content, ListFilePath);
+}
 
-    UE_LOG(LogAsymmetricStereoPass, Error, TEXT("Failed to write concat list: %s"), *ListFilePath);
-    return FString();
+FString UMoviePipelineAsymmetricStereoPass::WriteConcatList(const FAsymmetricFrameSequence& Eye, const FAsymmetricFrameRanges& Frames,
+	int32 StartIndex, int32 Count, const FString& ListFilePath) const
+{
+	FString Content;
+	Content.Reserve(Count * (Eye.Directory.Len() + Eye.Prefix.Len() + Eye.Suffix.Len() + 24));
+	Frames.ForEachFrame(StartIndex, Count, [&Eye, &Content](int32 Index, int32 Frame)
+	{
+		AppendConcatEntry(Content, Eye.GetFramePath(Frame));
+	});
+	return SaveConcatList(Content, ListFilePath);
 }
 
-void UMoviePipelineAsymmetricStereoPass::LaunchFFmpegForShot(const FShotCompositeRecord& Record)
+void UMoviePipelineAsymmetricStereoPass::EnqueueCompositeForShot(int32 RecordIndex)
 {
-	const FString FFmpegExe = ResolveFFmpegPath(FFmpegPath);
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+
+	// ImageSequence 可以完全在进程内完成，不需要 FFmpeg
+	if (CompositeMode == EAsymmetricCompositeMode::ImageSequence && bUseNativeImageCompositor)
+	{
+		EnqueueNativeComposite(RecordIndex);
+		return;
+	}
+
+	// Video 模式的长 Shot 拆成 GOP 对齐的分段并行编码，最后 stream copy 拼接
+	const int32 SegmentFrames = GetSegmentLengthFrames(Record);
+	if (SegmentFrames > 0)
+	{
+		EnqueueSegmentedComposite(RecordIndex, SegmentFrames);
+		return;
+	}
+
+	const FString FFmpegExe = FAsymmetricFFmpegArgs::ResolveExecutable(FFmpegPath);
 
 	// 写入左右眼 concat 列表文件。
 	// FFmpeg 按列表中的顺序读取，不依赖帧号模式，不需要 -start_number。
@@ -555,74 +1435,49 @@ void UMoviePipelineAsymmetricStereoPass::LaunchFFmpegForShot(const FShotComposit
 	const FString RightListPath = FPaths::Combine(Record.OutputDir,
 		FString::Printf(TEXT("_concat_right_%s.txt"), *Record.ShotName));
 
-	if (WriteConcatList(Record.LeftEyePaths,  LeftListPath).IsEmpty() ||
-		WriteConcatList(Record.RightEyePaths, RightListPath).IsEmpty())
+	if (WriteConcatList(Record.LeftEye,  Record.Frames, 0, Record.Frames.Num(), LeftListPath).IsEmpty() ||
+		WriteConcatList(Record.RightEye, Record.Frames, 0, Record.Frames.Num(), RightListPath).IsEmpty())
 	{
 		UE_LOG(LogAsymmetricStereoPass, Error,
 			TEXT("Failed to write concat lists for shot '%s', skipping."), *Record.ShotName);
+		HandleShotCompositeFinished(RecordIndex, /*bLaunched=*/false, -1, 0.0, FString());
 		return;
 	}
 
-	TempConcatFiles.Add(LeftListPath);
-	TempConcatFiles.Add(RightListPath);
-
-	const FString FilterName   = (StereoLayout == EAsymmetricStereoLayout::SideBySide) ? TEXT("hstack") : TEXT("vstack");
-	const FString LayoutName   = (StereoLayout == EAsymmetricStereoLayout::SideBySide) ? TEXT("SBS")    : TEXT("TB");
+	Record.TempFiles.Add(LeftListPath);
+	Record.TempFiles.Add(RightListPath);
 
 	// Exact fractional frame rate string, e.g. "24000/1001" for 23.976 fps
-	const FString FrameRateStr = FString::Printf(TEXT("%d/%d"),
-		Record.FrameRate.Numerator, Record.FrameRate.Denominator);
-
-	FString Args;
-	FString OutputPath;
-
-	if (CompositeMode == EAsymmetricCompositeMode::ImageSequence)
-	{
-		// 从第一个左眼文件推导输出扩展名，保持和源文件格式一致
-		const FString Extension = FPaths::GetExtension(Record.LeftEyePaths[0], /*bIncludeDot=*/true);
-		OutputPath = FPaths::Combine(Record.OutputDir,
-			FString::Printf(TEXT("stereo_%s_%s_%%05d%s"), *LayoutName, *Record.ShotName, *Extension));
-
-		// JPEG 用 -q:v 1（质量最高，1-31 越小越好）；PNG/EXR 本身无损，不需要质量参数。
-		const FString ExtLower = Extension.ToLower();
-		const bool bIsJpeg = ExtLower == TEXT(".jpg") || ExtLower == TEXT(".jpeg");
-		const FString QualityFlag = bIsJpeg ? TEXT("-q:v 1") : TEXT("");
-
-		// concat demuxer 不支持 -framerate，帧率用 -r 在输出端指定。
-		// -start_number 让输出帧序号与源文件帧号对齐（支持自定义起始帧）。
-		//hys 获取当前渲染帧数防止插帧
-		Args = FString::Printf(
-			TEXT("-y -r %s -f concat -safe 0 -i \"%s\" -r %s -f concat -safe 0 -i \"%s\""
-			     " -filter_complex \"[0:v][1:v]%s=inputs=2:shortest=1\" "
-				" -r %s %s -start_number %d \"%s\""),
-			*FrameRateStr, *LeftListPath, *FrameRateStr, *RightListPath, *FilterName, *FrameRateStr, *QualityFlag,
-			Record.StartFrameNumber, *OutputPath);
-	}
-	else
+	const FString FrameRateStr = FAsymmetricFFmpegArgs::GetFrameRateString(Record.FrameRate);
+
+	TArray<FString> Args;
+	AppendStereoConcatInputs(Args, FrameRateStr, LeftListPath, RightListPath, Record.Targets);
+
+	const int32 ThreadsPerTarget = GetThreadsPerTarget(FFmpegThreadsPerProcess, Record.Targets.Num());
+	for (int32 TargetIndex = 0; TargetIndex < Record.Targets.Num(); ++TargetIndex)
 	{
-		const FString Codec       = GetFFmpegCodecString(VideoCodec);
-		const FString Fmt         = GetOutputFormat(VideoCodec, OutputFormat);
-		const FString PixFmt      = GetFFmpegPixFmtForCodec(VideoCodec);
-    const FString QualityArgs = GetFFmpegQualityArgs(VideoCodec, CompositeQuality);
-		const FString StereoArgs  = GetStereoMetadataArgs(VideoCodec, StereoLayout);
-		OutputPath = FPaths::Combine(Record.OutputDir,
-			FString::Printf(TEXT("stereo_%s_%s.%s"), *LayoutName, *Record.ShotName, *Fmt));
-
-		// concat demuxer 不支持 -framerate，帧率用 -r 在输出端指定
-		//hys 获取当前渲染帧数防止插帧
-    Args = FString::Printf(
-			TEXT("-y -r %s -f concat -safe 0 -i \"%s\""
-			     " -r %s -f concat -safe 0 -i \"%s\""
-			     " -filter_complex \"[0:v][1:v]%s=inputs=2:shortest=1\" "
-			     " -r %s -c:v %s %s -pix_fmt %s %s \"%s\""),
-		*FrameRateStr,
-			*LeftListPath,
-		*FrameRateStr,
-			*RightListPath,
-			*FilterName,
-			*FrameRateStr,
-			*Codec, *QualityArgs, *PixFmt, *StereoArgs,
-			*OutputPath);
+		AppendOutputMap(Args, TargetIndex, FrameRateStr);
+
+		if (CompositeMode == EAsymmetricCompositeMode::ImageSequence)
+		{
+			// JPEG 用 -q:v 1（质量最高，1-31 越小越好）；PNG/EXR 本身无损，不需要质量参数。
+			// 输出扩展名和源文件一致
+			const FString ExtLower = Record.LeftEye.GetExtension().ToLower();
+			if (ExtLower == TEXT(".jpg") || ExtLower == TEXT(".jpeg"))
+			{
+				Args.Append({ TEXT("-q:v"), TEXT("1") });
+			}
+			FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetThreadsArg(ThreadsPerTarget));
+
+			// -start_number 让输出帧序号与源文件帧号对齐（支持自定义起始帧）
+			Args.Append({ TEXT("-start_number"), FString::FromInt(Record.StartFrameNumber),
+				FPaths::Combine(Record.OutputDir, GetTargetBaseName(Record, TargetIndex) + TEXT("_%05d") + Record.LeftEye.GetExtension()) });
+		}
+		else
+		{
+			AppendVideoEncodeArgs(Args, Record.Targets[TargetIndex], ThreadsPerTarget, /*GopFrames=*/0, /*bContainerMetadata=*/true);
+			Args.Add(GetStereoVideoOutputPath(Record, TargetIndex));
+		}
 	}
 
 	// Log concat list contents to Output Log when debug mode is on
@@ -635,64 +1490,357 @@ void UMoviePipelineAsymmetricStereoPass::LaunchFFmpegForShot(const FShotComposit
 		UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Right concat list (%s):\n%s"), *RightListPath, *RightContent);
 	}
 
-	// FFmpeg stdout/stderr 重定向到日志文件，方便排查错误。合成完成后根据调试开关决定是否删除。
-	// 通过临时 bat 文件执行，彻底规避 cmd /c 引号嵌套解析问题（Args 内部含多处双引号路径）。
-	const FString FFmpegLogPath = FPaths::Combine(Record.OutputDir,
-		FString::Printf(TEXT("_ffmpeg_log_%s.txt"), *Record.ShotName));
-	TempConcatFiles.Add(FFmpegLogPath);
-	const FString BatPath = FPaths::Combine(Record.OutputDir,
-		FString::Printf(TEXT("_ffmpeg_run_%s.bat"), *Record.ShotName));
-
-	// bat 文件中 % 需要转义为 %%，否则 cmd 会把 %0 当作批处理参数导致路径破坏。
-	// 例如 stereo_TB_%05d.jpeg 在 bat 中必须写成 stereo_TB_%%05d.jpeg。
-	FString ArgsEscaped = Args;
-	ArgsEscaped.ReplaceInline(TEXT("%"), TEXT("%%"));
+	EnqueueFFmpegJob(*CompositeScheduler, Record, FFmpegExe, MoveTemp(Args), FString(),
+		[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), RecordIndex](const FAsymmetricCompositeScheduler::FJobResult& Result)
+		{
+			UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+			if (This && This->CompositeQueue.IsValidIndex(RecordIndex))
+			{
+				AccumulateJobTelemetry(This->CompositeQueue[RecordIndex], Result, /*bCountFrames=*/true);
+				This->HandleShotCompositeFinished(RecordIndex, Result.bLaunched, Result.ReturnCode, Result.GetDuration(), Result.Log);
+			}
+		});
+}
 
-	const FString BatContent = FString::Printf(
-		TEXT("@echo off\r\n\"%s\" %s > \"%s\" 2>&1\r\n"),
-		*FFmpegExe, *ArgsEscaped, *FFmpegLogPath);
+void UMoviePipelineAsymmetricStereoPass::EnqueueNativeComposite(int32 RecordIndex)
+{
+	CompositeQueue[RecordIndex].bUsedNativeCompositor = true;
+	NativeCompositeQueue.Add(RecordIndex);
+	StartNextNativeComposite();
+}
 
-	if (!FFileHelper::SaveStringToFile(BatContent, *BatPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+void UMoviePipelineAsymmetricStereoPass::StartNextNativeComposite()
+{
+	if (bNativeCompositeRunning || NativeCompositeQueue.Num() == 0)
 	{
-		UE_LOG(LogAsymmetricStereoPass, Error,
-			TEXT("Failed to write FFmpeg bat file: %s"), *BatPath);
 		return;
 	}
-	TempConcatFiles.Add(BatPath);
+
+	const int32 RecordIndex = NativeCompositeQueue[0];
+	NativeCompositeQueue.RemoveAt(0, 1, EAllowShrinking::No);
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	Record.Telemetry.NoteStart(FPlatformTime::Seconds());
+
+	// 输出命名与 FFmpeg 路径一致
+	const int32 NumFrames = Record.GetNumFramePairs();
+	const FString ExtLower = Record.LeftEye.GetExtension().ToLower();
+
+	FAsymmetricNativeCompositor::FRequest Request;
+	Request.Quality = (ExtLower == TEXT(".jpg") || ExtLower == TEXT(".jpeg")) ? 100 : 0; // 对应 FFmpeg 的 -q:v 1
+	Request.CancelFlag = NativeCompositeCancelFlag;
+	Request.LeftPaths.Reserve(NumFrames);
+	Request.RightPaths.Reserve(NumFrames);
+	for (const FAsymmetricCompositeOutputTarget& Target : Record.Targets)
+	{
+		FAsymmetricNativeCompositor::FOutput& Output = Request.Outputs.AddDefaulted_GetRef();
+		Output.Layout = Target.Layout;
+		Output.Scale = Target.IsScaled() ? Target.Scale : 1.0f;
+		Output.Paths.Reserve(NumFrames);
+	}
+	Record.Frames.ForEachFrame([&](int32 FrameIndex, int32 Frame)
+	{
+		Request.LeftPaths.Add(Record.LeftEye.GetFramePath(Frame));
+		Request.RightPaths.Add(Record.RightEye.GetFramePath(Frame));
+		for (int32 TargetIndex = 0; TargetIndex < Request.Outputs.Num(); ++TargetIndex)
+		{
+			Request.Outputs[TargetIndex].Paths.Add(GetStereoImageOutputPath(Record, TargetIndex, FrameIndex));
+		}
+	});
+
+	UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Shot '%s': compositing %d frame pairs into %d output(s) in-process (%d queued)."),
+		*Record.ShotName, NumFrames, Request.Outputs.Num(), NativeCompositeQueue.Num());
+
+	bNativeCompositeRunning = true;
+	FAsymmetricNativeCompositor::LaunchAsync(MoveTemp(Request),
+		[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), RecordIndex, CancelFlag = NativeCompositeCancelFlag]
+		(const FAsymmetricNativeCompositor::FResult& Result)
+		{
+			UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+			if (!This || *CancelFlag)
+			{
+				return;
+			}
+
+			This->bNativeCompositeRunning = false;
+			This->CompositeQueue[RecordIndex].Telemetry.FramesEncoded = Result.NumFrames - Result.NumFailed;
+			This->HandleShotCompositeFinished(RecordIndex, /*bLaunched=*/true, Result.Succeeded() ? 0 : 1, Result.Seconds, FString());
+			This->StartNextNativeComposite();
+		});
+}
+
+int32 UMoviePipelineAsymmetricStereoPass::GetSegmentLengthFrames(const FShotCompositeRecord& Record) const
+{
+	if (CompositeMode != EAsymmetricCompositeMode::Video || !bSegmentedVideoEncode || SegmentLengthFrames <= 0)
+	{
+		return 0;
+	}
+
+	// 段长向上取整到 GOP 的整数倍，每段都以完整 GOP 开始和结束（最后一段除外）
+	const int32 GopFrames = GetSegmentGopFrames(Record);
+	const int32 SegmentFrames = FMath::DivideAndRoundUp(SegmentLengthFrames, GopFrames) * GopFrames;
+
+	const int32 NumFrames = Record.GetNumFramePairs();
+	return (NumFrames > SegmentFrames) ? SegmentFrames : 0;
+}
+
+int32 UMoviePipelineAsymmetricStereoPass::GetSegmentGopFrames(const FShotCompositeRecord& Record) const
+{
+	// 1 秒一个关键帧
+	return FMath::Max(1, FMath::RoundToInt(Record.FrameRate.AsDecimal()));
+}
+
+void UMoviePipelineAsymmetricStereoPass::EnqueueSegmentedComposite(int32 RecordIndex, int32 SegmentFrames)
+{
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	FShotSegmentState& Segments = Record.Segments;
+
+	const FString FFmpegExe    = FAsymmetricFFmpegArgs::ResolveExecutable(FFmpegPath);
+	const int32   NumFrames    = Record.GetNumFramePairs();
+	const int32   NumSegments  = FMath::DivideAndRoundUp(NumFrames, SegmentFrames);
+	const int32   GopFrames    = GetSegmentGopFrames(Record);
+
+	const FString FrameRateStr = FAsymmetricFFmpegArgs::GetFrameRateString(Record.FrameRate);
+	const int32   NumTargets   = Record.Targets.Num();
 
 	UE_LOG(LogAsymmetricStereoPass, Log,
-		TEXT("Launching FFmpeg for shot '%s':\n  %s %s"), *Record.ShotName, *FFmpegExe, *Args);
-	UE_LOG(LogAsymmetricStereoPass, Log, TEXT("FFmpeg output will be written to: %s"), *FFmpegLogPath);
+		TEXT("Shot '%s': splitting %d frames into %d segment(s) of %d frames (GOP %d), %d output(s) each, for parallel encoding."),
+		*Record.ShotName, NumFrames, NumSegments, SegmentFrames, GopFrames, NumTargets);
+
+	Segments = FShotSegmentState();
+	Segments.NumSegments = NumSegments;
+	Segments.NumRemaining = NumSegments;
+	Segments.SegmentFiles.SetNum(NumTargets);
+
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		const int32 FirstFrame = SegmentIndex * SegmentFrames;
+		const int32 Count = FMath::Min(SegmentFrames, NumFrames - FirstFrame);
+		const FString Tag = FString::Printf(TEXT("_seg%03d"), SegmentIndex);
+
+		const FString LeftListPath  = FPaths::Combine(Record.OutputDir,
+			FString::Printf(TEXT("_concat_left_%s%s.txt"),  *Record.ShotName, *Tag));
+		const FString RightListPath = FPaths::Combine(Record.OutputDir,
+			FString::Printf(TEXT("_concat_right_%s%s.txt"), *Record.ShotName, *Tag));
+
+		const bool bListsWritten =
+			!WriteConcatList(Record.LeftEye,  Record.Frames, FirstFrame, Count, LeftListPath).IsEmpty() &&
+			!WriteConcatList(Record.RightEye, Record.Frames, FirstFrame, Count, RightListPath).IsEmpty();
+		Record.TempFiles.Add(LeftListPath);
+		Record.TempFiles.Add(RightListPath);
+
+		// 一个分段进程同时编码所有输出版本，每个版本一个分段文件
+		TArray<FString> Args;
+		AppendStereoConcatInputs(Args, FrameRateStr, LeftListPath, RightListPath, Record.Targets);
+		const int32 ThreadsPerTarget = GetThreadsPerTarget(FFmpegThreadsPerProcess, NumTargets);
+		for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+		{
+			// 分段统一用 MKV 封装：两种编码器都支持，拼接时时间戳处理最稳定
+			const FString SegmentPath = FPaths::Combine(Record.OutputDir,
+				FString::Printf(TEXT("_segment_%s%s_%d.mkv"), *Record.ShotName, *Tag, TargetIndex));
+			Record.TempFiles.Add(SegmentPath);
+			Segments.SegmentFiles[TargetIndex].Add(SegmentPath);
+
+			AppendOutputMap(Args, TargetIndex, FrameRateStr);
+			AppendVideoEncodeArgs(Args, Record.Targets[TargetIndex], ThreadsPerTarget, GopFrames, /*bContainerMetadata=*/false);
+			Args.Add(SegmentPath);
+		}
+
+		if (bListsWritten)
+		{
+			EnqueueFFmpegJob(*CompositeScheduler, Record, FFmpegExe, MoveTemp(Args), Tag,
+				[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), RecordIndex](const FAsymmetricCompositeScheduler::FJobResult& Result)
+				{
+					UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+					if (This && This->CompositeQueue.IsValidIndex(RecordIndex))
+					{
+						AccumulateJobTelemetry(This->CompositeQueue[RecordIndex], Result, /*bCountFrames=*/true);
+						This->HandleSegmentFinished(RecordIndex, Result.bLaunched, Result.ReturnCode, Result.StartTime, Result.Log);
+					}
+				});
+		}
+		else
+		{
+			UE_LOG(LogAsymmetricStereoPass, Error,
+				TEXT("Failed to prepare segment %d of shot '%s'."), SegmentIndex, *Record.ShotName);
+			HandleSegmentFinished(RecordIndex, /*bLaunched=*/false, -1, FPlatformTime::Seconds(), FString());
+		}
+	}
+}
+
+void UMoviePipelineAsymmetricStereoPass::HandleSegmentFinished(int32 RecordIndex, bool bLaunched, int32 ReturnCode, double StartTime, const FString& FFmpegLog)
+{
+	if (!CompositeQueue.IsValidIndex(RecordIndex))
+	{
+		return;
+	}
 
-	const FString CmdExe = TEXT("cmd.exe");
-	const FString CmdArgs = FString::Printf(TEXT("/c \"%s\""), *BatPath);
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+	FShotSegmentState& Segments = Record.Segments;
 
-	ActiveFFmpegProcess = FPlatformProcess::CreateProc(
-		*CmdExe, *CmdArgs,
-		/*bLaunchDetached=*/false,
-		/*bLaunchHidden=*/true,
-		/*bLaunchReallyHidden=*/true,
-		nullptr, 0, nullptr, nullptr);
+	Segments.StartTime = (Segments.StartTime > 0.0) ? FMath::Min(Segments.StartTime, StartTime) : StartTime;
+	if (!Segments.bFailed && !(bLaunched && ReturnCode == 0))
+	{
+		// 只保留第一个失败段的信息，其余段照常跑完再统一报告
+		Segments.bFailed = true;
+		Segments.bFailureLaunched = bLaunched;
+		Segments.FailureReturnCode = ReturnCode;
+		Segments.FailureLog = FFmpegLog;
+	}
 
-	if (!ActiveFFmpegProcess.IsValid())
+	if (--Segments.NumRemaining > 0)
 	{
-		UE_LOG(LogAsymmetricStereoPass, Error,
-			TEXT("Failed to launch FFmpeg for shot '%s'. "
-			     "Check FFmpegPath or run ThirdParty/FFmpeg/download_ffmpeg.ps1."),
-			*Record.ShotName);
+		return;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - Segments.StartTime;
+	if (Segments.bFailed)
+	{
+		HandleShotCompositeFinished(RecordIndex, Segments.bFailureLaunched, Segments.FailureReturnCode, Elapsed, Segments.FailureLog);
+		return;
 	}
+
+	UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Shot '%s': %d segment(s) encoded in %.1f s, joining."),
+		*Record.ShotName, Segments.NumSegments, Elapsed);
+	EnqueueSegmentJoin(RecordIndex);
 }
 
-void UMoviePipelineAsymmetricStereoPass::DeleteSourceFiles(const FShotCompositeRecord& Record) const
+void UMoviePipelineAsymmetricStereoPass::EnqueueSegmentJoin(int32 RecordIndex)
 {
-	int32 Deleted = 0;
-	for (const FString& Path : Record.LeftEyePaths)
+	FShotCompositeRecord& Record = CompositeQueue[RecordIndex];
+
+	const FString FFmpegExe = FAsymmetricFFmpegArgs::ResolveExecutable(FFmpegPath);
+	const double StartTime = Record.Segments.StartTime;
+	const int32 NumTargets = Record.Targets.Num();
+
+	// 一个进程拼接所有版本：每个版本一个 concat 输入，各自 stream copy 到自己的输出
+	TArray<FString> Args = { TEXT("-y") };
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+	{
+		const FString ListPath = FPaths::Combine(Record.OutputDir,
+			FString::Printf(TEXT("_concat_segments_%s_%d.txt"), *Record.ShotName, TargetIndex));
+		if (WriteConcatList(Record.Segments.SegmentFiles[TargetIndex], ListPath).IsEmpty())
+		{
+			HandleShotCompositeFinished(RecordIndex, /*bLaunched=*/false, -1, FPlatformTime::Seconds() - StartTime, FString());
+			return;
+		}
+		Record.TempFiles.Add(ListPath);
+		Args.Append({ TEXT("-f"), TEXT("concat"), TEXT("-safe"), TEXT("0"), TEXT("-i"), ListPath });
+	}
+
+	// 分段已编码完成，这里只做 stream copy 拼接，容器级立体元数据在这一步写入
+	for (int32 TargetIndex = 0; TargetIndex < NumTargets; ++TargetIndex)
+	{
+		const FAsymmetricCompositeOutputTarget& Target = Record.Targets[TargetIndex];
+		Args.Append({ TEXT("-map"), FString::Printf(TEXT("%d:v"), TargetIndex), TEXT("-c"), TEXT("copy") });
+		FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetStereoContainerArgs(Target.VideoCodec, Target.Layout));
+		Args.Add(GetStereoVideoOutputPath(Record, TargetIndex));
+	}
+
+	EnqueueFFmpegJob(*CompositeScheduler, Record, FFmpegExe, MoveTemp(Args), FString(),
+		[WeakThis = TWeakObjectPtr<UMoviePipelineAsymmetricStereoPass>(this), RecordIndex, StartTime](const FAsymmetricCompositeScheduler::FJobResult& Result)
+		{
+			UMoviePipelineAsymmetricStereoPass* This = WeakThis.Get();
+			if (This && This->CompositeQueue.IsValidIndex(RecordIndex))
+			{
+				AccumulateJobTelemetry(This->CompositeQueue[RecordIndex], Result, /*bCountFrames=*/false);
+				This->HandleShotCompositeFinished(RecordIndex, Result.bLaunched, Result.ReturnCode, Result.EndTime - StartTime, Result.Log);
+			}
+		});
+}
+
+void UMoviePipelineAsymmetricStereoPass::WriteCompositeReports() const
+{
+	TMap<FString, TArray<const FShotCompositeRecord*>> RecordsByDir;
+	for (const FShotCompositeRecord& Record : CompositeQueue)
 	{
-		if (IFileManager::Get().Delete(*Path)) { ++Deleted; }
+		RecordsByDir.FindOrAdd(Record.OutputDir).Add(&Record);
 	}
-	for (const FString& Path : Record.RightEyePaths)
+
+	for (const TPair<FString, TArray<const FShotCompositeRecord*>>& Pair : RecordsByDir)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+		int64 TotalFrames = 0, TotalRead = 0, TotalWritten = 0;
+		double TotalCpu = 0.0, FirstQueued = TNumericLimits<double>::Max(), LastEnd = 0.0;
+		int32 NumFailed = 0;
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("generated"), FDateTime::Now().ToIso8601());
+		Writer->WriteValue(TEXT("layout"), FAsymmetricFFmpegArgs::GetLayoutName(StereoLayout));
+		Writer->WriteValue(TEXT("mode"), CompositeMode == EAsymmetricCompositeMode::Video ? TEXT("video") : TEXT("image_sequence"));
+		Writer->WriteArrayStart(TEXT("shots"));
+		for (const FShotCompositeRecord* Record : Pair.Value)
+		{
+			const FShotCompositeTelemetry& Telemetry = Record->Telemetry;
+			const double EncodeSeconds = Telemetry.GetEncodeSeconds();
+
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("shot"), Record->ShotName);
+			Writer->WriteValue(TEXT("pass"), Record->PassName);
+			Writer->WriteValue(TEXT("method"), Record->bUsedNativeCompositor ? TEXT("native") : TEXT("ffmpeg"));
+			Writer->WriteValue(TEXT("status"), GetCompositeStatusName(*Record));
+			Writer->WriteValue(TEXT("return_code"), Record->CompositeReturnCode);
+			Writer->WriteValue(TEXT("frame_pairs"), Record->GetNumFramePairs());
+			Writer->WriteValue(TEXT("outputs"), Record->Targets.Num());
+			Writer->WriteValue(TEXT("frames_encoded"), Telemetry.FramesEncoded);
+			Writer->WriteValue(TEXT("encode_fps"), Telemetry.GetEncodeFps());
+			Writer->WriteValue(TEXT("bytes_read"), Telemetry.BytesRead);
+			Writer->WriteValue(TEXT("bytes_written"), Telemetry.BytesWritten);
+			Writer->WriteValue(TEXT("read_mb_per_s"), EncodeSeconds > 0.0 ? Telemetry.BytesRead / BytesPerMB / EncodeSeconds : 0.0);
+			Writer->WriteValue(TEXT("write_mb_per_s"), EncodeSeconds > 0.0 ? Telemetry.BytesWritten / BytesPerMB / EncodeSeconds : 0.0);
+			Writer->WriteValue(TEXT("wall_seconds"), Telemetry.GetWallSeconds());
+			Writer->WriteValue(TEXT("queue_wait_seconds"), Telemetry.GetQueueWaitSeconds());
+			Writer->WriteValue(TEXT("encode_seconds"), EncodeSeconds);
+			Writer->WriteValue(TEXT("cpu_seconds"), Telemetry.CpuSeconds);
+			// CPU 时间 / 编码时间：接近 -threads 说明编码吃满 CPU，明显偏低说明在等磁盘或卡住
+			Writer->WriteValue(TEXT("cpu_cores_busy"), EncodeSeconds > 0.0 ? Telemetry.CpuSeconds / EncodeSeconds : 0.0);
+			Writer->WriteObjectEnd();
+
+			TotalFrames += Telemetry.FramesEncoded;
+			TotalRead += Telemetry.BytesRead;
+			TotalWritten += Telemetry.BytesWritten;
+			TotalCpu += Telemetry.CpuSeconds;
+			NumFailed += Record->bCompositeSucceeded ? 0 : 1;
+			FirstQueued = FMath::Min(FirstQueued, Telemetry.QueuedTime);
+			LastEnd = FMath::Max(LastEnd, Telemetry.EndTime);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectStart(TEXT("totals"));
+		Writer->WriteValue(TEXT("shots"), Pair.Value.Num());
+		Writer->WriteValue(TEXT("failed"), NumFailed);
+		Writer->WriteValue(TEXT("frames_encoded"), TotalFrames);
+		Writer->WriteValue(TEXT("bytes_read"), TotalRead);
+		Writer->WriteValue(TEXT("bytes_written"), TotalWritten);
+		Writer->WriteValue(TEXT("cpu_seconds"), TotalCpu);
+		Writer->WriteValue(TEXT("wall_seconds"), LastEnd > FirstQueued ? LastEnd - FirstQueued : 0.0);
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+
+		const FString ReportPath = FPaths::Combine(Pair.Key, TEXT("stereo_composite_report.json"));
+		if (FFileHelper::SaveStringToFile(Json, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogAsymmetricStereoPass, Log, TEXT("Composite report written to %s"), *ReportPath);
+		}
+		else
+		{
+			UE_LOG(LogAsymmetricStereoPass, Warning, TEXT("Failed to write composite report: %s"), *ReportPath);
+		}
+	}
+}
+
+void UMoviePipelineAsymmetricStereoPass::DeleteSourceFiles(const FShotCompositeRecord& Record) const
+{
+	// 两眼各自的全部帧（包括另一眼缺帧、没参与合成的）
+	int32 Deleted = 0;
+	for (const FAsymmetricFrameSequence* Eye : { &Record.LeftEye, &Record.RightEye })
 	{
-		if (IFileManager::Get().Delete(*Path)) { ++Deleted; }
+		Eye->Frames.ForEachFrame([Eye, &Deleted](int32 Index, int32 Frame)
+		{
+			if (IFileManager::Get().Delete(*Eye->GetFramePath(Frame))) { ++Deleted; }
+		});
 	}
 	UE_LOG(LogAsymmetricStereoPass, Log,
 		TEXT("Deleted %d source eye files for shot '%s'."), Deleted, *Record.ShotName);
@@ -0,0 +1,232 @@
+// MRQ 立体流式输出实现
+
+#include "MoviePipelineAsymmetricStereoStreamOutput.h"
+#include "MoviePipelineAsymmetricStereoPass.h"
+#include "AsymmetricFFmpegArgs.h"
+#include "AsymmetricFFmpegStream.h"
+#include "AsymmetricStereoPacker.h"
+#include "MoviePipeline.h"
+#include "MoviePipelineImageQuantization.h"
+#include "MoviePipelinePrimaryConfig.h"
+#include "MovieRenderPipelineDataTypes.h"
+#include "ImagePixelData.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAsymmetricStereoStreamOutput, Log, All);
+
+UMoviePipelineAsymmetricStereoStreamOutput::UMoviePipelineAsymmetricStereoStreamOutput()
+{
+	MaxQueuedFrames = 3;
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame)
+{
+	PollClosingStreams();
+
+	TArray<FStereoEyeImages, TInlineAllocator<4>> Passes;
+	if (!GetEyeImages(*InMergedOutputFrame, Passes))
+	{
+		return;
+	}
+
+	const FMoviePipelineFrameOutputState& FrameState = InMergedOutputFrame->FrameOutputState;
+	if (ActiveShotIndex != FrameState.ShotIndex)
+	{
+		CloseActiveStreams();
+		ActiveShotIndex = FrameState.ShotIndex;
+	}
+
+	// 每个 Pass 一路视频，两眼只在同一 Pass 内配对
+	for (const FStereoEyeImages& Pass : Passes)
+	{
+		WritePassFrame(FrameState, Pass);
+	}
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::WritePassFrame(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass)
+{
+	FPassStream& PassStream = ActiveStreams.FindOrAdd(InPass.PassName);
+	if (PassStream.bFailed)
+	{
+		return;
+	}
+
+	// 编码器吃 8 位 sRGB BGRA，和 MRQ 自带视频输出的量化方式一致
+	const TUniquePtr<FImagePixelData> LeftQuantized  = UE::MoviePipeline::QuantizeImagePixelDataToBitDepth(InPass.Left, 8);
+	const TUniquePtr<FImagePixelData> RightQuantized = UE::MoviePipeline::QuantizeImagePixelDataToBitDepth(InPass.Right, 8);
+	if (!LeftQuantized.IsValid() || !RightQuantized.IsValid() || LeftQuantized->GetSize() != RightQuantized->GetSize())
+	{
+		UE_LOG(LogAsymmetricStereoStreamOutput, Error, TEXT("Pass '%s': eye images could not be quantized or differ in size, skipping frame."),
+			*InPass.PassName);
+		return;
+	}
+
+	const EAsymmetricStereoLayout Layout = GetStereoPass()->StereoLayout;
+	const FIntPoint EyeSize = LeftQuantized->GetSize();
+	const FIntPoint PackedSize = FAsymmetricStereoPacker::GetPackedSize(EyeSize, Layout);
+
+	if (!PassStream.Stream.IsValid())
+	{
+		PassStream.Stream = OpenStream(InFrameOutputState, InPass, PackedSize);
+		if (!PassStream.Stream.IsValid())
+		{
+			PassStream.bFailed = true;
+			return;
+		}
+		PassStream.StartTime = FPlatformTime::Seconds();
+	}
+
+	const void* LeftData = nullptr;
+	const void* RightData = nullptr;
+	int64 LeftBytes = 0;
+	int64 RightBytes = 0;
+	LeftQuantized->GetRawData(LeftData, LeftBytes);
+	RightQuantized->GetRawData(RightData, RightBytes);
+
+	// 量化结果直接打包进要送给管道的缓冲，之后所有权移交写线程，不再拷贝
+	TArray64<uint8> Packed;
+	Packed.SetNumUninitialized(int64(PackedSize.X) * PackedSize.Y * sizeof(FColor));
+	FAsymmetricStereoPacker::Pack(static_cast<const uint8*>(LeftData), static_cast<const uint8*>(RightData),
+		EyeSize, sizeof(FColor), Layout, Packed.GetData());
+
+	if (!PassStream.Stream->WriteFrame(MoveTemp(Packed)))
+	{
+		UE_LOG(LogAsymmetricStereoStreamOutput, Error, TEXT("FFmpeg for '%s' is no longer accepting frames, skipping the rest of the shot."),
+			*PassStream.Stream->GetName());
+		CloseStream(PassStream);
+		PassStream.bFailed = true;
+	}
+}
+
+TSharedPtr<FAsymmetricFFmpegStream> UMoviePipelineAsymmetricStereoStreamOutput::OpenStream(const FMoviePipelineFrameOutputState& InFrameOutputState,
+	const FStereoEyeImages& InPass, const FIntPoint& InPackedSize)
+{
+	const UMoviePipelineAsymmetricStereoPass* Pass = GetStereoPass();
+	const FString ShotName = GetShotName(InFrameOutputState.ShotIndex) + GetPassSuffix(InPass);
+
+	if ((InPackedSize.X & 1) || (InPackedSize.Y & 1))
+	{
+		UE_LOG(LogAsymmetricStereoStreamOutput, Error,
+			TEXT("Shot '%s': packed size %dx%d must be even for yuv420p, skipping shot."), *ShotName, InPackedSize.X, InPackedSize.Y);
+		return nullptr;
+	}
+
+	const FString OutputDir = ResolveOutputDirectory(InFrameOutputState);
+	IFileManager::Get().MakeDirectory(*OutputDir, /*Tree=*/true);
+
+	const FString Fmt = FAsymmetricFFmpegArgs::GetOutputFormat(Pass->VideoCodec, Pass->OutputFormat);
+	const FString OutputPath = FPaths::Combine(OutputDir,
+		FString::Printf(TEXT("stereo_%s_%s.%s"), FAsymmetricFFmpegArgs::GetLayoutName(Pass->StereoLayout), *ShotName, *Fmt));
+
+	const FFrameRate FrameRate = GetPipeline()->GetPipelinePrimaryConfig()->GetEffectiveFrameRate(GetPipeline()->GetTargetSequence());
+
+	// stdin 上是紧密排列的 BGRA 帧，尺寸和帧率必须显式给出
+	TArray<FString> Args = {
+		TEXT("-y"), TEXT("-loglevel"), TEXT("error"),
+		TEXT("-f"), TEXT("rawvideo"), TEXT("-pix_fmt"), TEXT("bgra"),
+		TEXT("-s"), FString::Printf(TEXT("%dx%d"), InPackedSize.X, InPackedSize.Y),
+		TEXT("-r"), FAsymmetricFFmpegArgs::GetFrameRateString(FrameRate),
+		TEXT("-i"), TEXT("-"),
+		TEXT("-c:v"), FAsymmetricFFmpegArgs::GetCodecString(Pass->VideoCodec) };
+	FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetQualityArgs(Pass->VideoCodec, Pass->CompositeQuality));
+	Args.Append({ TEXT("-pix_fmt"), FAsymmetricFFmpegArgs::GetPixFmt(Pass->VideoCodec) });
+	FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetStereoMetadataArgs(Pass->VideoCodec, Pass->StereoLayout));
+	FAsymmetricFFmpegArgs::Append(Args, FAsymmetricFFmpegArgs::GetThreadsArg(Pass->FFmpegThreadsPerProcess));
+	Args.Add(OutputPath);
+
+	TSharedPtr<FAsymmetricFFmpegStream> Stream = MakeShared<FAsymmetricFFmpegStream>(ShotName, MaxQueuedFrames);
+	if (!Stream->Start(FAsymmetricFFmpegArgs::ResolveExecutable(Pass->FFmpegPath), Args))
+	{
+		UE_LOG(LogAsymmetricStereoStreamOutput, Error,
+			TEXT("Failed to start FFmpeg for shot '%s'. Check FFmpegPath on the Asymmetric Stereo pass."), *ShotName);
+		return nullptr;
+	}
+
+	UE_LOG(LogAsymmetricStereoStreamOutput, Log, TEXT("Shot '%s': streaming %dx%d %s frames to %s"),
+		*ShotName, InPackedSize.X, InPackedSize.Y, FAsymmetricFFmpegArgs::GetLayoutName(Pass->StereoLayout), *OutputPath);
+	return Stream;
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::CloseStream(FPassStream& InPassStream)
+{
+	if (!InPassStream.Stream.IsValid())
+	{
+		return;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - InPassStream.StartTime;
+	UE_LOG(LogAsymmetricStereoStreamOutput, Log,
+		TEXT("Shot '%s': %lld frame(s) streamed in %.1f s, rendering waited %.1f s on the encoder."),
+		*InPassStream.Stream->GetName(), InPassStream.Stream->GetFramesWritten(), Elapsed, InPassStream.Stream->GetBlockedSeconds());
+
+	InPassStream.Stream->Close();
+	ClosingStreams.Add(MoveTemp(InPassStream.Stream));
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::CloseActiveStreams()
+{
+	for (TPair<FString, FPassStream>& Pair : ActiveStreams)
+	{
+		CloseStream(Pair.Value);
+	}
+	ActiveStreams.Reset();
+	ActiveShotIndex = INDEX_NONE;
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::PollClosingStreams()
+{
+	for (int32 Index = ClosingStreams.Num() - 1; Index >= 0; --Index)
+	{
+		int32 ReturnCode = 0;
+		if (!ClosingStreams[Index]->PollFinished(ReturnCode))
+		{
+			continue;
+		}
+
+		if (ReturnCode == 0)
+		{
+			UE_LOG(LogAsymmetricStereoStreamOutput, Log, TEXT("FFmpeg finished shot '%s'."), *ClosingStreams[Index]->GetName());
+		}
+		else
+		{
+			UE_LOG(LogAsymmetricStereoStreamOutput, Error, TEXT("FFmpeg exited with code %d for shot '%s'. FFmpeg output:\n%s"),
+				ReturnCode, *ClosingStreams[Index]->GetName(), *ClosingStreams[Index]->GetLogTail());
+		}
+		ClosingStreams.RemoveAtSwap(Index);
+	}
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::OnShotFinishedImpl(const UMoviePipelineExecutorShot* InShot, const bool bFlushToDisk)
+{
+	// 不等编码器收尾，下一个 Shot 可以立刻开始渲染
+	CloseActiveStreams();
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::BeginFinalizeImpl()
+{
+	CloseActiveStreams();
+}
+
+bool UMoviePipelineAsymmetricStereoStreamOutput::HasFinishedProcessingImpl()
+{
+	PollClosingStreams();
+	return ActiveStreams.Num() == 0 && ClosingStreams.Num() == 0;
+}
+
+void UMoviePipelineAsymmetricStereoStreamOutput::TeardownForPipelineImpl(UMoviePipeline* InPipeline)
+{
+	// 正常流程下这里已经全部结束；渲染被取消时析构会终止仍在运行的 FFmpeg
+	ActiveStreams.Reset();
+	ClosingStreams.Reset();
+	ActiveShotIndex = INDEX_NONE;
+
+	Super::TeardownForPipelineImpl(InPipeline);
+}
+
+#if WITH_EDITOR
+FText UMoviePipelineAsymmetricStereoStreamOutput::GetDisplayText() const
+{
+	return NSLOCTEXT("MovieRenderPipeline", "AsymmetricStereoStreamOutput_DisplayName", "Asymmetric Stereo Stream (FFmpeg)");
+}
+#endif
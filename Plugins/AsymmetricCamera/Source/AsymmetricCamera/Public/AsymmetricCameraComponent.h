@@ -5,10 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
 #include "AsymmetricStereoTypes.h"
+#include "AsymmetricProjectionKernel.h"
+#include "AsymmetricProjectionState.h"
+#include "AsymmetricDoubleBuffer.h"
 #include "AsymmetricCameraComponent.generated.h"
 
-class FAsymmetricViewExtension;
+class FAsymmetricMultiViewDevice;
 class UAsymmetricScreenComponent;
+struct FAsymmetricTrackingSample;
 
 /**
  * 离轴/非对称视锥投影相机组件
@@ -16,7 +20,8 @@ class UAsymmetricScreenComponent;
  * 和 nDisplay 的投影计算方式对齐。
  *
  * 高性能路径：通过 ISceneViewExtension 直接覆盖玩家相机的投影矩阵，
- * 不需要 Render Target 或 SceneCapture。
+ * 不需要 Render Target 或 SceneCapture。视图扩展由 UAsymmetricCameraSubsystem 统一持有，
+ * 组件在 BeginPlay / EndPlay 时登记和注销。
  *
  * 需要一个同级的 UAsymmetricScreenComponent 来定义投影屏幕。
  * 眼睛位置 = 组件的世界坐标（设了 TrackedActor 就用它的位置）。
@@ -60,7 +65,8 @@ public:
 
 	/** 开关：MRQ（Movie Render Queue）离线渲染时也应用非对称投影。
 	 *  开启后可将此组件挂到 CineCameraActor 上，配合 Sequencer + MRQ 使用。
-	 *  MRQ 的 tiling 高分辨率渲染与非对称投影不兼容，建议 tiling 设为 1x1。 */
+	 *  MRQ 高分辨率 tiling 需要用 Asymmetric Stereo Pass（Mono 布局也可以）渲染：每个 Tile 按离轴视锥切出子视锥（含重叠边），
+	 *  和不分块的结果一致；默认 Deferred Pass 不提供 Tile 信息，tiling 仍需设为 1x1。 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera")
 	bool bEnableMRQSupport;
 
@@ -92,29 +98,105 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Debug", meta = (EditCondition = "bShowDebugFrustum"))
 	bool bShowStereoFrustums;
 
-	/** 运行时也显示调试可视化（DrawDebugLine） */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Debug")
+	/** 运行时也显示调试可视化（DrawDebugLine）。开启时组件才需要 Tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetShowDebugInGame, Category = "Asymmetric Camera|Debug")
 	bool bShowDebugInGame;
 
 	/** 可选：跟踪的 Actor，用它的位置作为眼睛位置。不设就用组件自身的世界坐标。 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking")
 	AActor* TrackedActor;
 
-	/** 开关：Owner Actor 的 Transform 完全跟随此相机。
-	 *  用于 MRQ 渲染场景：Sequencer 驱动电影相机动画，非对称相机自动同步位置和旋转。 */
+	/** 开关：直接从追踪子系统读取眼睛位置（UDP 追踪器），不经过 Actor Transform。
+	 *  追踪坐标按 Owner Actor 的局部空间解释（追踪原点 = Actor 原点）。
+	 *  采样超时（追踪器断开）时回退到 TrackedActor / 组件位置。 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking")
+	bool bUseTrackingSubsystem;
+
+	/** 使用哪个传感器的数据（对应包里的 SensorId） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking", meta = (ClampMin = "0", ClampMax = "15", EditCondition = "bUseTrackingSubsystem"))
+	int32 TrackingSensorId;
+
+	/** 追踪数据 UDP 端口，BeginPlay 时自动启动接收（多个相机共用同一个接收端） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking", meta = (ClampMin = "1", ClampMax = "65535", EditCondition = "bUseTrackingSubsystem"))
+	int32 TrackingPort;
+
+	/** 采样超过这个时间（秒）没更新就视为追踪丢失 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking", meta = (ClampMin = "0.01", EditCondition = "bUseTrackingSubsystem"))
+	float TrackingTimeout;
+
+	/** 开关：渲染线程 late latch。渲染开始前重新读一次最新追踪采样并重算投影，
+	 *  把游戏线程采样到画面显示之间的延迟再缩短 1~2 帧，CAVE 里能明显减少画面"游动"。
+	 *  只对运行时单屏路径生效，stat AsymmetricCamera 可对比两种采样的年龄。 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking", meta = (EditCondition = "bUseTrackingSubsystem"))
+	bool bLateLatchEyePosition;
+
+	/** 开关：Owner Actor 的 Transform 完全跟随此相机。
+	 *  用于 MRQ 渲染场景：Sequencer 驱动电影相机动画，非对称相机自动同步位置和旋转。
+	 *  组件的 Tick 以目标相机的 Tick 为前置，同一帧内拿到目标动画后的 Transform。 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetFollowTargetCamera, Category = "Asymmetric Camera|Tracking")
 	bool bFollowTargetCamera;
 
 	/** 要跟随的目标相机 Actor（通常是 CineCameraActor）。
 	 *  开启 bFollowTargetCamera 后，Owner Actor 每帧同步此相机的 Transform。 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Tracking", meta = (EditCondition = "bFollowTargetCamera"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetTargetCamera, Category = "Asymmetric Camera|Tracking", meta = (EditCondition = "bFollowTargetCamera"))
 	AActor* TargetCamera;
 
+	/** 跟随方式。Move Owner Actor：每帧移动 Owner（子组件、碰撞重叠、渲染代理都要更新）；
+	 *  Virtual Parent：Actor 不动，屏幕、眼睛和追踪原点在计算投影时按目标相机位姿换算，组件也不需要 Tick。
+	 *  Virtual Parent 下场景里的 Rig 网格仍留在原处，只有投影跟随。 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetFollowMode, Category = "Asymmetric Camera|Tracking", meta = (EditCondition = "bFollowTargetCamera"))
+	EAsymmetricFollowMode FollowMode;
+
+	UFUNCTION(BlueprintSetter)
+	void SetShowDebugInGame(bool bInShowDebugInGame);
+
+	UFUNCTION(BlueprintSetter)
+	void SetFollowTargetCamera(bool bInFollowTargetCamera);
+
+	UFUNCTION(BlueprintSetter)
+	void SetTargetCamera(AActor* InTargetCamera);
+
+	UFUNCTION(BlueprintSetter)
+	void SetFollowMode(EAsymmetricFollowMode InFollowMode);
+
+	/** 正在以 Virtual Parent 方式跟随目标相机（只在 BeginPlay 之后生效，编辑器里 Rig 保持原位显示） */
+	bool IsVirtualParentActive() const;
+
+	/**
+	 * Virtual Parent 模式下从 Rig 实际位置到跟随位置的刚体变换：把 Owner 的位姿换成目标相机的位姿，
+	 * 其余（Rig 内部的相对布局、缩放）不变。没有启用时返回单位变换。
+	 */
+	FTransform GetVirtualParentDelta() const;
+
 	/** 关联的屏幕组件，定义投影平面。
 	 *  自动查找同 Actor 上的 AsymmetricScreenComponent，也可手动指定。 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera")
 	TObjectPtr<UAsymmetricScreenComponent> ScreenComponent;
 
+	// ---- 多屏模式（CAVE / LED 多面墙） ----
+
+	/** 开关：多屏模式。一只追踪眼驱动 ScreenComponents 里的所有屏幕，
+	 *  每块屏幕作为同一个 ViewFamily 里的一个 View 渲染，共享场景遍历、GPU Scene 上传和阴影。
+	 *  运行时通过立体渲染设备接口提供多 View；已有 XR/HMD 设备时不会启用。 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Multi Screen")
+	bool bMultiScreen;
+
+	/** 多屏模式下渲染的屏幕列表，顺序即 View 顺序 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Multi Screen", meta = (EditCondition = "bMultiScreen"))
+	TArray<TObjectPtr<UAsymmetricScreenComponent>> ScreenComponents;
+
+	/** 各屏幕 View 在后台缓冲区里的排布方式 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Multi Screen", meta = (EditCondition = "bMultiScreen"))
+	EAsymmetricMultiScreenLayout MultiScreenLayout;
+
+	/** 网格列数（0 = 按屏幕数量自动取接近正方形的列数） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Multi Screen", meta = (ClampMin = "0", EditCondition = "bMultiScreen && MultiScreenLayout == EAsymmetricMultiScreenLayout::Grid"))
+	int32 GridColumns;
+
+	/** 自定义输出矩形（归一化），和 ScreenComponents 一一对应；缺少的项按网格排布 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera|Multi Screen", meta = (EditCondition = "bMultiScreen && MultiScreenLayout == EAsymmetricMultiScreenLayout::Custom"))
+	TArray<FAsymmetricViewportRect> CustomViewRects;
+
 	// ---- 外部数据输入（对接 Max/Maya 等外部工具） ----
 
 	/** 开关：使用外部数据代替 ScreenComponent */
@@ -171,11 +253,21 @@ public:
 
 	/**
 	 * 获取眼睛的世界坐标。
-	 * 优先级：TrackedActor > 组件自身位置
+	 * 优先级：外部数据 > 追踪子系统（采样未超时）> TrackedActor > 组件自身位置
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
 	FVector GetEyePosition() const;
 
+	/** 从追踪子系统读取最新采样并转换到世界坐标；未启用、没有数据或采样超时返回 false */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Tracking")
+	bool GetTrackedEyePosition(FVector& OutEyePosition) const;
+
+	/** 读取追踪子系统最新采样（未启用、没有数据或超时返回 false），位置是追踪坐标 */
+	bool GetTrackedEyeSample(FAsymmetricTrackingSample& OutSample) const;
+
+	/** 追踪坐标到世界坐标的变换（追踪原点 = Owner Actor 原点） */
+	FTransform GetTrackingToWorld() const;
+
 	/**
 	 * 计算离轴投影。
 	 * @param EyePosition - 眼睛世界坐标
@@ -186,8 +278,62 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
 	bool CalculateOffAxisProjection(const FVector& EyePosition, FRotator& OutViewRotation, FMatrix& OutProjectionMatrix);
 
+	/**
+	 * 多屏模式：同一只眼对 ScreenComponents 里的每块屏幕批量计算离轴投影。
+	 * 输出和 ScreenComponents 一一对应，空项填单位值；没有有效屏幕时返回 false。
+	 */
+	bool CalculateMultiScreenProjections(const FVector& EyePosition, TArray<FRotator>& OutViewRotations, TArray<FMatrix>& OutProjectionMatrices);
+
+	/**
+	 * 一块屏幕 View 在后台缓冲区里的归一化矩形（按 MultiScreenLayout 排布）。
+	 * ScreenIndex 是它在 ScreenComponents 里的下标（Custom 排布按它取 CustomViewRects）；
+	 * ViewIndex / NumViews 是跳过空项后的 View 序号和 View 总数（网格按它排布，不留空格）。
+	 */
+	FBox2D GetMultiScreenViewRect(int32 ScreenIndex, int32 ViewIndex, int32 NumViews) const;
+
+	/** 多屏渲染设备已安装并接管渲染 */
+	bool IsMultiScreenActive() const { return MultiViewDevice.IsValid(); }
+
+	/**
+	 * 当前生效屏幕的正交基（世界空间），供投影内核和 MRQ 眼睛偏移使用。
+	 * 结果带缓存：屏幕组件的 Transform / 尺寸或外部角点没变时直接返回上次的结果，
+	 * 眼睛移动只需要重新做几次点积。
+	 */
+	const FAsymmetricScreenBasis& GetScreenBasis() const;
+
+	/**
+	 * 把当前投影输入解析成 FAsymmetricProjectionState 并发布到双缓冲。
+	 * 已登记到 UAsymmetricCameraSubsystem 时由子系统在所有 Tick Group 之后按需调用（见 NeedsProjectionStatePublish），
+	 * 否则在组件 Tick 末尾调用；在 Tick 之外改了参数又想本帧立即生效时可以手动调用（仅游戏线程）。
+	 */
+	void PublishProjectionState();
+
+	/**
+	 * 上次发布后投影输入是否可能变了：Transform 变化通知（自身、Owner、屏幕组件）、属性修改、
+	 * 数值参数和上次发布时不同，或者眼睛/屏幕来自无法通知的来源（追踪、TrackedActor、外部数据、多屏）。
+	 */
+	bool NeedsProjectionStatePublish() const;
+
+	/** 投影状态双缓冲，登记到子系统时交给视图扩展读取。构造时创建，始终有效 */
+	TSharedRef<const TAsymmetricDoubleBuffer<FAsymmetricProjectionState>, ESPMode::ThreadSafe> GetProjectionStateBuffer() const
+	{
+		return ProjectionStateBuffer.ToSharedRef();
+	}
+
+	/** 读取最近一次发布的投影状态快照（任意线程）；还没发布过返回 false */
+	bool GetProjectionState(FAsymmetricProjectionState& OutState) const;
+
+	/** 强制下次重新计算屏幕正交基（一般不需要手动调用，输入变化会自动检测） */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	void InvalidateProjectionCache();
+
+	/** 屏幕正交基缓存的累计命中/未命中次数，用来验证缓存是否生效 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Debug")
+	void GetProjectionCacheStats(int64& OutHits, int64& OutMisses) const;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void OnRegister() override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -201,6 +347,106 @@ private:
 	/** 运行时画调试线 */
 	void DrawDebugVisualization() const;
 
-	/** 场景视图扩展，用来覆盖玩家相机投影 */
-	TSharedPtr<FAsymmetricViewExtension, ESPMode::ThreadSafe> ViewExtension;
+	/** 多屏模式：每帧把所有屏幕的 View 数据推给立体渲染设备 */
+	void UpdateMultiScreenViews();
+
+	/** 只有跟随相机、运行时调试绘制、多屏或没登记到子系统时才需要组件 Tick */
+	bool NeedsComponentTick() const;
+
+	/** 按当前设置开关组件 Tick，并把跟随的目标相机设为 Tick 前置 */
+	void RefreshTickState();
+
+	/** 屏幕组件 Transform 变化通知，换了 ScreenComponent 时重新绑定 */
+	void BindScreenTransformUpdated();
+	void UnbindScreenTransformUpdated();
+	void OnScreenTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/**
+	 * BeginPlay 时登记到了世界子系统。子系统只在 Game / PIE / Editor 世界里存在，其他世界（编辑器预览窗口等）里为 false：
+	 * 没有视图扩展，投影不会被覆盖，组件 Tick 仍然发布投影状态，只供 GetProjectionState 读取。
+	 */
+	bool bRegisteredWithSubsystem = false;
+
+	/** 当前作为 Tick 前置的目标相机 */
+	TWeakObjectPtr<AActor> TickPrerequisiteActor;
+
+	/** 已绑定 TransformUpdated 的屏幕组件 */
+	TWeakObjectPtr<UAsymmetricScreenComponent> BoundScreenComponent;
+	FDelegateHandle ScreenTransformUpdatedHandle;
+
+	/**
+	 * 投影状态里的数值参数快照。蓝图可以直接写这些属性而不经过通知，
+	 * 子系统每帧只比较这几项（不读 Transform）来判断要不要重新发布。
+	 */
+	struct FProjectionSettingsKey
+	{
+		const UAsymmetricScreenComponent* Screen = nullptr;
+		FVector2D ScreenSize = FVector2D::ZeroVector;
+		float NearClip = 0.0f;
+		float FarClip = 0.0f;
+		float EyeSeparation = 0.0f;
+		float EyeOffset = 0.0f;
+		bool bUseAsymmetricProjection = false;
+		bool bEnableMRQSupport = false;
+		bool bMatchViewportAspectRatio = false;
+
+		bool operator==(const FProjectionSettingsKey& Other) const
+		{
+			return Screen == Other.Screen && ScreenSize == Other.ScreenSize
+				&& NearClip == Other.NearClip && FarClip == Other.FarClip
+				&& EyeSeparation == Other.EyeSeparation && EyeOffset == Other.EyeOffset
+				&& bUseAsymmetricProjection == Other.bUseAsymmetricProjection
+				&& bEnableMRQSupport == Other.bEnableMRQSupport
+				&& bMatchViewportAspectRatio == Other.bMatchViewportAspectRatio;
+		}
+	};
+
+	FProjectionSettingsKey MakeProjectionSettingsKey() const;
+
+	/** 上次发布时的数值参数 */
+	FProjectionSettingsKey PublishedSettingsKey;
+
+	/** Transform 或属性变化后置位，发布后清除 */
+	bool bProjectionStateDirty = true;
+
+	/** 每帧发布的投影状态，和视图扩展共享（扩展持有引用，组件销毁后也不会悬空）。构造时创建，始终有效 */
+	TSharedPtr<TAsymmetricDoubleBuffer<FAsymmetricProjectionState>, ESPMode::ThreadSafe> ProjectionStateBuffer;
+
+	/** 多屏模式的立体渲染设备，向引擎提供 N 个 View */
+	TSharedPtr<FAsymmetricMultiViewDevice, ESPMode::ThreadSafe> MultiViewDevice;
+
+	/** 多屏批量计算的复用缓冲，避免每帧分配 */
+	FAsymmetricProjectionBatch MultiScreenBatch;
+
+	/**
+	 * 屏幕正交基缓存的输入快照。
+	 * 组件模式记录屏幕组件的位置、旋转和尺寸；外部模式记录三个角点。
+	 * 和当前输入逐项比较，任何一项变了就重算。
+	 */
+	struct FScreenBasisCacheKey
+	{
+		const UAsymmetricScreenComponent* Screen = nullptr;
+		bool    bExternal = false;
+		FVector PointA = FVector::ZeroVector;  // 组件模式：屏幕位置；外部模式：左下角
+		FVector PointB = FVector::ZeroVector;  // 组件模式：(宽, 高, 0)；外部模式：右下角
+		FVector PointC = FVector::ZeroVector;  // 外部模式：左上角
+		FQuat   Rotation = FQuat::Identity;    // 组件模式：屏幕旋转
+
+		bool operator==(const FScreenBasisCacheKey& Other) const
+		{
+			return Screen == Other.Screen && bExternal == Other.bExternal
+				&& PointA == Other.PointA && PointB == Other.PointB && PointC == Other.PointC
+				&& Rotation == Other.Rotation;
+		}
+	};
+
+	/** 根据当前输入生成缓存键 */
+	FScreenBasisCacheKey MakeScreenBasisCacheKey() const;
+
+	// 缓存只在游戏线程读写；GetScreenBasis 是 const 接口，所以用 mutable
+	mutable FScreenBasisCacheKey CachedScreenBasisKey;
+	mutable FAsymmetricScreenBasis CachedScreenBasis;
+	mutable bool bScreenBasisCacheValid = false;
+	mutable int64 ProjectionCacheHits = 0;
+	mutable int64 ProjectionCacheMisses = 0;
 };
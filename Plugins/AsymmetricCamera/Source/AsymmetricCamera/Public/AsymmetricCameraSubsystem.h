@@ -0,0 +1,112 @@
+// 世界子系统：登记场景里的非对称相机和屏幕，持有唯一的视图扩展，每帧逐个发布输入有变化的相机的投影状态
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AsymmetricCameraSubsystem.generated.h"
+
+class UAsymmetricCameraComponent;
+class UAsymmetricScreenComponent;
+class FAsymmetricViewExtension;
+class FAsymmetricCameraRegistry;
+class FSceneViewStateInterface;
+
+/**
+ * 非对称相机的世界子系统（Game / PIE / Editor 世界）。
+ *
+ * - 相机和屏幕组件在 BeginPlay / EndPlay 时登记和注销，不论当时是否启用离轴投影；
+ *   运行中切换 bUseAsymmetricProjection 立即生效，不需要重新注册视图扩展。
+ * - 整个世界只有一个 FAsymmetricViewExtension，每个 View 只查一次表（按 View 的 Actor，
+ *   查不到用活动相机），不再是每个 View 依次调用每个相机的扩展。
+ * - 所有已登记相机的投影状态在子系统 Tick 里一次发布（在所有 Tick Group 之后、渲染之前），
+ *   输入没变的相机跳过；组件只在跟随、调试绘制、多屏时才 Tick。
+ *
+ * 活动相机（运行时驱动玩家视图的那个）：SetActiveCamera 指定的优先；
+ * 否则取第一个玩家当前 ViewTarget 上的相机；再否则取最后登记且启用了离轴投影的相机。
+ */
+UCLASS()
+class ASYMMETRICCAMERA_API UAsymmetricCameraSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem / UWorldSubsystem 接口
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject 接口
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableInEditor() const override;
+	virtual TStatId GetStatId() const override;
+
+	/** 相机组件 BeginPlay 时调用 */
+	void RegisterCamera(UAsymmetricCameraComponent* Camera);
+	void UnregisterCamera(UAsymmetricCameraComponent* Camera);
+
+	/** 屏幕组件 BeginPlay 时调用 */
+	void RegisterScreen(UAsymmetricScreenComponent* Screen);
+	void UnregisterScreen(UAsymmetricScreenComponent* Screen);
+
+	/** 固定运行时使用的相机；传 nullptr 恢复自动选择 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	void SetActiveCamera(UAsymmetricCameraComponent* Camera);
+
+	/** SetActiveCamera 固定的相机，没有固定时返回 nullptr */
+	UAsymmetricCameraComponent* GetPinnedCamera() const { return PinnedCamera.Get(); }
+
+	/** 当前驱动玩家视图的相机（上一次 Tick 选出的），没有时返回 nullptr */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	UAsymmetricCameraComponent* GetActiveCamera() const { return ActiveCamera.Get(); }
+
+	/** 已登记的相机，按登记顺序 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	TArray<UAsymmetricCameraComponent*> GetCameras() const;
+
+	/**
+	 * 按标签找相机：组件的 ComponentTags 或所属 Actor 的 Tags 含有 Tag 即匹配，多个匹配时取最先登记的。
+	 * 只遍历已登记的相机，和场景里的 Actor 数量无关。
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	UAsymmetricCameraComponent* FindCameraByTag(FName Tag) const;
+
+	/** 已登记的屏幕，按登记顺序 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera")
+	TArray<UAsymmetricScreenComponent*> GetScreens() const;
+
+	/** 发布输入有变化的相机的投影状态（Tick 里自动调用） */
+	void PublishAll();
+
+	/**
+	 * MRQ 高分辨率分块：设置使用 ViewState 的 View 接下来对应的画面区域（归一化，左上角为原点，含重叠边）
+	 * 和空间采样抖动（Tile 裁剪空间），视图扩展在这个 View 的 SetupView 里据此切出子视锥。
+	 */
+	void SetOfflineRenderTile(const FSceneViewStateInterface* ViewState, const FBox2D& NormalizedRect, const FVector2D& ClipJitter);
+	void ClearOfflineRenderTiles();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** 按优先级选出活动相机 */
+	UAsymmetricCameraComponent* ResolveActiveCamera() const;
+
+	struct FCameraEntry
+	{
+		TWeakObjectPtr<UAsymmetricCameraComponent> Camera;
+		int32 RegistrySlot = INDEX_NONE;
+	};
+
+	/** 按登记顺序；PublishAll 顺序遍历 */
+	TArray<FCameraEntry> Cameras;
+	TArray<TWeakObjectPtr<UAsymmetricScreenComponent>> Screens;
+
+	TWeakObjectPtr<UAsymmetricCameraComponent> PinnedCamera;
+	TWeakObjectPtr<UAsymmetricCameraComponent> ActiveCamera;
+
+	/** 视图扩展读的表，和扩展共享 */
+	TSharedPtr<FAsymmetricCameraRegistry, ESPMode::ThreadSafe> Registry;
+
+	/** 第一个相机登记时创建，子系统销毁时释放 */
+	TSharedPtr<FAsymmetricViewExtension, ESPMode::ThreadSafe> ViewExtension;
+};
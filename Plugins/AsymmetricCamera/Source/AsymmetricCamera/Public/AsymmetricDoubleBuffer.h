@@ -0,0 +1,91 @@
+// 单写者双缓冲：游戏线程每帧发布一份快照，任意线程无锁读取
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * 双缓冲快照槽位。写者只有一个（游戏线程），写到后台槽位后原子切换前台索引；
+ * 读者拷贝前台槽位，不加锁、不阻塞写者。
+ *
+ * 每个槽位带 seqlock 序号：写入期间为奇数，写完加到下一个偶数。
+ * 读者拷贝前后比较序号，读到一半被覆盖（写者连续发布两次追上了读者）就重试，
+ * 所以读者永远拿到的是某一次完整发布的数据。元素应是不含堆内存的 POD。
+ */
+template <typename ValueType>
+class TAsymmetricDoubleBuffer
+{
+	static_assert(std::is_trivially_destructible_v<ValueType>, "Snapshots are copied racily and must be plain data");
+
+public:
+	TAsymmetricDoubleBuffer() = default;
+	TAsymmetricDoubleBuffer(const TAsymmetricDoubleBuffer&) = delete;
+	TAsymmetricDoubleBuffer& operator=(const TAsymmetricDoubleBuffer&) = delete;
+
+	/** 写者发布新快照，返回本次发布的代数（从 1 开始递增） */
+	uint64 Publish(const ValueType& Value)
+	{
+		const uint32 Back = FrontIndex.load(std::memory_order_relaxed) ^ 1u;
+		FSlot& Slot = Slots[Back];
+
+		const uint32 Sequence = Slot.Sequence.load(std::memory_order_relaxed);
+		Slot.Sequence.store(Sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		Slot.Value = Value;
+		Slot.Generation = Generation.load(std::memory_order_relaxed) + 1;
+
+		Slot.Sequence.store(Sequence + 2, std::memory_order_release);
+		FrontIndex.store(Back, std::memory_order_release);
+		Generation.store(Slot.Generation, std::memory_order_release);
+		return Slot.Generation;
+	}
+
+	/**
+	 * 读取最新快照。
+	 * @param OutGeneration - 可选，返回快照的代数，用来判断是不是新数据
+	 * @return 还没发布过时返回 false
+	 */
+	bool Read(ValueType& OutValue, uint64* OutGeneration = nullptr) const
+	{
+		for (;;)
+		{
+			const FSlot& Slot = Slots[FrontIndex.load(std::memory_order_acquire)];
+			const uint32 SequenceBefore = Slot.Sequence.load(std::memory_order_acquire);
+			if (SequenceBefore & 1u)
+			{
+				continue; // 写者正在写这个槽位（前台已经切走又被写回来）
+			}
+
+			OutValue = Slot.Value;
+			const uint64 SlotGeneration = Slot.Generation;
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (Slot.Sequence.load(std::memory_order_relaxed) == SequenceBefore)
+			{
+				if (OutGeneration)
+				{
+					*OutGeneration = SlotGeneration;
+				}
+				return SlotGeneration != 0;
+			}
+		}
+	}
+
+	/** 最新发布的代数，0 表示还没发布过 */
+	uint64 GetGeneration() const { return Generation.load(std::memory_order_acquire); }
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint32> Sequence{ 0 };
+		uint64     Generation = 0;
+		ValueType  Value{};
+	};
+
+	alignas(PLATFORM_CACHE_LINE_SIZE) FSlot Slots[2];
+	std::atomic<uint32> FrontIndex{ 0 };
+	std::atomic<uint64> Generation{ 0 };
+};
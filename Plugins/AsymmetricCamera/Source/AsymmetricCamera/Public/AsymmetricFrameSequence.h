@@ -0,0 +1,109 @@
+// 紧凑的帧序列表示：目录 + 文件名模式 + 帧号区间，不逐帧保存路径
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Paths.h"
+
+/** 闭区间 [First, Last] */
+struct FAsymmetricFrameRange
+{
+	int32 First = 0;
+	int32 Last = -1;
+
+	int32 Num() const { return Last - First + 1; }
+};
+
+/**
+ * 升序、互不重叠且互不相邻的帧号区间列表。连续帧只占一个区间，区间之间的空隙就是缺帧。
+ * 10 万帧无缺帧的序列只有一个区间，按序号取帧 / 遍历都不需要展开。
+ */
+struct ASYMMETRICCAMERA_API FAsymmetricFrameRanges
+{
+	TArray<FAsymmetricFrameRange> Ranges;
+
+	/** 加入一帧；按升序加入时是 O(1)，乱序时二分插入并合并相邻区间 */
+	void Add(int32 Frame);
+
+	bool Contains(int32 Frame) const;
+	int32 Num() const { return NumFrames; }
+	bool IsEmpty() const { return NumFrames == 0; }
+	int32 GetFirstFrame() const { return Ranges.Num() > 0 ? Ranges[0].First : 0; }
+	int32 GetLastFrame() const { return Ranges.Num() > 0 ? Ranges.Last().Last : -1; }
+
+	/** 缺帧数（首尾之间不在序列里的帧） */
+	int32 GetNumMissing() const { return Ranges.Num() > 0 ? (GetLastFrame() - GetFirstFrame() + 1 - NumFrames) : 0; }
+
+	/** 两个序列都有的帧 */
+	static FAsymmetricFrameRanges Intersect(const FAsymmetricFrameRanges& A, const FAsymmetricFrameRanges& B);
+
+	/**
+	 * 按升序遍历第 StartIndex 帧起的 Count 帧（序号从 0 开始，跨区间连续计数）。
+	 * @param Func - void(int32 Index, int32 Frame)
+	 */
+	template <typename FuncType>
+	void ForEachFrame(int32 StartIndex, int32 Count, FuncType&& Func) const
+	{
+		int32 Index = 0;
+		const int32 EndIndex = FMath::Min(StartIndex + Count, NumFrames);
+		for (const FAsymmetricFrameRange& Range : Ranges)
+		{
+			if (Index >= EndIndex)
+			{
+				break;
+			}
+			const int32 RangeNum = Range.Num();
+			if (Index + RangeNum > StartIndex)
+			{
+				const int32 Begin = FMath::Max(StartIndex - Index, 0);
+				const int32 End = FMath::Min(EndIndex - Index, RangeNum);
+				for (int32 Offset = Begin; Offset < End; ++Offset)
+				{
+					Func(Index + Offset, Range.First + Offset);
+				}
+			}
+			Index += RangeNum;
+		}
+	}
+
+	template <typename FuncType>
+	void ForEachFrame(FuncType&& Func) const
+	{
+		ForEachFrame(0, NumFrames, Forward<FuncType>(Func));
+	}
+
+private:
+	int32 NumFrames = 0;
+};
+
+/**
+ * 一只眼（或一个 Pass）输出的图片序列：<Directory>/<Prefix><帧号><Suffix>。
+ * 帧号为文件名中最后一段数字，按 PadWidth 补零（PadWidth 取最小帧号的位数，
+ * 未补零的序列最小帧号的自然位数也能正确格式化更大的帧号）。
+ */
+struct ASYMMETRICCAMERA_API FAsymmetricFrameSequence
+{
+	FString Directory;
+	FString Prefix;
+	FString Suffix;            // 帧号之后的部分，含扩展名
+	int32   PadWidth = 0;
+	FAsymmetricFrameRanges Frames;
+
+	/**
+	 * 解析一个输出文件并加入序列。第一个文件确定模式；之后模式不一致的文件返回 false，不加入。
+	 * 文件名中没有数字（例如视频文件）时也返回 false。
+	 */
+	bool AddFile(const FString& InFilePath);
+
+	/** 帧对应的绝对路径（按需生成） */
+	FString GetFramePath(int32 Frame) const;
+
+	/** 扩展名，含点 */
+	FString GetExtension() const { return FPaths::GetExtension(Suffix, /*bIncludeDot=*/true); }
+
+	int32 Num() const { return Frames.Num(); }
+	bool IsEmpty() const { return Frames.IsEmpty(); }
+
+private:
+	int32 MinFrameSeen = MAX_int32;
+};
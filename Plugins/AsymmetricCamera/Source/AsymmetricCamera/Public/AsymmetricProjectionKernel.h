@@ -0,0 +1,116 @@
+// 离轴投影计算内核：纯 C++，不依赖 UObject，可在任意线程调用
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 屏幕正交基，由屏幕三个角点（左下、右下、左上）推导。
+ * 只和屏幕本身有关，与眼睛位置无关，屏幕不动时可以缓存复用。
+ */
+struct FAsymmetricScreenBasis
+{
+	FVector Origin = FVector::ZeroVector; // 屏幕左下角 PA
+	FVector Right  = FVector::ZeroVector; // VR，屏幕右方向
+	FVector Up     = FVector::ZeroVector; // VU，屏幕上方向
+	FVector Normal = FVector::ZeroVector; // VN，屏幕法线（指向眼睛一侧，nDisplay 约定）
+	double  Width  = 0.0;                 // |PB - PA|
+	double  Height = 0.0;                 // |PC - PA|
+
+	/** 屏幕退化（角点重合）时无效 */
+	bool IsValid() const { return Width > SMALL_NUMBER && Height > SMALL_NUMBER; }
+};
+
+/**
+ * 离轴视锥在近裁切面上的范围（Kooima 论文里的 l/r/b/t）。
+ */
+struct FAsymmetricFrustumExtents
+{
+	float Left   = -1.0f;
+	float Right  =  1.0f;
+	float Bottom = -1.0f;
+	float Top    =  1.0f;
+	float Near   = 20.0f;
+	float Far    = 0.0f;  // 0 = 无限远
+};
+
+/**
+ * 批量离轴投影输入/输出（SoA 布局）。
+ * 输入按分量分开存放，方便内层循环一次处理 4 块屏幕；
+ * 输出按矩阵紧凑存放，可以直接拷进渲染数据。
+ *
+ * 坐标用 float，调用方应先把角点和眼睛减去一个局部原点（比如眼睛或 Actor 原点）再写入，
+ * 避免大世界坐标下的精度损失。
+ */
+struct ASYMMETRICCAMERA_API FAsymmetricProjectionBatch
+{
+	/** 重置为 Num 块屏幕，内部按 4 对齐补零 */
+	void Reset(int32 InNum);
+
+	/** 写入第 Index 块屏幕的三个角点和眼睛位置（局部坐标） */
+	void SetScreen(int32 Index, const FVector3f& BL, const FVector3f& BR, const FVector3f& TL, const FVector3f& Eye);
+
+	int32 Num() const { return NumScreens; }
+
+	float NearClip = 20.0f;
+	float FarClip  = 0.0f;
+
+	// 输入：左下 PA、右下 PB、左上 PC、眼睛 PE
+	TArray<float> PAX, PAY, PAZ;
+	TArray<float> PBX, PBY, PBZ;
+	TArray<float> PCX, PCY, PCZ;
+	TArray<float> PEX, PEY, PEZ;
+
+	// 输出：UE5 reversed-Z 投影矩阵 + 视图旋转矩阵（已含 Swizzle，可直接作为 ViewRotationMatrix）
+	TArray<FMatrix44f> ProjectionMatrices;
+	TArray<FMatrix44f> ViewRotationMatrices;
+
+private:
+	int32 NumScreens = 0;
+};
+
+/**
+ * Kooima 广义透视投影的纯数学实现，和 nDisplay 的 MakeProjectionMatrix 对齐。
+ * 组件、视图扩展和 MRQ Pass 都通过这里计算投影，不直接访问 UObject。
+ */
+struct ASYMMETRICCAMERA_API FAsymmetricProjectionKernel
+{
+	/** 眼睛离屏幕平面太近时使用的最小距离，防止投影矩阵爆掉 */
+	static constexpr float MinScreenDistance = 10.0f;
+
+	/** 从屏幕三个角点推导正交基 */
+	static FAsymmetricScreenBasis MakeScreenBasis(const FVector& BL, const FVector& BR, const FVector& TL);
+
+	/** 计算眼睛相对屏幕的视锥范围 */
+	static FAsymmetricFrustumExtents ComputeFrustumExtents(const FAsymmetricScreenBasis& Basis, const FVector& EyePosition, float NearClip, float FarClip);
+
+	/**
+	 * 取画面里的一块子区域的视锥范围（高分辨率分块渲染用）。
+	 * NormalizedRect 以整幅画面左上角为原点、右下角为 (1, 1)，可以超出 0~1 以包含 Tile 的重叠边。
+	 * 子视锥和整幅视锥在同一个近裁切面上线性切分，拼起来和不分块渲染逐像素一致。
+	 */
+	static FAsymmetricFrustumExtents MakeSubFrustumExtents(const FAsymmetricFrustumExtents& Extents, const FBox2D& NormalizedRect);
+
+	/** 由视锥范围构建 UE5 reversed-Z 投影矩阵（标准左手系偏心投影 × FlipZ 的展开形式） */
+	static FMatrix MakeProjectionMatrix(const FAsymmetricFrustumExtents& Extents);
+
+	/** 由屏幕正交基构建 ViewRotationMatrix，等价于 FInverseRotationMatrix(ViewRotation) * SwizzleMatrix */
+	static FMatrix MakeViewRotationMatrix(const FAsymmetricScreenBasis& Basis);
+
+	/**
+	 * 屏幕朝向（X=朝屏幕里，Y=右，Z=上），保留屏幕的滚转，和 MakeViewRotationMatrix 一致。
+	 * 重构前外部四角模式用 法线.Rotation()，丢掉了滚转，而投影范围是沿屏幕自身的右 / 上方向量的，
+	 * 滚转过的屏幕画面会和屏幕对不上；组件模式用屏幕组件的旋转，本来就带滚转。
+	 */
+	static FRotator MakeViewRotation(const FAsymmetricScreenBasis& Basis);
+
+	/**
+	 * 单屏便捷接口：一次算出视图旋转和投影矩阵。
+	 * @return 屏幕退化时返回 false
+	 */
+	static bool Calculate(const FAsymmetricScreenBasis& Basis, const FVector& EyePosition, float NearClip, float FarClip,
+		FRotator& OutViewRotation, FMatrix& OutProjectionMatrix);
+
+	/** 批量计算：向量化内层循环，每次处理 4 块屏幕 */
+	static void EvaluateBatch(FAsymmetricProjectionBatch& Batch);
+};
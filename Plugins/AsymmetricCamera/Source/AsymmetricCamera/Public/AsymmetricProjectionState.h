@@ -0,0 +1,48 @@
+// 投影状态快照：组件每帧发布一次，视图扩展 / 渲染线程只读这份数据
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AsymmetricProjectionKernel.h"
+
+class UAsymmetricTrackingSubsystem;
+
+/**
+ * 计算一帧投影所需的全部输入，纯数据，可以在任意线程拷贝。
+ * 由 UAsymmetricCameraComponent 在 Tick 末尾（TG_PostUpdateWork）解析好 ScreenComponent、
+ * TrackedActor、外部角点 Actor 等引用后发布，视图扩展的回调里不再访问任何 UObject。
+ */
+struct FAsymmetricProjectionState
+{
+	uint64 FrameNumber = 0;                   // 发布时的 GFrameCounter
+
+	// 开关
+	bool bEnabled = false;                    // bUseAsymmetricProjection 且屏幕正交基有效
+	bool bMultiScreenActive = false;          // 多屏设备已接管渲染，单屏路径跳过
+	bool bEnableMRQSupport = false;
+	bool bMatchViewportAspectRatio = false;
+
+	// 屏幕
+	FAsymmetricScreenBasis Basis;
+	FVector2D ScreenSize = FVector2D::ZeroVector; // 屏幕组件尺寸，用于视口比例约束（没有屏幕组件时为 0，不约束）
+
+	// 投影参数
+	float NearClip = 20.0f;
+	float FarClip = 0.0f;
+	float EyeSeparation = 0.0f;
+	float EyeOffset = 0.0f;
+
+	// 眼睛
+	FVector EyePosition = FVector::ZeroVector;   // 发布时解析出的眼睛世界坐标（已按优先级选好数据源）
+
+	// 追踪：视图扩展 / 渲染线程可以据此直接重读最新采样，不用等下一次发布
+	bool  bUseTracking = false;               // 眼睛来自追踪子系统（未被外部数据覆盖）
+	bool  bLateLatch = false;
+	int32 TrackingSensorId = 0;
+	float TrackingTimeout = 0.25f;
+	FTransform TrackingToWorld = FTransform::Identity;
+	const UAsymmetricTrackingSubsystem* Tracking = nullptr; // 引擎级子系统，生命周期覆盖所有渲染
+
+	/** 立体渲染时投影用眼睛相对追踪眼睛的偏移（沿屏幕右方向） */
+	FVector GetStereoShift() const { return Basis.Right * (EyeOffset * EyeSeparation * 0.5f); }
+};
@@ -51,4 +51,9 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Screen")
 	void GetScreenCornersLocal(FVector& OutBottomLeft, FVector& OutBottomRight, FVector& OutTopLeft, FVector& OutTopRight) const;
+
+protected:
+	/** 登记到 UAsymmetricCameraSubsystem */
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
@@ -0,0 +1,108 @@
+// 单生产者无锁环形缓冲：追踪数据从接收线程交给游戏线程 / 渲染线程
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * 固定容量的 SPSC 环形缓冲，不加锁、不分配内存。
+ *
+ * - Push 只能由一个生产者线程调用。缓冲满了直接覆盖最旧的数据：
+ *   追踪数据只关心最新值，生产者永远不能被消费者卡住。
+ * - Pop 只能由一个消费者线程调用，按顺序取出；落后太多时跳过被覆盖的部分并计入 Dropped。
+ * - PeekLatest 只读最新一项，不移动读指针，任意线程都可以同时调用。
+ *
+ * 读取用 seqlock 的思路：先拷贝数据，再重新读一次写指针，
+ * 确认拷贝期间这个槽位没被生产者转一圈覆盖掉，否则重试。
+ * 因此元素必须是可平凡拷贝的 POD。
+ */
+template <typename ElementType, uint32 Capacity>
+class TAsymmetricSpscRing
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+	static_assert(std::is_trivially_copyable_v<ElementType>, "Ring elements are copied racily and must be trivially copyable");
+
+public:
+	TAsymmetricSpscRing() = default;
+	TAsymmetricSpscRing(const TAsymmetricSpscRing&) = delete;
+	TAsymmetricSpscRing& operator=(const TAsymmetricSpscRing&) = delete;
+
+	/** 生产者写入一项 */
+	void Push(const ElementType& Item)
+	{
+		const uint64 Write = WriteIndex.load(std::memory_order_relaxed);
+		Slots[Write & Mask] = Item;
+		WriteIndex.store(Write + 1, std::memory_order_release);
+	}
+
+	/** 消费者按顺序取出一项；没有新数据返回 false */
+	bool Pop(ElementType& OutItem)
+	{
+		uint64 Read = ReadIndex.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const uint64 Write = WriteIndex.load(std::memory_order_acquire);
+			if (Read == Write)
+			{
+				return false;
+			}
+
+			// 生产者可能正在写 Write 对应的槽位（= Write - Capacity），所以只保留 Capacity - 1 项
+			if (Write - Read > Capacity - 1)
+			{
+				const uint64 Skipped = Write - (Capacity - 1) - Read;
+				Dropped.fetch_add(Skipped, std::memory_order_relaxed);
+				Read += Skipped;
+			}
+
+			OutItem = Slots[Read & Mask];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (WriteIndex.load(std::memory_order_relaxed) - Read <= Capacity - 1)
+			{
+				ReadIndex.store(Read + 1, std::memory_order_release);
+				return true;
+			}
+			// 拷贝期间被覆盖，重新定位
+		}
+	}
+
+	/** 读取最新一项（不消费）；缓冲为空返回 false */
+	bool PeekLatest(ElementType& OutItem) const
+	{
+		for (;;)
+		{
+			const uint64 Write = WriteIndex.load(std::memory_order_acquire);
+			if (Write == 0)
+			{
+				return false;
+			}
+
+			const uint64 Latest = Write - 1;
+			OutItem = Slots[Latest & Mask];
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (WriteIndex.load(std::memory_order_relaxed) - Latest <= Capacity - 1)
+			{
+				return true;
+			}
+		}
+	}
+
+	/** 累计写入次数 */
+	uint64 GetTotalPushed() const { return WriteIndex.load(std::memory_order_relaxed); }
+
+	/** 消费者因为落后而跳过的项数 */
+	uint64 GetDropped() const { return Dropped.load(std::memory_order_relaxed); }
+
+	static constexpr uint32 GetCapacity() { return Capacity; }
+
+private:
+	static constexpr uint64 Mask = Capacity - 1;
+
+	// 生产者和消费者各写各的索引，分开放在不同的缓存行里避免伪共享
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> WriteIndex{ 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> ReadIndex{ 0 };
+	std::atomic<uint64> Dropped{ 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) ElementType Slots[Capacity];
+};
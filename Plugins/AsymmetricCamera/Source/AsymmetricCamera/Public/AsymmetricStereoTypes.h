@@ -1,4 +1,4 @@
-// 立体渲染相关枚举类型定义
+// 立体渲染 / 多屏排布相关类型定义
 
 #pragma once
 
@@ -52,3 +52,106 @@ enum class EFFmpegOutputFormat : uint8
 	MKV         UMETA(DisplayName = "MKV"),  // 开放容器，H.265 默认使用此格式
 	AVI         UMETA(DisplayName = "AVI")   // 旧式格式，兼容性较差
 };
+
+/**
+ * 立体图片输出节点写出的图片格式
+ */
+UENUM(BlueprintType)
+enum class EAsymmetricStereoImageFormat : uint8
+{
+	PNG         UMETA(DisplayName = "PNG (8-bit)"),        // 无损，8 位 sRGB
+	JPEG        UMETA(DisplayName = "JPEG (8-bit)"),       // 有损，文件最小
+	EXR         UMETA(DisplayName = "EXR (Float)")         // 线性 HDR，保留渲染输出的浮点精度
+};
+
+/**
+ * 多视图 EXR 的压缩方式（对应 OpenEXR 的 Compression）
+ */
+UENUM(BlueprintType)
+enum class EAsymmetricExrCompression : uint8
+{
+	None        UMETA(DisplayName = "None"),   // 不压缩，写入最快、文件最大
+	RLE         UMETA(DisplayName = "RLE"),    // 游程编码，无损，压缩率低
+	ZIPS        UMETA(DisplayName = "ZIPS"),   // 逐行 zlib，无损
+	ZIP         UMETA(DisplayName = "ZIP"),    // 16 行一块 zlib，无损（默认）
+	PIZ         UMETA(DisplayName = "PIZ"),    // 小波，无损，适合有噪点的画面
+	DWAA        UMETA(DisplayName = "DWAA")    // 有损，文件最小，适合预览交付
+};
+
+/**
+ * 多屏模式下各屏幕 View 在后台缓冲区里的排布方式
+ */
+UENUM(BlueprintType)
+enum class EAsymmetricMultiScreenLayout : uint8
+{
+	Grid        UMETA(DisplayName = "Grid"),          // 按行列网格平均切分视口
+	Custom      UMETA(DisplayName = "Custom Rects")   // 每块屏幕单独指定输出矩形
+};
+
+/**
+ * 跟随目标相机（bFollowTargetCamera）的方式
+ */
+UENUM(BlueprintType)
+enum class EAsymmetricFollowMode : uint8
+{
+	MoveOwner      UMETA(DisplayName = "Move Owner Actor"),  // 每帧把 Owner Actor 移到目标相机，整个 Rig 的组件都会更新 Transform
+	VirtualParent  UMETA(DisplayName = "Virtual Parent")     // 不移动 Actor，计算投影时把目标相机当作 Owner 的父节点
+};
+
+/**
+ * 归一化视口矩形（0~1，左上角为原点），用于多屏模式的自定义排布
+ */
+USTRUCT(BlueprintType)
+struct FAsymmetricViewportRect
+{
+	GENERATED_BODY()
+
+	/** 左上角（归一化） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	FVector2D Min = FVector2D(0.0, 0.0);
+
+	/** 右下角（归一化） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asymmetric Camera", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	FVector2D Max = FVector2D(1.0, 1.0);
+};
+
+/**
+ * 立体合成的一个交付版本（例如全分辨率 SBS 母版、半分辨率审片小样、TB 版本）。
+ * 同一个 Shot 的所有版本在一次解码中生成：FFmpeg 用 split 滤镜图一个进程多路输出，进程内合成逐帧解码一次后分别打包写出。
+ */
+USTRUCT(BlueprintType)
+struct FAsymmetricCompositeOutputTarget
+{
+	GENERATED_BODY()
+
+	/** 关闭时跳过这个版本 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target")
+	bool bEnabled = true;
+
+	/** 文件名后缀：stereo_<布局>_<Shot>_<后缀>，为空时按序号命名 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target")
+	FString Suffix = TEXT("proxy");
+
+	/** 这个版本的立体布局（Mono 无效，会被跳过） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target")
+	EAsymmetricStereoLayout Layout = EAsymmetricStereoLayout::SideBySide;
+
+	/** 相对打包后全分辨率的缩放，0.5 为半分辨率 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target", meta = (ClampMin = "0.05", ClampMax = "1.0"))
+	float Scale = 0.5f;
+
+	/** 视频编码器（仅 Video 模式） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target")
+	EFFmpegVideoCodec VideoCodec = EFFmpegVideoCodec::H264;
+
+	/** 输出容器（仅 Video 模式，H.265 强制 MKV） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target")
+	EFFmpegOutputFormat OutputFormat = EFFmpegOutputFormat::MP4;
+
+	/** CRF 质量值（仅 Video 模式） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output Target", meta = (ClampMin = "0", ClampMax = "51"))
+	int32 Quality = 23;
+
+	/** 是否需要缩放 */
+	bool IsScaled() const { return Scale < 1.0f - UE_KINDA_SMALL_NUMBER; }
+};
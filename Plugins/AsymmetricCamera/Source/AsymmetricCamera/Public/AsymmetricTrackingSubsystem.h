@@ -0,0 +1,118 @@
+// 头部追踪数据接入子系统：UDP 接收线程 + 无锁环形缓冲
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "AsymmetricSpscRing.h"
+#include <atomic>
+#include "AsymmetricTrackingSubsystem.generated.h"
+
+class FAsymmetricTrackingReceiver;
+
+/**
+ * 一条追踪采样。位置 / 旋转是追踪系统自己的坐标（UE 轴向，厘米），
+ * 由使用方决定挂在哪个空间下（相机组件按 Owner Actor 局部空间解释）。
+ */
+struct FAsymmetricTrackingSample
+{
+	FVector3f Position = FVector3f::ZeroVector;
+	FQuat4f   Orientation = FQuat4f::Identity;
+	uint64    SenderTimestampUs = 0;  // 发送端时间戳（微秒，发送端自己的时钟）
+	double    ReceiveTime = 0.0;      // 接收时间（FPlatformTime::Seconds）
+	uint32    Sequence = 0;           // 发送端序号，用来统计丢包
+	uint16    SensorId = 0;
+};
+
+/** 接收统计（累计值），用于控制台输出和基准测试 */
+struct FAsymmetricTrackingStats
+{
+	uint64 PacketsReceived = 0;
+	uint64 PacketsRejected = 0;   // 长度 / 魔数 / 版本 / 传感器 ID 不对
+	uint64 BytesReceived = 0;
+	uint64 SequenceGaps = 0;      // 按序号推算的丢包数
+	uint64 LatencySamples = 0;
+	double AverageLatencyUs = 0.0;
+	double MaxLatencyUs = 0.0;
+};
+
+/**
+ * 追踪数据接入子系统（引擎级，PIE / 多个相机共用一个接收端口）。
+ *
+ * 接收线程直接从 UDP socket 解包写入每个传感器自己的 SPSC 环形缓冲，
+ * 游戏线程和渲染线程用 GetLatestSample 读最新值，中间不经过 Actor Transform，
+ * 也不需要等下一帧 Tick。
+ *
+ * 包格式见 AsymmetricTrackingProtocol.h（固定 48 字节小端二进制）。
+ */
+UCLASS()
+class ASYMMETRICCAMERA_API UAsymmetricTrackingSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** 同时支持的传感器数量（传感器 ID 0 ~ MaxSensors-1） */
+	static constexpr int32 MaxSensors = 16;
+
+	/** 每个传感器保留的采样数 */
+	static constexpr uint32 SamplesPerSensor = 64;
+
+	virtual void Deinitialize() override;
+
+	/**
+	 * 启动 UDP 接收线程。已经在同一端口运行时直接返回 true，端口不同则先停掉旧的。
+	 * @return socket 创建或线程启动失败返回 false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Tracking")
+	bool StartReceiver(int32 Port);
+
+	/** 停止接收线程（已收到的采样保留） */
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Tracking")
+	void StopReceiver();
+
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Tracking")
+	bool IsReceiving() const { return Receiver.IsValid(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Asymmetric Camera|Tracking")
+	int32 GetReceiverPort() const { return ReceiverPort; }
+
+	/** 读取某个传感器的最新采样，任意线程可调用 */
+	bool GetLatestSample(int32 SensorId, FAsymmetricTrackingSample& OutSample) const;
+
+	/** 按顺序取出某个传感器的采样（每个传感器只能有一个消费者，用于录制 / 滤波） */
+	bool PopSample(int32 SensorId, FAsymmetricTrackingSample& OutSample);
+
+	/** 当前累计统计 */
+	FAsymmetricTrackingStats GetStats() const;
+
+	/** 清零统计和丢包统计用的序号。接收线程在跑时只做标记，由接收线程在下一包或下一次等待超时时清零 */
+	void ResetStats();
+
+	/**
+	 * 解包并写入对应传感器的缓冲。只由接收线程调用（每个环形缓冲的唯一生产者）。
+	 * @return 包格式不对返回 false
+	 */
+	bool IngestPacket(const uint8* Data, int32 Size, double ReceiveTime);
+
+	/** 有 ResetStats 请求时清零统计。接收线程在跑时只由接收线程调用 */
+	void ApplyPendingStatsReset();
+
+private:
+	TSharedPtr<FAsymmetricTrackingReceiver, ESPMode::ThreadSafe> Receiver;
+	int32 ReceiverPort = 0;
+
+	TAsymmetricSpscRing<FAsymmetricTrackingSample, SamplesPerSensor> SensorRings[MaxSensors];
+
+	// 以下只由接收线程写，其他线程读
+	uint32 LastSequence[MaxSensors] = {};
+	std::atomic<uint64> PacketsReceived{ 0 };
+	std::atomic<uint64> PacketsRejected{ 0 };
+	std::atomic<uint64> BytesReceived{ 0 };
+	std::atomic<uint64> SequenceGaps{ 0 };
+	std::atomic<uint64> LatencySamples{ 0 };
+	std::atomic<uint64> LatencySumUs{ 0 };
+	std::atomic<uint64> LatencyMaxUs{ 0 };
+
+	// 游戏线程请求清零，接收线程执行
+	std::atomic<bool> bStatsResetPending{ false };
+};
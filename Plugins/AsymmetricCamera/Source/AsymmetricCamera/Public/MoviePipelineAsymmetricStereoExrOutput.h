@@ -0,0 +1,70 @@
+// MRQ 多视图 EXR 输出 — 左右眼作为同一个 EXR 文件里的 left / right 两个视图写出
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MoviePipelineAsymmetricStereoOutputBase.h"
+#include "AsymmetricStereoTypes.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "MoviePipelineAsymmetricStereoExrOutput.generated.h"
+
+class FEvent;
+
+/**
+ * 每帧写一个多视图 EXR（OpenEXR multiView 属性，单 Part）：left 为默认视图，通道名 R/G/B/A；
+ * right 视图通道名为 right.R / right.G / right.B / right.A。Nuke 等合成软件可以直接按视图读取。
+ *
+ * 两眼数据保持渲染输出的精度（半精度或全精度浮点），不做打包、不量化。
+ * 编码和写盘在线程池上执行，多帧同时压缩；等待写盘的帧数达到 MaxPendingWrites 时渲染会等待。
+ *
+ * 文件名为 stereo_<Shot>.<帧号>.exr，后处理材质、Stencil 层等附加 Pass 各写一个 stereo_<Shot>_<Pass>.<帧号>.exr。
+ * 配置中存在本节点时，立体 Pass 不再做渲染后的合成。
+ * 只在引擎自带 OpenEXR 的桌面平台可用（Windows / Mac / Linux）。
+ */
+UCLASS(BlueprintType)
+class ASYMMETRICCAMERA_API UMoviePipelineAsymmetricStereoExrOutput : public UMoviePipelineAsymmetricStereoOutputBase
+{
+	GENERATED_BODY()
+
+public:
+	UMoviePipelineAsymmetricStereoExrOutput();
+
+	/** EXR 压缩方式 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo EXR",
+		meta = (ToolTip = "EXR 压缩方式。ZIP 为无损通用选择；PIZ 适合噪点多的画面；DWAA 有损但文件最小。"))
+	EAsymmetricExrCompression Compression;
+
+	/** 同时在后台编码写盘的帧数上限 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo EXR",
+		meta = (ClampMin = "1", ClampMax = "64",
+			ToolTip = "同时在后台压缩、写盘的帧数上限，每帧保留一份左右眼拷贝。写盘跟不上渲染时渲染会在这里等待。"))
+	int32 MaxPendingWrites;
+
+protected:
+	// UMoviePipelineOutputBase 接口
+	virtual void SetupForPipelineImpl(UMoviePipeline* InPipeline) override;
+	virtual void OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame) override;
+	virtual bool HasFinishedProcessingImpl() override;
+
+#if WITH_EDITOR
+	virtual FText GetDisplayText() const override;
+#endif
+
+private:
+	/** 把一个 Pass 本帧的两眼交给后台编码写盘，积压到上限时先等待 */
+	void WritePassExr(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass);
+
+	/** 后台写盘的积压计数和完成通知，和后台任务共享（任务可能比节点活得久） */
+	struct FPendingWrites
+	{
+		FPendingWrites();
+		~FPendingWrites();
+
+		/** 还没写完的帧数，后台任务结束时递减 */
+		FThreadSafeCounter Count;
+
+		/** 每写完一帧触发一次，积压到上限时游戏线程在上面等待 */
+		FEvent* WriteFinished = nullptr;
+	};
+	TSharedPtr<FPendingWrites, ESPMode::ThreadSafe> PendingWrites;
+};
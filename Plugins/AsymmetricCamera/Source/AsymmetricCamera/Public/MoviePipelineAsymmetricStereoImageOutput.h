@@ -0,0 +1,59 @@
+// MRQ 立体图片输出 — 左右眼在内存中打包为一张 SBS/TB 图片后写盘，不写分离的眼图
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MoviePipelineAsymmetricStereoOutputBase.h"
+#include "AsymmetricStereoTypes.h"
+#include "MoviePipelineAsymmetricStereoImageOutput.generated.h"
+
+class IImageWriteQueue;
+
+/**
+ * 每帧从合并输出中取出 LeftEye / RightEye，按立体 Pass 的 StereoLayout 打包成一张图，
+ * 交给引擎的 ImageWriteQueue 异步编码写盘。每帧只产生一个文件、一次编码，渲染结束后也不需要再合成。
+ *
+ * 文件名为 stereo_<布局>_<Shot>.<帧号>.<扩展名>，帧号按 MRQ 的 {frame_number} 规则解析（含补零位数）。
+ * 后处理材质、Stencil 层等附加 Pass 各自打包，文件名追加 _<Pass 名>。
+ *
+ * 使用方法：在 MRQ Job 中添加本节点，并移除 PNG / EXR 等逐眼输出节点。
+ */
+UCLASS(BlueprintType)
+class ASYMMETRICCAMERA_API UMoviePipelineAsymmetricStereoImageOutput : public UMoviePipelineAsymmetricStereoOutputBase
+{
+	GENERATED_BODY()
+
+public:
+	UMoviePipelineAsymmetricStereoImageOutput();
+
+	/** 输出图片格式 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo Image",
+		meta = (ToolTip = "打包后图片的格式。PNG / JPEG 会量化到 8 位 sRGB；EXR 保留渲染输出的浮点数据。"))
+	EAsymmetricStereoImageFormat ImageFormat;
+
+	/** JPEG 质量（1-100） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo Image",
+		meta = (ClampMin = "1", ClampMax = "100", EditCondition = "ImageFormat == EAsymmetricStereoImageFormat::JPEG",
+			ToolTip = "JPEG 压缩质量，1-100，越大质量越高。"))
+	int32 JpegQuality;
+
+protected:
+	// UMoviePipelineOutputBase 接口
+	virtual void SetupForPipelineImpl(UMoviePipeline* InPipeline) override;
+	virtual void OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame) override;
+	virtual void BeginFinalizeImpl() override;
+	virtual bool HasFinishedProcessingImpl() override;
+
+#if WITH_EDITOR
+	virtual FText GetDisplayText() const override;
+#endif
+
+private:
+	/** 打包一个 Pass 本帧的两眼并加入写盘队列 */
+	void WritePassImage(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass);
+
+	IImageWriteQueue* ImageWriteQueue = nullptr;
+
+	/** BeginFinalize 时插入的栅栏，之前入队的写盘任务全部完成后触发 */
+	TFuture<void> FinalizeFence;
+};
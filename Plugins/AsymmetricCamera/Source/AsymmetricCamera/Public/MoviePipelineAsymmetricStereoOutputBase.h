@@ -0,0 +1,65 @@
+// MRQ 立体输出节点基类 — 直接从内存中的左右眼帧生成立体输出，不经过分离的眼图文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MoviePipelineOutputBase.h"
+#include "MoviePipelineAsymmetricStereoOutputBase.generated.h"
+
+class UMoviePipelineAsymmetricStereoPass;
+struct FImagePixelData;
+struct FMoviePipelineFrameOutputState;
+struct FMoviePipelineMergerOutputFrame;
+
+/**
+ * 立体输出节点的公共部分：找到同一配置里的 UMoviePipelineAsymmetricStereoPass，
+ * 从合并后的输出帧中按渲染 Pass 取出 LeftEye / RightEye 两张图，解析 Shot 的输出目录和名称。
+ * 开启后处理材质、Stencil 层等附加 Pass 时，每个 Pass 各自成对输出，不会混用不同 Pass 的眼图。
+ *
+ * 配置中存在任何一个立体输出节点时，立体 Pass 不再在渲染结束后用 FFmpeg 合成眼图文件。
+ * 此时可以从配置里移除 PNG / EXR 等逐眼输出节点，彻底不写中间文件。
+ */
+UCLASS(Abstract)
+class ASYMMETRICCAMERA_API UMoviePipelineAsymmetricStereoOutputBase : public UMoviePipelineOutputBase
+{
+	GENERATED_BODY()
+
+protected:
+	/** 一个渲染 Pass 在本帧的左右眼图像（指向合并帧里的数据，只在 OnReceiveImageDataImpl 内有效） */
+	struct FStereoEyeImages
+	{
+		FString PassName;
+		bool bMainPass = false;
+		const FImagePixelData* Left = nullptr;
+		const FImagePixelData* Right = nullptr;
+	};
+
+	// UMoviePipelineOutputBase 接口
+	virtual void SetupForPipelineImpl(UMoviePipeline* InPipeline) override;
+	virtual void TeardownForPipelineImpl(UMoviePipeline* InPipeline) override;
+
+	/** 同一配置中的立体 Pass，没有时为空（此时节点不输出任何内容） */
+	const UMoviePipelineAsymmetricStereoPass* GetStereoPass() const { return StereoPass.Get(); }
+
+	/**
+	 * 按渲染 Pass 分组取出本帧的左右眼图像，主画面排在最前；缺少任意一眼的 Pass 跳过。
+	 * Pass 为 Mono 或没有任何成对的 Pass 时返回 false。
+	 */
+	bool GetEyeImages(const FMoviePipelineMergerOutputFrame& InMergedOutputFrame,
+		TArray<FStereoEyeImages, TInlineAllocator<4>>& OutPasses) const;
+
+	/** 输出文件名里的 Pass 后缀：主画面为空，其他 Pass 为 "_<Pass 名>"，和立体 Pass 的合成输出命名一致 */
+	static FString GetPassSuffix(const FStereoEyeImages& InPass);
+
+	/** 解析输出设置中的目录模板（{sequence_name} 等） */
+	FString ResolveOutputDirectory(const FMoviePipelineFrameOutputState& InFrameOutputState) const;
+
+	/** Shot 名称，和立体 Pass 的合成输出命名一致（Section 名称，空格替换为下划线） */
+	FString GetShotName(int32 InShotIndex) const;
+
+	/** 逐帧输出文件的完整路径：<输出目录>/<InFileNamePrefix>.<帧号>.<InExtension>，帧号按 MRQ 的 {frame_number} 解析 */
+	FString ResolveFrameOutputPath(const FMoviePipelineFrameOutputState& InFrameOutputState, const FString& InFileNamePrefix, const TCHAR* InExtension) const;
+
+private:
+	TWeakObjectPtr<const UMoviePipelineAsymmetricStereoPass> StereoPass;
+};
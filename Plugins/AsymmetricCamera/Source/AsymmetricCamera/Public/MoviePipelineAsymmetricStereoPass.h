@@ -5,24 +5,102 @@
 #include "CoreMinimal.h"
 #include "MoviePipelineDeferredPasses.h"
 #include "AsymmetricStereoTypes.h"
+#include "AsymmetricFrameSequence.h"
 #include "Misc/FrameRate.h"
 #include "Misc/Paths.h"
+#include "UObject/ObjectKey.h"
+#include "HAL/ThreadSafeBool.h"
 #include "MoviePipelineAsymmetricStereoPass.generated.h"
 
+class AActor;
 class UAsymmetricCameraComponent;
+class FAsymmetricCompositeScheduler;
+class FAsymmetricCompositeManifest;
+class UMoviePipeline;
+class UMoviePipelineExecutorShot;
+struct FMoviePipelineOutputData;
+
+/** Video 模式长 Shot 分段并行编码的状态 */
+struct FShotSegmentState
+{
+	TArray<TArray<FString>> SegmentFiles; // [输出版本][分段]，每个版本的分段文件按播放顺序排列
+	int32           NumSegments = 0;
+	int32           NumRemaining = 0;
+	double          StartTime = 0.0; // 最早一个分段的启动时间（FPlatformTime::Seconds）
+
+	// 第一个失败分段的信息，所有分段结束后统一报告
+	bool            bFailed = false;
+	bool            bFailureLaunched = true;
+	int32           FailureReturnCode = 0;
+	FString         FailureLog;      // 失败分段的 FFmpeg 输出（最后若干行）
+};
+
+/**
+ * 一个 Shot 合成过程的计量，用来判断导出瓶颈在 CPU、磁盘还是卡住了。
+ * 时间均为 FPlatformTime::Seconds；字节数在 Shot 结束时按磁盘上的源文件 / 最终输出统计，不含分段中间文件。
+ */
+struct FShotCompositeTelemetry
+{
+	double QueuedTime = 0.0;        // 提交合成
+	double StartTime = 0.0;         // 第一个任务开始执行（排队等待到此为止）
+	double EndTime = 0.0;
+	int64  FramesEncoded = 0;       // FFmpeg 报告的已编码帧数（分段时为各段之和）；进程内合成为写出的帧数
+	int64  BytesRead = 0;           // 两眼源文件
+	int64  BytesWritten = 0;        // 合成输出
+	double CpuSeconds = 0.0;        // 所有 FFmpeg 进程的 CPU 时间之和；进程内合成不统计，为 0
+
+	/** 记录一个任务的开始时间，取最早的一个 */
+	void NoteStart(double InStartTime) { StartTime = (StartTime > 0.0) ? FMath::Min(StartTime, InStartTime) : InStartTime; }
+
+	double GetWallSeconds() const { return (EndTime > QueuedTime) ? EndTime - QueuedTime : 0.0; }
+	double GetQueueWaitSeconds() const { return (StartTime > QueuedTime) ? StartTime - QueuedTime : 0.0; }
+	double GetEncodeSeconds() const { return (StartTime > 0.0 && EndTime > StartTime) ? EndTime - StartTime : 0.0; }
+	double GetEncodeFps() const { const double Seconds = GetEncodeSeconds(); return Seconds > 0.0 ? FramesEncoded / Seconds : 0.0; }
+};
+
+/** 一个输出版本在磁盘上的文件数和字节数 */
+struct FShotOutputFiles
+{
+	int32 NumFiles = 0;
+	int64 Bytes = 0;
+};
 
 /**
- * 每个 Shot 的合成记录：从 MRQ 输出数据中提取的精确文件路径列表。
- * 在 BeginExportImpl 中从 GetOutputDataParams() 构建，不需要扫描目录或猜测文件名模式。
+ * 每个 Shot 每个渲染 Pass 的合成记录。两眼各保存为 目录 + 文件名模式 + 帧号区间，不逐帧保存路径；
+ * 合成需要的 concat 列表或逐帧路径在用到时才由紧凑形式生成。
+ * Shot 写盘完成时（或 BeginExportImpl 中）从 MRQ 输出数据一次遍历构建，不扫描目录。
  */
 struct FShotCompositeRecord
 {
-	TArray<FString> LeftEyePaths;   // 左眼帧文件绝对路径，按帧序排序
-	TArray<FString> RightEyePaths;  // 右眼帧文件绝对路径，按帧序排序
+	FAsymmetricFrameSequence LeftEye;   // 左眼序列
+	FAsymmetricFrameSequence RightEye;  // 右眼序列
+	FAsymmetricFrameRanges   Frames;    // 两眼都有的帧，合成按帧号升序配对
 	FString         OutputDir;      // 输出目录
 	FFrameRate      FrameRate;      // 序列帧率（精确分数形式）
-	FString         ShotName;       // Shot 名称（用于输出文件命名）
+	FString         ShotName;       // Shot 名称，非主画面 Pass 追加 _<Pass 名>（用于输出文件命名）
+	FString         PassName;       // 渲染 Pass 名称（FinalImage、后处理材质名、Stencil 层名等）
 	int32           StartFrameNumber = 0; // 起始帧号（用于 ImageSequence 输出对齐）
+	TArray<FString> TempFiles;      // 本 Shot 的 concat 列表 / 分段文件，合成结束后按调试开关清理
+	TArray<FAsymmetricCompositeOutputTarget> Targets; // 输出版本，第 0 个是 Pass 自身设置对应的主输出
+
+	// 合成结果（每个 Shot 单独记录，完成顺序和入队顺序无关）
+	bool            bCompositeFinished = false;
+	bool            bCompositeSucceeded = false;
+	int32           CompositeReturnCode = -1;
+	double          CompositeSeconds = 0.0;
+	bool            bUsedNativeCompositor = false; // 进程内合成（不经过 FFmpeg）
+	bool            bSkippedUnchanged = false;     // 输入、设置和输出与清单一致，本次没有重新合成
+
+	// 合成清单里的摘要，仅 bSkipUnchangedShots 开启时计算
+	uint64          InputHash = 0;      // 参与合成的两眼帧：帧号区间 + 每帧路径、大小和内容抽样
+	uint64          SettingsHash = 0;   // 影响输出内容的合成设置
+	TArray<FShotOutputFiles> OutputFiles; // 每个输出版本，Shot 结束时在后台线程统计
+
+	FShotSegmentState Segments;     // 仅分段编码时使用
+	FShotCompositeTelemetry Telemetry;
+
+	/** 参与合成的帧对数 */
+	int32 GetNumFramePairs() const { return Frames.Num(); }
 };
 
 /**
@@ -55,6 +133,20 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo", meta = (EditCondition = "StereoLayout != EAsymmetricStereoLayout::None", ToolTip = "交换左右眼输出。如果发现左右眼反了可以开启"))
 	bool bSwapEyes;
 
+	/**
+	 * 这个 Pass 使用的非对称相机所在的 Actor。
+	 * 一个关卡里有多台非对称相机时，在 Shot 的设置覆盖里给每个 Shot 指定各自的相机。
+	 * 留空时依次尝试 CameraTag、当前镜头的相机（玩家 ViewTarget 上的）、最先登记的相机。
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|Camera",
+		meta = (ToolTip = "使用这个 Actor 上的 AsymmetricCameraComponent。多台非对称相机时可在 Shot 设置覆盖里按 Shot 指定；留空则依次按 Camera Tag、当前镜头相机、最先登记的相机查找"))
+	TSoftObjectPtr<AActor> CameraActor;
+
+	/** 没设 CameraActor 时，按组件或 Actor 标签选相机 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|Camera",
+		meta = (ToolTip = "没设 Camera Actor 时使用组件 Tag 或所属 Actor Tag 匹配的 AsymmetricCameraComponent"))
+	FName CameraTag;
+
 	/** 合成模式：Disabled=保留分离序列，ImageSequence=每帧合并图片，Video=合并视频 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
 		meta = (EditCondition = "StereoLayout != EAsymmetricStereoLayout::None",
@@ -70,6 +162,12 @@ public:
 			ToolTip = "FFmpeg 可执行文件路径。点击 ... 按钮浏览选择，或直接输入绝对路径，例如 D:/tools/ffmpeg/bin/ffmpeg.exe。留空则使用系统 PATH 中的 ffmpeg。"))
 	FFilePath FFmpegPath;
 
+	/** ImageSequence 模式在进程内合成（引擎图像编解码 + 多线程），不调用 FFmpeg（默认开启） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode == EAsymmetricCompositeMode::ImageSequence && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "Image Sequence 模式直接在引擎里读取左右眼图片、拼接并写出，帧之间多线程并行，不需要 FFmpeg。关闭则改用 FFmpeg 合成。两种方式都会在日志里输出每个 Shot 的帧率，方便对比。"))
+	bool bUseNativeImageCompositor;
+
 	/** 视频编码器：H.264 兼容性最好，H.265 压缩率更高 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
 		meta = (EditCondition = "CompositeMode == EAsymmetricCompositeMode::Video && StereoLayout != EAsymmetricStereoLayout::None",
@@ -89,19 +187,70 @@ public:
 			ToolTip = "输出容器格式。MP4 兼容性最好，MOV 适合 Apple 生态，MKV 支持更多编码格式"))
 	EFFmpegOutputFormat OutputFormat;
 
+	/** 与主输出一起生成的额外交付版本（如半分辨率代理、上下布局版本） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "额外的交付版本，每个可以有自己的布局、缩放、编码器和容器（编码器 / 容器 / 质量只在 Video 模式生效）。所有版本和主输出在一次解码中生成：FFmpeg 用 split 滤镜图在一个进程里多路输出，进程内合成每帧只解码一次，额外版本只增加编码时间。"))
+	TArray<FAsymmetricCompositeOutputTarget> AdditionalOutputTargets;
+
+	/** Video 模式下把长 Shot 拆成 GOP 对齐的分段并行编码，再 stream copy 拼接（默认开启） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode == EAsymmetricCompositeMode::Video && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "把超过分段长度的 Shot 拆成多段，分别用独立的 FFmpeg 进程并行编码，最后无损拼接成一个文件。单个长镜头也能用满多核。"))
+	bool bSegmentedVideoEncode;
+
+	/** 每段的帧数，向上取整到 GOP（1 秒）的整数倍；Shot 不超过一段时不拆分 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (ClampMin = "1", EditCondition = "bSegmentedVideoEncode && CompositeMode == EAsymmetricCompositeMode::Video && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "每段的帧数，会向上取整到 GOP（约 1 秒）的整数倍。段越短并行度越高，但每段开头都是关键帧，码率略有上升。"))
+	int32 SegmentLengthFrames;
+
 	/** 合成成功后自动删除左右眼源图片序列（默认开启） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
 		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
 			ToolTip = "合成成功后自动删除左右眼源图片序列，仅保留合成结果"))
 	bool bDeleteSourceAfterComposite;
 
-	/** Keep concat list files and FFmpeg log files on disk for debugging.
-	 *  When disabled (default), these temporary files are deleted after composite. */
+	/** 每个 Shot 写盘完成后立即开始合成，与后续 Shot 的渲染重叠（需要输出设置开启 Flush Disk Writes Per Shot） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
 		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
-			ToolTip = "调试模式：保留 concat 列表文件和 FFmpeg 日志文件（_concat_*.txt / _ffmpeg_log_*.txt）。默认关闭，出现合成问题时可开启排查。"))
+			ToolTip = "多 Shot 任务中，每个 Shot 渲染并写盘完成后立即开始合成，GPU 渲染后续 Shot 的同时 CPU 在合成，渲染结束后只需等最后几个 Shot。需要在 Output 设置中开启 Flush Disk Writes Per Shot，否则退回渲染结束后统一合成。"))
+	bool bCompositeDuringRender;
+
+	/** 同时运行的 FFmpeg 合成进程数上限（0 = 自动：逻辑核数 / FFmpegThreadsPerProcess） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (ClampMin = "0", EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "同时合成的 Shot 数上限。0 = 自动，按逻辑核数除以每个进程的线程数计算。多 Shot 任务在多核渲染节点上可以显著缩短导出时间。"))
+	int32 MaxConcurrentComposites;
+
+	/** 每个 FFmpeg 进程的线程数（-threads，有多个输出版本时平分给各输出），0 = 由 FFmpeg 自己决定（此时自动并发数为 1） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (ClampMin = "0", EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "每个 FFmpeg 进程使用的线程数（-threads）。0 = 由 FFmpeg 自己决定，会占满所有核，此时自动并发数为 1。"))
+	int32 FFmpegThreadsPerProcess;
+
+	/** Keep concat list files on disk and print the full FFmpeg output of successful composites for debugging.
+	 *  When disabled (default), the temporary files are deleted after composite. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "调试模式：保留 concat 列表文件（_concat_*.txt），合成成功时也把 FFmpeg 输出打印到 Output Log。默认关闭，出现合成问题时可开启排查。"))
 	bool bDebugSaveConcatFiles;
 
+	/** Write stereo_composite_report.json (per-shot throughput, bytes, CPU and wait times) next to the outputs when export finishes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "导出结束时在输出目录写 stereo_composite_report.json：每个 Shot 的编码帧数、帧率、读写字节数、排队等待、墙钟时间和 FFmpeg 进程 CPU 时间，用来判断瓶颈在 CPU 还是磁盘。"))
+	bool bWriteCompositeReport;
+
+	/** Skip shots whose inputs, settings and outputs match stereo_composite_manifest.json from a previous export. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo|FFmpeg",
+		meta = (EditCondition = "CompositeMode != EAsymmetricCompositeMode::Disabled && StereoLayout != EAsymmetricStereoLayout::None",
+			ToolTip = "在输出目录维护 stereo_composite_manifest.json，记录每个 Shot 输入帧（帧号区间、路径、大小和内容抽样，不含修改时间）和合成设置的摘要。重新导出时，输入、设置都没变且输出文件完好的 Shot 直接跳过；上次崩溃或取消留下的不完整输出会被检测出来并重新合成。内容按文件头加 16 个均匀分布的小块抽样，只改了抽样块之间少量像素的重新渲染检测不到，需要时关闭此项强制重做。"))
+	bool bSkipUnchangedShots;
+
+	/** 主画面的 Pass 名；输出帧里其他名称的图像来自后处理材质、Stencil 层等附加 Pass */
+	const FString& GetMainPassName() const { return PassIdentifier.Name; }
+
 protected:
 	// UMoviePipelineDeferredPassBase 接口覆写
 	virtual void SetupImpl(const MoviePipeline::FMoviePipelineRenderPassInitSettings& InPassInitSettings) override;
@@ -112,6 +261,7 @@ protected:
 	virtual FString GetCameraName(const int32 InCameraIndex) const override;
 	virtual FString GetCameraNameOverride(const int32 InCameraIndex) const override;
 	virtual UE::MoviePipeline::FImagePassCameraViewData GetCameraInfo(FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload = nullptr) const override;
+	virtual FSceneView* GetSceneViewForSampleState(FSceneViewFamily* ViewFamily, FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload = nullptr) override;
 	virtual void BlendPostProcessSettings(FSceneView* InView, FMoviePipelineRenderPassMetrics& InOutSampleState, IViewCalcPayload* OptPayload = nullptr) override;
 
 	// 导出后处理 — 全部文件写入完成后执行 FFmpeg 合成
@@ -127,35 +277,139 @@ private:
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UAsymmetricCameraComponent> CachedCameraComponent;
 
+	/** 按 CameraActor / CameraTag / 当前镜头依次解析本 Shot 使用的相机，只查相机子系统，不遍历场景 */
+	UAsymmetricCameraComponent* ResolveCameraComponent() const;
+
+	/** SetupImpl 固定相机前子系统原本固定的相机，TeardownImpl 时恢复 */
+	TWeakObjectPtr<UAsymmetricCameraComponent> PreviousPinnedCamera;
+	bool bPinnedCamera = false;
+
 	/** 获取考虑 bSwapEyes 后的实际眼别索引（0=左，1=右） */
 	int32 GetEyeIndex(const int32 InCameraIndex) const;
 
+	/** 配置中有立体输出节点时，眼图已在内存中直接打包输出，不再做基于文件的合成 */
+	bool HasStereoOutputNode() const;
+
 	// ── FFmpeg 合成队列 ──────────────────────────────────────────────────────
 
-	/** 从 MRQ 输出数据构建合成队列（在 BeginExportImpl 中调用） */
-	void BuildCompositeQueue();
+	/** 从 MRQ 输出数据为还没提交过的 Shot 构建合成记录并入队（Shot 完成回调和 BeginExportImpl 中调用） */
+	void QueueShotComposites(const FMoviePipelineOutputData& OutputData);
+
+	/** 配对两眼帧并把一条记录加入合成队列；没有可配对的帧时返回 false */
+	bool SubmitCompositeRecord(FShotCompositeRecord&& Record);
+
+	/** 首次入队时按并发设置创建进程池 */
+	void EnsureCompositeScheduler();
+
+	/** 清空合成状态，终止仍在运行的 FFmpeg（新一次渲染开始或渲染被取消时） */
+	void ResetCompositeState();
+
+	/** 订阅 / 取消订阅 MRQ 的逐 Shot 完成回调 */
+	void BindShotWorkFinished();
+	void UnbindShotWorkFinished();
+
+	/** 某个 Shot 渲染完成且所有帧已写盘 */
+	void OnShotWorkFinished(FMoviePipelineOutputData InOutputData);
+
+	/** 为 CompositeQueue[RecordIndex] 写好 concat 列表，作为一个 FFmpeg 任务交给进程池 */
+	void EnqueueCompositeForShot(int32 RecordIndex);
+
+	/** ImageSequence 模式的进程内合成：排队，一次只跑一个 Shot（单个 Shot 已经用满所有工作线程） */
+	void EnqueueNativeComposite(int32 RecordIndex);
+	void StartNextNativeComposite();
+
+	/** 某个 Shot 的合成结束：记录结果，在后台统计源文件和输出的字节数，统计完回到游戏线程调用 CompleteShotComposite */
+	void HandleShotCompositeFinished(int32 RecordIndex, bool bLaunched, int32 ReturnCode, double Seconds, const FString& FFmpegLog);
+
+	/** 字节数统计完成后收尾：更新清单和统计、删除源文件、清理临时文件、弹通知 */
+	void CompleteShotComposite(int32 RecordIndex, bool bLaunched, int32 ReturnCode, const FString& FFmpegLog);
+
+	/** 分段编码的段长（帧），0 表示这个 Shot 不分段 */
+	int32 GetSegmentLengthFrames(const FShotCompositeRecord& Record) const;
+
+	/** 分段编码的固定 GOP 长度（帧） */
+	int32 GetSegmentGopFrames(const FShotCompositeRecord& Record) const;
+
+	/** 把 Shot 拆成分段，每段一个 FFmpeg 任务 */
+	void EnqueueSegmentedComposite(int32 RecordIndex, int32 SegmentFrames);
+
+	/** 某个分段结束；全部结束且都成功时提交拼接任务 */
+	void HandleSegmentFinished(int32 RecordIndex, bool bLaunched, int32 ReturnCode, double StartTime, const FString& FFmpegLog);
 
-	/** 启动 FFmpeg 处理 CompositeQueue[CurrentCompositeIndex] 对应的 Shot */
-	void LaunchFFmpegForShot(const FShotCompositeRecord& Record);
+	/** 所有分段编码完成后，stream copy 拼接为最终输出并写入容器级立体元数据 */
+	void EnqueueSegmentJoin(int32 RecordIndex);
+
+	/** 本次合成的输出版本：主输出（Pass 自身的布局和编码设置）+ 启用且有效的额外版本 */
+	TArray<FAsymmetricCompositeOutputTarget> GetCompositeTargets() const;
+
+	/** 取输出目录的合成清单，第一次用到时从磁盘读取 */
+	FAsymmetricCompositeManifest& GetCompositeManifest(const FString& OutputDir);
+
+	/** 影响输出内容的设置摘要：合成方式、帧率、分段 GOP 和每个输出版本的参数 */
+	uint64 ComputeSettingsHash(const FShotCompositeRecord& Record) const;
+
+	/**
+	 * 在后台计算 CompositeQueue[RecordIndex] 的输入摘要并与清单比对（状态完成、摘要一致、输出文件数和字节数一致），
+	 * 回到游戏线程后跳过或提交合成。
+	 */
+	void CheckCompositeUpToDateAsync(int32 RecordIndex);
+
+	/** 输入、设置和输出都和清单一致的 Shot 记为已完成，不重新合成 */
+	void FinishUnchangedComposite(int32 RecordIndex);
+
+	/** Shot 结束后更新清单并写盘：成功记为完成和 OutputFiles 里的输出，失败删除条目 */
+	void UpdateCompositeManifest(const FShotCompositeRecord& Record);
+
+	/** 全部 Shot 结束后汇总结果 */
+	void FinishExport();
+
+	/** 每个输出目录写一份 stereo_composite_report.json，只包含该目录下的 Shot */
+	void WriteCompositeReports() const;
 
 	/** 写入 concat demuxer 列表文件；成功返回路径，失败返回空字符串 */
 	FString WriteConcatList(const TArray<FString>& FilePaths, const FString& ListFilePath) const;
 
+	/** 同上，列表由一只眼第 StartIndex 起的 Count 个配对帧按需生成 */
+	FString WriteConcatList(const FAsymmetricFrameSequence& Eye, const FAsymmetricFrameRanges& Frames,
+		int32 StartIndex, int32 Count, const FString& ListFilePath) const;
+
 	/** 删除已完成 Shot 的左右眼源文件 */
 	void DeleteSourceFiles(const FShotCompositeRecord& Record) const;
 
-	/** 每个 Shot 的合成记录，在 BeginExportImpl 中从 MRQ 输出数据构建 */
+	/** 每个 Shot 的合成记录，只追加不删除，回调里按下标访问 */
 	TArray<FShotCompositeRecord> CompositeQueue;
 
-	/** 当前正在运行的 FFmpeg 进程句柄 */
-	FProcHandle ActiveFFmpegProcess;
+	/** 每个输出目录的合成清单 */
+	TMap<FString, TSharedPtr<FAsymmetricCompositeManifest>> CompositeManifests;
 
-	/** 当前正在合成的 Shot 在 CompositeQueue 中的索引 */
-	int32 CurrentCompositeIndex = 0;
+	/** 已提交合成的 Shot，避免 BeginExportImpl 时重复提交 */
+	TSet<TObjectKey<UMoviePipelineExecutorShot>> QueuedShots;
+
+	/** 当前渲染会话的 Pipeline；变化时说明开始了新一次渲染 */
+	TWeakObjectPtr<UMoviePipeline> BoundPipeline;
+	FDelegateHandle ShotWorkFinishedHandle;
+
+	/** FFmpeg 进程池，第一个 Shot 入队时按并发设置创建 */
+	TSharedPtr<FAsymmetricCompositeScheduler> CompositeScheduler;
+
+	/** 等待进程内合成的 Shot（CompositeQueue 下标），以及是否有一个正在运行 */
+	TArray<int32> NativeCompositeQueue;
+	bool bNativeCompositeRunning = false;
+
+	/** 当前会话的取消标记；重置合成状态时置位，旧会话的后台合成和文件统计尽快退出且不再回调 */
+	TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> NativeCompositeCancelFlag;
+
+	/** 还没回到游戏线程的后台文件任务（清单比对、Shot 结束时的字节数统计），归零前导出不算完成 */
+	int32 NumPendingFileTasks = 0;
+
+	/** 已结束（成功或失败）的 Shot 数，用于进度通知 */
+	int32 NumCompositesFinished = 0;
+
+	/** 本次导出已合成的帧数和读写字节数累计，CSV 里按运行总量记录，和 STAT 计数器一样单调递增 */
+	int64 TotalFramesEncoded = 0;
+	int64 TotalBytesRead = 0;
+	int64 TotalBytesWritten = 0;
 
 	/** 所有 FFmpeg 导出是否已完成 */
 	bool bExportFinished = true;
-
-	/** 写入磁盘的临时 concat 列表文件，所有 Shot 完成后统一清理 */
-	TArray<FString> TempConcatFiles;
 };
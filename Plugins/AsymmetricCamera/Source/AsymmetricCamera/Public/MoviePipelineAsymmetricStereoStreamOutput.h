@@ -0,0 +1,79 @@
+// MRQ 立体流式输出 — 左右眼在内存中打包后经管道直接送入 FFmpeg，不落地中间文件
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MoviePipelineAsymmetricStereoOutputBase.h"
+#include "MoviePipelineAsymmetricStereoStreamOutput.generated.h"
+
+class FAsymmetricFFmpegStream;
+
+/**
+ * 每个 Shot 的每个渲染 Pass 启动一个长驻 FFmpeg 进程，每帧把左右眼量化为 8 位 BGRA、按立体 Pass 的布局
+ * 打包成 SBS / TB 一帧，作为 rawvideo 写入 FFmpeg stdin。
+ * 主画面输出 stereo_<布局>_<Shot>，后处理材质、Stencil 层等附加 Pass 输出 stereo_<布局>_<Shot>_<Pass>，
+ * 和立体 Pass 基于文件的合成命名一致。
+ *
+ * 编码参数（编码器、CRF、容器、FFmpeg 路径、线程数）沿用立体 Pass 的 Stereo|FFmpeg 设置。
+ * 编码跟不上渲染时，排队帧数达到 MaxQueuedFrames 后渲染会被阻塞，内存占用有上限。
+ *
+ * 使用方法：在 MRQ Job 中添加本节点，并移除 PNG / EXR 等逐眼输出节点。
+ */
+UCLASS(BlueprintType)
+class ASYMMETRICCAMERA_API UMoviePipelineAsymmetricStereoStreamOutput : public UMoviePipelineAsymmetricStereoOutputBase
+{
+	GENERATED_BODY()
+
+public:
+	UMoviePipelineAsymmetricStereoStreamOutput();
+
+	/** 每个 Pass 等待编码的帧数上限，超过后阻塞渲染（每帧占用 打包后宽 × 高 × 4 字节） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stereo Stream",
+		meta = (ClampMin = "1", ClampMax = "16",
+			ToolTip = "每个渲染 Pass 最多排队等待编码的帧数。编码器跟不上时渲染会在这里等待。8K SBS 一帧约 260MB，开了附加 Pass 时按 Pass 数成倍占用，按内存大小设置。"))
+	int32 MaxQueuedFrames;
+
+protected:
+	// UMoviePipelineOutputBase 接口
+	virtual void OnReceiveImageDataImpl(FMoviePipelineMergerOutputFrame* InMergedOutputFrame) override;
+	virtual void OnShotFinishedImpl(const UMoviePipelineExecutorShot* InShot, const bool bFlushToDisk) override;
+	virtual void BeginFinalizeImpl() override;
+	virtual bool HasFinishedProcessingImpl() override;
+	virtual void TeardownForPipelineImpl(UMoviePipeline* InPipeline) override;
+
+#if WITH_EDITOR
+	virtual FText GetDisplayText() const override;
+#endif
+
+private:
+	/** 一个渲染 Pass 在当前 Shot 的编码进程 */
+	struct FPassStream
+	{
+		TSharedPtr<FAsymmetricFFmpegStream> Stream;
+		double StartTime = 0.0;
+		bool bFailed = false;        // 启动或写入失败，本 Shot 剩余帧不再重试
+	};
+
+	/** 打包一个 Pass 本帧的两眼并写入它的 FFmpeg，必要时先启动进程 */
+	void WritePassFrame(const FMoviePipelineFrameOutputState& InFrameOutputState, const FStereoEyeImages& InPass);
+
+	/** 为新 Shot 的一个 Pass 启动 FFmpeg；失败时这个 Pass 本 Shot 剩余帧全部跳过 */
+	TSharedPtr<FAsymmetricFFmpegStream> OpenStream(const FMoviePipelineFrameOutputState& InFrameOutputState,
+		const FStereoEyeImages& InPass, const FIntPoint& InPackedSize);
+
+	/** 一个 Pass 不再写入，移到收尾列表等待 FFmpeg 退出 */
+	void CloseStream(FPassStream& InPassStream);
+
+	/** 当前 Shot 的所有 Pass 都不再写入 */
+	void CloseActiveStreams();
+
+	/** 检查收尾中的进程，报告结果 */
+	void PollClosingStreams();
+
+	/** 当前 Shot 各 Pass 的 FFmpeg 进程，按 Pass 名索引 */
+	TMap<FString, FPassStream> ActiveStreams;
+	int32 ActiveShotIndex = INDEX_NONE;
+
+	/** 已关闭输入、等待 FFmpeg 写完文件尾的进程 */
+	TArray<TSharedPtr<FAsymmetricFFmpegStream>> ClosingStreams;
+};